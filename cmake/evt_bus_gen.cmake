@@ -0,0 +1,45 @@
+# evt_bus_generate_events(<target> NAME <schema name> SCHEMA <file.json> [CORE <core target>])
+#
+# Runs tools/evt_bus_gen.py on SCHEMA at build time (NAME must match the schema "name") and adds the generated
+# <name>_events.c to <target>. The generated config (<name>_evt_config.h) is applied
+# through EVT_BUS_USER_CONFIG to CORE (default: evt_bus_core) and, PUBLIC, to every
+# target linking it, so the core and the application agree on evt_t / evt_bus_t.
+
+set(EVT_BUS_GEN_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/../tools/evt_bus_gen.py")
+
+function(evt_bus_generate_events target)
+  cmake_parse_arguments(ARG "" "NAME;SCHEMA;CORE" "" ${ARGN})
+  if(NOT ARG_NAME OR NOT ARG_SCHEMA)
+    message(FATAL_ERROR "evt_bus_generate_events: NAME and SCHEMA are required")
+  endif()
+  if(NOT ARG_CORE)
+    set(ARG_CORE evt_bus_core)
+  endif()
+
+  find_package(Python3 COMPONENTS Interpreter REQUIRED)
+
+  get_filename_component(schema "${ARG_SCHEMA}" ABSOLUTE)
+  set(name ${ARG_NAME})
+
+  set(out_dir "${CMAKE_CURRENT_BINARY_DIR}/evt_bus_gen/${name}")
+  set(outputs
+    "${out_dir}/${name}_evt_config.h"
+    "${out_dir}/${name}_events.h"
+    "${out_dir}/${name}_events.c"
+  )
+  add_custom_command(
+    OUTPUT ${outputs}
+    COMMAND Python3::Interpreter "${EVT_BUS_GEN_SCRIPT}" --schema "${schema}" --name ${name} --out-dir "${out_dir}"
+    DEPENDS "${schema}" "${EVT_BUS_GEN_SCRIPT}"
+    COMMENT "evt_bus: generating ${name} events"
+    VERBATIM
+  )
+  add_custom_target(${name}_evt_bus_gen DEPENDS ${outputs})
+
+  target_sources(${target} PRIVATE "${out_dir}/${name}_events.c")
+  target_include_directories(${ARG_CORE} PUBLIC "$<BUILD_INTERFACE:${out_dir}>")
+  target_compile_definitions(${ARG_CORE} PUBLIC "EVT_BUS_USER_CONFIG=\"${name}_evt_config.h\"")
+  add_dependencies(${ARG_CORE} ${name}_evt_bus_gen)
+  add_dependencies(${target} ${name}_evt_bus_gen)
+  target_link_libraries(${target} PRIVATE ${ARG_CORE})
+endfunction()
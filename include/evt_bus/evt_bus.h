@@ -19,6 +19,12 @@
  * Locking model:
  * - If the backend provides lock/unlock, the core uses them to protect subscription tables.
  * - Dispatch snapshots callbacks under lock, then releases lock before invoking callbacks.
+ *
+ * Instances:
+ * - Every evt_bus_inst_* function operates on a caller-provided evt_bus_t with its own
+ *   tables and backend (queue, lock, dispatcher). Instances are fully independent.
+ * - The evt_bus_* functions without a bus argument operate on a default instance bound
+ *   to the port-defined global evt_bus_backend.
  */
 
 #include "evt_bus_types.h"
@@ -27,10 +33,161 @@
 extern "C" {
 #endif
 
+/* ------------------------------------------------------------------------- */
+/* Instance API                                                               */
+/* ------------------------------------------------------------------------- */
+
+/**
+ * @brief Initialize a bus instance and its backend.
+ *
+ * Clears all of @p bus, binds it to @p backend and calls backend->init(backend->ctx)
+ * if provided.
+ *
+ * @param bus     Caller-provided storage of any content (static, stack, reused RAM).
+ *                Must outlive all use.
+ * @param backend Backend driving this instance. Not shared with other instances.
+ *
+ * @return false if an argument is NULL or the backend init failed.
+ */
+bool evt_bus_inst_init(evt_bus_t *bus, evt_bus_backend_t *backend);
+
+/** @brief evt_bus_subscribe() on @p bus. */
+evt_sub_handle_t evt_bus_inst_subscribe(evt_bus_t *bus, evt_id_t evt_id, evt_cb_t cb, void *user_ctx);
+
+/** @brief evt_bus_unsubscribe() on @p bus. Handles are only valid on the bus that issued them. */
+void evt_bus_inst_unsubscribe(evt_bus_t *bus, evt_sub_handle_t handle);
+
+/** @brief evt_bus_subscribe_many() on @p bus. */
+bool evt_bus_inst_subscribe_many(evt_bus_t *bus, const evt_sub_req_t *reqs, size_t n,
+                                 evt_sub_handle_t *out);
+
+/** @brief evt_bus_unsubscribe_many() on @p bus. */
+void evt_bus_inst_unsubscribe_many(evt_bus_t *bus, const evt_sub_handle_t *handles, size_t n);
+
+/** @brief evt_bus_publish() on @p bus. */
+bool evt_bus_inst_publish(evt_bus_t *bus, evt_id_t evt_id, const void *payload, size_t payload_len);
+
+/** @brief evt_bus_publish_from_isr() on @p bus. */
+bool evt_bus_inst_publish_from_isr(evt_bus_t *bus, evt_id_t evt_id, const void *payload, size_t payload_len);
+
+/** @brief evt_bus_publish_ex() on @p bus. */
+evt_pub_result_t evt_bus_inst_publish_ex(evt_bus_t *bus, evt_id_t evt_id,
+                                         const void *payload, size_t payload_len);
+
+/** @brief evt_bus_publish_from_isr_ex() on @p bus. */
+evt_pub_result_t evt_bus_inst_publish_from_isr_ex(evt_bus_t *bus, evt_id_t evt_id,
+                                                  const void *payload, size_t payload_len);
+
+/** @brief evt_bus_publish_as() on @p bus. Publisher tokens are per instance. */
+evt_pub_result_t evt_bus_inst_publish_as(evt_bus_t *bus, evt_pub_id_t pub, evt_id_t evt_id,
+                                         const void *payload, size_t payload_len);
+
+/** @brief evt_bus_publish_as_from_isr() on @p bus. */
+evt_pub_result_t evt_bus_inst_publish_as_from_isr(evt_bus_t *bus, evt_pub_id_t pub, evt_id_t evt_id,
+                                                  const void *payload, size_t payload_len);
+
+/** @brief evt_bus_set_policy() on @p bus. */
+bool evt_bus_inst_set_policy(evt_bus_t *bus, evt_id_t evt_id, const evt_policy_t *policy);
+
+/** @brief evt_bus_set_reserved_slots() on @p bus. */
+void evt_bus_inst_set_reserved_slots(evt_bus_t *bus, size_t slots);
+
+/** @brief evt_bus_set_tap() on @p bus. */
+void evt_bus_inst_set_tap(evt_bus_t *bus, const evt_tap_t *tap);
+
+/** @brief evt_bus_publisher_register() on @p bus. */
+evt_pub_id_t evt_bus_inst_publisher_register(evt_bus_t *bus, const evt_pub_quota_t *quota);
+
+/** @brief evt_bus_set_retained() on @p bus. */
+bool evt_bus_inst_set_retained(evt_bus_t *bus, evt_id_t evt_id);
+
+/** @brief evt_bus_get_retained() on @p bus. */
+bool evt_bus_inst_get_retained(evt_bus_t *bus, evt_id_t evt_id, evt_t *out);
+
+/** @brief evt_bus_set_dedup() on @p bus. */
+bool evt_bus_inst_set_dedup(evt_bus_t *bus, evt_id_t evt_id, const evt_dedup_cfg_t *cfg);
+
+/** @brief evt_bus_subscribe_retained() on @p bus. */
+evt_sub_handle_t evt_bus_inst_subscribe_retained(evt_bus_t *bus, evt_id_t evt_id,
+                                                 evt_cb_t cb, void *user_ctx);
+
+/** @brief evt_bus_subscribe_batch() on @p bus. */
+evt_sub_handle_t evt_bus_inst_subscribe_batch(evt_bus_t *bus, evt_id_t evt_id, evt_batch_cb_t cb,
+                                              const evt_batch_cfg_t *cfg, void *user_ctx);
+
+/** @brief evt_bus_subscribe_throttled() on @p bus. */
+evt_sub_handle_t evt_bus_inst_subscribe_throttled(evt_bus_t *bus, evt_id_t evt_id, evt_cb_t cb,
+                                                  const evt_sub_throttle_t *cfg, void *user_ctx);
+
+/** @brief evt_bus_batch_poll() on @p bus. */
+void evt_bus_inst_batch_poll(evt_bus_t *bus);
+
+/** @brief evt_bus_batch_next_due_us() on @p bus. */
+uint32_t evt_bus_inst_batch_next_due_us(evt_bus_t *bus);
+
+/** @brief evt_bus_set_parallel() on @p bus. */
+bool evt_bus_inst_set_parallel(evt_bus_t *bus, evt_id_t evt_id, bool parallel);
+
+/** @brief evt_bus_wait_for() on @p bus. */
+bool evt_bus_inst_wait_for(evt_bus_t *bus, evt_id_t evt_id, evt_t *out, uint32_t timeout_ms);
+
+/** @brief evt_bus_request() on @p bus. */
+evt_pub_result_t evt_bus_inst_request(evt_bus_t *bus, evt_id_t evt_id, const void *payload,
+                                      size_t payload_len, evt_t *reply, uint32_t timeout_ms);
+
+/** @brief evt_bus_reply() on @p bus. */
+bool evt_bus_inst_reply(evt_bus_t *bus, const evt_t *request, const void *payload, size_t payload_len);
+
+/** @brief evt_bus_ping() on @p bus. */
+bool evt_bus_inst_ping(evt_bus_t *bus, uint32_t *ticket);
+
+/** @brief evt_bus_ping_acked() on @p bus. */
+bool evt_bus_inst_ping_acked(evt_bus_t *bus, uint32_t ticket);
+
+/** @brief evt_bus_liveness() on @p bus. */
+void evt_bus_inst_liveness(evt_bus_t *bus, evt_bus_liveness_t *out);
+
+/** @brief evt_bus_set_cb_watchdog() on @p bus. */
+bool evt_bus_inst_set_cb_watchdog(evt_bus_t *bus, const evt_cb_watchdog_t *cfg);
+
+/** @brief evt_bus_resume_subscriber() on @p bus. */
+bool evt_bus_inst_resume_subscriber(evt_bus_t *bus, evt_sub_handle_t handle);
+
+/** @brief evt_bus_subscriber_suspended() on @p bus. */
+bool evt_bus_inst_subscriber_suspended(evt_bus_t *bus, evt_sub_handle_t handle);
+
+/** @brief evt_bus_evt_age_us() on @p bus. */
+uint32_t evt_bus_inst_evt_age_us(const evt_bus_t *bus, const evt_t *evt);
+
+/** @brief evt_bus_meta_stats() on @p bus. */
+bool evt_bus_inst_meta_stats(const evt_bus_t *bus, evt_meta_stats_t *out);
+
+/** @brief evt_bus_dispatch_evt() on @p bus; called by that instance's dispatcher. */
+void evt_bus_inst_dispatch_evt(evt_bus_t *bus, const evt_t *evt);
+
+/**
+ * @brief Default instance used by the evt_bus_* functions without a bus argument.
+ */
+evt_bus_t *evt_bus_default(void);
+
+/**
+ * @brief Report the static RAM cost of the configured tables and envelope.
+ *
+ * Sizes follow the compile-time limits (EVT_BUS_MAX_*, EVT_INLINE_MAX, EVT_BUS_COMPACT);
+ * backend queue RAM is roughly envelope * queue depth.
+ */
+void evt_bus_footprint(evt_bus_footprint_t *out);
+
+/* ------------------------------------------------------------------------- */
+/* Default-instance API                                                       */
+/* ------------------------------------------------------------------------- */
+
 /**
  * @brief Initialize the event bus core state.
  *
- * Initializes internal tables (subscriber pool + per-event subscription lists).
+ * Initializes internal tables (subscriber pool + per-event subscription lists) of the
+ * default instance, bound to the port-defined global evt_bus_backend. The default
+ * instance starts zeroed, so the first call does no per-slot work.
  *
  * @note Must be called once before any other evt_bus_* API.
  * @note Safe to call at boot; not intended to be called concurrently with other APIs.
@@ -69,6 +226,27 @@ evt_sub_handle_t evt_bus_subscribe(evt_id_t evt_id, evt_cb_t cb, void *user_ctx)
  */
 void evt_bus_unsubscribe(evt_sub_handle_t handle);
 
+/**
+ * @brief Subscribe @p n callbacks under a single lock acquisition (all or nothing).
+ *
+ * Meant for module init: the dispatcher sees either none or all of the new
+ * subscriptions. If any request is invalid or a handle / per-ID slot runs out, the
+ * subscriptions made so far are rolled back before the lock is released.
+ *
+ * @param reqs Requests, in order.
+ * @param out  Receives @p n handles (all EVT_HANDLE_ID_INVALID on failure).
+ *
+ * @return true if every request was subscribed.
+ */
+bool evt_bus_subscribe_many(const evt_sub_req_t *reqs, size_t n, evt_sub_handle_t *out);
+
+/**
+ * @brief Unsubscribe @p n handles under a single lock acquisition.
+ *
+ * Same per-handle semantics as evt_bus_unsubscribe(): invalid or stale entries are skipped.
+ */
+void evt_bus_unsubscribe_many(const evt_sub_handle_t *handles, size_t n);
+
 /**
  * @brief Publish an event (enqueue-only).
  *
@@ -79,7 +257,7 @@ void evt_bus_unsubscribe(evt_sub_handle_t handle);
  * @param payload_len  Number of payload bytes to copy. Must be <= EVT_INLINE_MAX.
  *
  * @return true if the event was accepted/enqueued, false otherwise (invalid args, queue full,
- *         or backend enqueue failure).
+ *         or backend enqueue failure). See evt_bus_publish_ex() for the detailed outcome.
  *
  * @note This function does not execute callbacks.
  * @note ISR-safety depends on the backend/port (use a dedicated ISR publish helper if provided).
@@ -104,6 +282,359 @@ bool evt_bus_publish(evt_id_t evt_id, const void *payload, size_t payload_len);
  */
 bool evt_bus_publish_from_isr(evt_id_t evt_id, const void *payload, size_t payload_len);
 
+/**
+ * @brief Publish an event and report the backpressure outcome.
+ *
+ * Same as evt_bus_publish(), but applies the per-ID policy set with
+ * evt_bus_set_policy() and returns the detailed result:
+ * - EVT_BP_DROP_NEW:    EVT_PUB_OK or EVT_PUB_ERR_FULL.
+ * - EVT_BP_DROP_OLDEST: EVT_PUB_OK, or EVT_PUB_OK_DROPPED_OLDEST if the oldest queued
+ *                       event was evicted to make room.
+ * - EVT_BP_BLOCK:       EVT_PUB_OK or EVT_PUB_ERR_TIMEOUT.
+ * Non-critical IDs never take reserved capacity: EVT_BP_DROP_OLDEST evicts only if that
+ * frees a slot above the reservation, EVT_BP_BLOCK waits up to timeout_ms for one (needs
+ * the backend waiter_sleep hook), and EVT_PUB_ERR_RESERVED is returned otherwise.
+ *
+ * @note EVT_BP_BLOCK may block the caller; never use it for IDs published from
+ *       callbacks (the dispatcher would wait on itself).
+ */
+evt_pub_result_t evt_bus_publish_ex(evt_id_t evt_id, const void *payload, size_t payload_len);
+
+/**
+ * @brief ISR variant of evt_bus_publish_ex().
+ *
+ * EVT_BP_BLOCK is treated as drop-new (an ISR never waits).
+ */
+evt_pub_result_t evt_bus_publish_from_isr_ex(evt_id_t evt_id, const void *payload, size_t payload_len);
+
+/**
+ * @brief Set the backpressure policy for an event ID.
+ *
+ * @param evt_id Event identifier.
+ * @param policy Policy to apply, or NULL to restore the default (drop-new, not critical).
+ *
+ * @return false if @p evt_id is out of range or the mode is unknown.
+ *
+ * @note Intended to be configured at init, before the ID is published.
+ */
+bool evt_bus_set_policy(evt_id_t evt_id, const evt_policy_t *policy);
+
+/**
+ * @brief Set how many queue slots are kept free for critical event IDs.
+ *
+ * Non-critical publishes are rejected (EVT_PUB_ERR_RESERVED) once the backend reports
+ * @p slots or fewer free slots. Requires the backend free_slots hook; ignored otherwise.
+ * evt_bus_init() resets it to EVT_BUS_RESERVED_SLOTS.
+ */
+void evt_bus_set_reserved_slots(size_t slots);
+
+/**
+ * @brief Install a tap that sees every dispatched event (e.g. the recorder).
+ *
+ * The tap runs in the dispatcher context, in queue order, so ISR and task publishes
+ * are seen alike; rejected publishes never reach it. Pass NULL to remove it.
+ * Safe while the bus is running: returns once the dispatcher no longer runs the
+ * previous tap (sleeping through the backend waiter_sleep hook if it has to wait).
+ *
+ * @note Do not call it from the tap itself.
+ */
+void evt_bus_set_tap(const evt_tap_t *tap);
+
+/**
+ * @brief Register a publisher token with admission limits.
+ *
+ * Events published with the token count against the quota from enqueue until the
+ * dispatcher dequeues them:
+ * - max_inflight bounds how many of them can sit in the queue at once.
+ * - rate_per_sec/burst is a token bucket refilled from the backend now_us clock.
+ * Limits are enforced with lock-free counters, so publishing stays ISR-safe.
+ *
+ * @param quota Limits for this publisher (must not be NULL).
+ *
+ * @return Publisher token, or EVT_PUB_ID_NONE if the table is full, the quota is
+ *         invalid, a rate limit is requested without a backend clock, or max_inflight
+ *         is requested on a backend whose events another bus dispatches
+ *         (remote_dispatch, e.g. the Linux shared-memory port).
+ *
+ * @note Requires EVT_BUS_MAX_PUBLISHERS > 0. Tokens are released by evt_bus_init().
+ */
+evt_pub_id_t evt_bus_publisher_register(const evt_pub_quota_t *quota);
+
+/**
+ * @brief Publish on behalf of a registered publisher (see evt_bus_publish_ex()).
+ *
+ * Returns EVT_PUB_ERR_QUOTA / EVT_PUB_ERR_RATE when the publisher is over its limits.
+ * @p pub == EVT_PUB_ID_NONE behaves like evt_bus_publish_ex().
+ */
+evt_pub_result_t evt_bus_publish_as(evt_pub_id_t pub, evt_id_t evt_id,
+                                    const void *payload, size_t payload_len);
+
+/**
+ * @brief ISR variant of evt_bus_publish_as().
+ */
+evt_pub_result_t evt_bus_publish_as_from_isr(evt_pub_id_t pub, evt_id_t evt_id,
+                                             const void *payload, size_t payload_len);
+
+/**
+ * @brief Drop identical back-to-back publishes of @p evt_id.
+ *
+ * Publishers hash (ID, length, payload) and compare it with the last accepted event of
+ * the ID. A match is not enqueued while that copy is still queued, nor within
+ * @p cfg->window_us of its publish; the publisher gets EVT_PUB_OK_DUPLICATE (which
+ * evt_pub_ok() accepts). A different payload in between resets the comparison. The
+ * state is lock-free, so ISR publishes are covered too.
+ *
+ * @param cfg Settings, or NULL to turn dedup off and free the slot. A window needs
+ *            backend now_us.
+ *
+ * @return false on invalid ID, no free slot, a window without clock, or without
+ *         EVT_BUS_MAX_DEDUP. On a backend whose events another bus dispatches
+ *         (remote_dispatch, e.g. the Linux shared-memory port) only the window applies,
+ *         so a zero window is refused.
+ *
+ * @note The comparison is a 32-bit hash: two different payloads that collide count as
+ *       identical (about one pair in 2^31).
+ */
+bool evt_bus_set_dedup(evt_id_t evt_id, const evt_dedup_cfg_t *cfg);
+
+/**
+ * @brief Keep the last dispatched event of @p evt_id for late subscribers.
+ *
+ * Takes one of the EVT_BUS_MAX_RETAINED slots; calling it again for the same ID is a
+ * no-op. The value is captured by the dispatcher, so it is always an event that was
+ * actually delivered.
+ *
+ * @return false on invalid ID, no free slot, or without EVT_BUS_MAX_RETAINED.
+ */
+bool evt_bus_set_retained(evt_id_t evt_id);
+
+/**
+ * @brief Copy the retained value of @p evt_id.
+ *
+ * @return false if @p evt_id is not retained or nothing was dispatched yet.
+ */
+bool evt_bus_get_retained(evt_id_t evt_id, evt_t *out);
+
+/**
+ * @brief evt_bus_subscribe(), then replay the retained value of @p evt_id to @p cb.
+ *
+ * If a value is retained, the dispatcher delivers it to this subscriber only, in the
+ * dispatcher context and before any later event. A control event (EVT_BUS_CTRL_ID) is
+ * queued to wake the dispatcher; if the queue is full the replay simply runs with the
+ * next dispatched event. Without a retained value this is evt_bus_subscribe().
+ */
+evt_sub_handle_t evt_bus_subscribe_retained(evt_id_t evt_id, evt_cb_t cb, void *user_ctx);
+
+/**
+ * @brief Subscribe to @p evt_id with a callback that receives events in batches.
+ *
+ * The dispatcher buffers the events in one of the EVT_BUS_MAX_BATCH_SUBS slots and calls
+ * @p cb once @p cfg->max_events are buffered, or when an event arrives (or
+ * evt_bus_batch_poll() runs) after the oldest buffered one is @p cfg->window_us old.
+ * Events still buffered when the handle is unsubscribed are discarded.
+ *
+ * @param cfg NULL => EVT_BUS_BATCH_MAX_EVENTS, no window. A window needs backend now_us.
+ * @return Handle for evt_bus_unsubscribe(), or EVT_HANDLE_ID_INVALID on invalid
+ *         arguments, no free batch slot or handle, or without EVT_BUS_MAX_BATCH_SUBS.
+ */
+evt_sub_handle_t evt_bus_subscribe_batch(evt_id_t evt_id, evt_batch_cb_t cb,
+                                         const evt_batch_cfg_t *cfg, void *user_ctx);
+
+/**
+ * @brief Subscribe to @p evt_id, skipping events the callback would discard anyway.
+ *
+ * The dispatcher decides while it snapshots the subscribers, so a skipped event costs no
+ * callback. With @p cfg->every_n = N the subscriber gets the first event and then every
+ * Nth one; with @p cfg->min_interval_us it gets an event only if the previous delivery
+ * was at least that long ago (dispatch time, backend now_us). Both limits may be
+ * combined: the decimation counter advances on every event of the ID. Events skipped
+ * this way are not counted as drops.
+ *
+ * @return Handle for evt_bus_unsubscribe(), or EVT_HANDLE_ID_INVALID on invalid
+ *         arguments (NULL @p cfg, an interval without backend now_us), no free handle,
+ *         or without EVT_BUS_SUB_THROTTLE.
+ */
+evt_sub_handle_t evt_bus_subscribe_throttled(evt_id_t evt_id, evt_cb_t cb,
+                                             const evt_sub_throttle_t *cfg, void *user_ctx);
+
+/**
+ * @brief Deliver batches whose time window has expired.
+ *
+ * Dispatcher context only. Dispatch already does this after every event; call it when
+ * the dispatcher is idle so a stream that stops still gets its last batch (the FreeRTOS
+ * and Linux ports do on their idle timeouts).
+ */
+void evt_bus_batch_poll(void);
+
+/**
+ * @brief Time until the earliest open batch window expires.
+ *
+ * Dispatcher context only. A dispatcher that blocks while idle can wait this long and
+ * then call evt_bus_batch_poll(), instead of waking periodically.
+ *
+ * @return Microseconds until the next window expires (0 if one already has), or
+ *         UINT32_MAX when no time window is open or without EVT_BUS_MAX_BATCH_SUBS.
+ */
+uint32_t evt_bus_batch_next_due_us(void);
+
+/**
+ * @brief Spread the callbacks of @p evt_id over the backend's fan-out workers.
+ *
+ * The dispatcher splits its subscriber snapshot into up to EVT_BUS_FANOUT_WORKERS + 1
+ * shares, hands all but the first to the backend fanout_start() hook, runs the first
+ * itself and waits in fanout_join() before taking the next event, so events stay in
+ * FIFO order. Callbacks of one event then run concurrently and in no particular order;
+ * they must not share unsynchronized state. Events with fewer than two subscribers,
+ * and events of IDs with a batch subscriber, are dispatched serially. The callback
+ * watchdog does not time parallel fan-outs.
+ *
+ * @return false on invalid ID, without EVT_BUS_FANOUT_WORKERS, or (when enabling) a
+ *         backend without fanout hooks.
+ */
+bool evt_bus_set_parallel(evt_id_t evt_id, bool parallel);
+
+/**
+ * @brief Run one share of a parallel fan-out; called by the backend's worker contexts.
+ */
+void evt_bus_fanout_job_run(const evt_fanout_job_t *job);
+
+/**
+ * @brief Block the calling task until @p evt_id is next dispatched (one-shot).
+ *
+ * The waiter takes a slot of a small static table (EVT_BUS_MAX_WAITERS) instead of a
+ * subscriber handle. The dispatcher copies the event into @p out while taking its
+ * subscriber snapshot and wakes the task through the backend waiter hooks, before the
+ * subscriber callbacks run.
+ *
+ * @param out        Receives the event (id, payload, envelope metadata); may be NULL.
+ * @param timeout_ms Maximum wait, or EVT_BUS_WAIT_FOREVER.
+ *
+ * @return true if the event arrived; false on timeout, invalid ID, full waiter table,
+ *         or a backend without waiter hooks.
+ *
+ * @note Task context only. Never call from a subscriber callback (the dispatcher would
+ *       wait for itself).
+ */
+bool evt_bus_wait_for(evt_id_t evt_id, evt_t *out, uint32_t timeout_ms);
+
+/**
+ * @brief Publish a request and block until a responder answers it.
+ *
+ * The caller takes a reply slot of a static pool (EVT_BUS_MAX_REQUESTS) and the request
+ * is published with the slot's correlation ID in evt_t.corr. A subscriber of @p evt_id
+ * answers with evt_bus_reply(), which copies the reply into @p reply and wakes the caller
+ * directly: no temporary subscription and no second trip through the queue.
+ *
+ * @param reply      Receives the reply (request ID, reply payload); may be NULL.
+ * @param timeout_ms Maximum wait for the reply, or EVT_BUS_WAIT_FOREVER.
+ *
+ * @return EVT_PUB_OK once replied; EVT_PUB_ERR_NO_REPLY if the request was queued but not
+ *         answered in time; EVT_PUB_ERR_NO_SLOT if every reply slot is taken; otherwise the
+ *         publish error (the request was not queued). EVT_PUB_ERR_NO_BACKEND without
+ *         backend waiter hooks or EVT_BUS_MAX_REQUESTS.
+ *
+ * @note Task context only. Never call from a subscriber callback (the dispatcher would
+ *       wait for itself). Requests bypass publish dedup.
+ */
+evt_pub_result_t evt_bus_request(evt_id_t evt_id, const void *payload, size_t payload_len,
+                                 evt_t *reply, uint32_t timeout_ms);
+
+/**
+ * @brief Answer @p request (an event published by evt_bus_request()).
+ *
+ * Typically called from the responder's subscriber callback with the event it received;
+ * any task may reply later as long as it kept a copy of the request envelope.
+ *
+ * @return false if @p request carries no correlation ID, the caller already gave up
+ *         (timeout) or was answered, or on invalid payload arguments.
+ *
+ * @note Not ISR-safe (takes the bus lock and wakes the caller).
+ */
+bool evt_bus_reply(const evt_t *request, const void *payload, size_t payload_len);
+
+/**
+ * @brief Queue a liveness ping behind everything already queued.
+ *
+ * The dispatcher acknowledges pings in queue order, so an acknowledged ping proves the
+ * dispatcher runs and the queue drains. Nothing wakes the dispatcher otherwise: a
+ * monitor pings, sleeps for its deadline and checks evt_bus_ping_acked().
+ *
+ * @param ticket Receives the value evt_bus_ping_acked() waits for; may be NULL.
+ *
+ * @return false if the ping could not be queued (queue full, no backend), on a backend
+ *         with remote dispatch (e.g. the Linux shared-memory port), or without
+ *         EVT_BUS_LIVENESS. A full queue is itself worth checking with evt_bus_liveness().
+ *
+ * @note Task context. With several monitors, a ticket counts pings, not a specific one.
+ */
+bool evt_bus_ping(uint32_t *ticket);
+
+/** @brief true once the dispatcher has reached the ping of @p ticket. */
+bool evt_bus_ping_acked(uint32_t ticket);
+
+/**
+ * @brief Read ping counters and what the dispatcher is doing right now.
+ *
+ * busy / busy_id / busy_since_us are recorded when an event is dequeued and cleared when
+ * its dispatch returns: an unacknowledged ping with an old busy_since_us points at a stuck
+ * callback of busy_id, one without busy points at a dispatcher that stopped dequeuing.
+ * busy_since_us needs backend now_us (0 otherwise). Callable from any task.
+ */
+void evt_bus_liveness(evt_bus_liveness_t *out);
+
+/**
+ * @brief Configure the slow-callback watchdog.
+ *
+ * The dispatcher times every callback with the backend now_us clock. A subscriber that
+ * exceeds budget_us on `strikes` consecutive callbacks is reported through on_overrun
+ * and, with auto_suspend, skipped by dispatch until evt_bus_resume_subscriber().
+ * A callback within budget resets its strike count.
+ *
+ * @param cfg Settings, or NULL to disable.
+ *
+ * @return false without EVT_BUS_CB_WATCHDOG or if a budget is set without a backend clock.
+ *
+ * @note Callbacks are not preempted: an overrun is detected after it happened.
+ */
+bool evt_bus_set_cb_watchdog(const evt_cb_watchdog_t *cfg);
+
+/**
+ * @brief Re-enable a subscriber suspended by the watchdog and clear its strikes.
+ *
+ * @return false if @p handle is stale or invalid.
+ */
+bool evt_bus_resume_subscriber(evt_sub_handle_t handle);
+
+/**
+ * @brief Whether the watchdog currently suspends @p handle.
+ */
+bool evt_bus_subscriber_suspended(evt_sub_handle_t handle);
+
+/**
+ * @brief Time since @p evt was published, from the backend now_us clock.
+ *
+ * Call from a callback to measure queueing + fanout delay of the event being handled.
+ *
+ * @return Microseconds, or 0 without EVT_BUS_ENVELOPE_META or a backend clock.
+ */
+uint32_t evt_bus_evt_age_us(const evt_t *evt);
+
+/**
+ * @brief Copy the dispatcher's envelope statistics.
+ *
+ * Sequence numbers are taken before enqueue, so rejected publishes (backpressure,
+ * quotas) and drop-oldest evictions both show up as gaps. Concurrent publishers can
+ * enqueue out of stamp order; that is counted in seq_reordered. With remote dispatch
+ * (e.g. the Linux shared-memory port) events come numbered by several buses, so
+ * seq_gaps and seq_reordered stay 0; dispatched and the latencies are kept.
+ *
+ * @note Updated by the dispatcher without a lock; read it from the dispatch context
+ *       or accept a mixed snapshot.
+ *
+ * @return false without EVT_BUS_ENVELOPE_META.
+ */
+bool evt_bus_meta_stats(evt_meta_stats_t *out);
+
 /**
  * @brief Dispatch (fan out) a single event to all subscribers of evt->id.
  *
@@ -113,6 +644,9 @@ bool evt_bus_publish_from_isr(evt_id_t evt_id, const void *payload, size_t paylo
  * Self-healing:
  * - Any stale/invalid handle entries encountered are cleared from the subscription list.
  *
+ * Releases the publisher quota held by @p evt (if any) before fanning out and, with
+ * EVT_BUS_ENVELOPE_META, accounts its sequence number and queue latency.
+ *
  * @param evt Pointer to event envelope to dispatch. If NULL, function returns immediately.
  *
  * @note Callbacks MUST NOT block.
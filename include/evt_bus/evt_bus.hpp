@@ -0,0 +1,196 @@
+#ifndef EVT_BUS_HPP
+#define EVT_BUS_HPP
+
+/**
+ * @file evt_bus.hpp
+ * @brief Header-only C++17 typed layer over evt_bus.h.
+ *
+ * - Typed event descriptors bind an event ID to a trivially-copyable payload type.
+ *   Payload size / ID range are checked at compile time, so typed publishes can only
+ *   fail on backpressure, never on arguments.
+ * - Subscriptions bind free functions, member functions or caller-owned callables through
+ *   static trampolines into evt_cb_t. No heap, no std::function.
+ *
+ * Example:
+ * @code
+ *   struct temp_sample { int16_t centi_c; uint8_t sensor; };
+ *   using evt_temp = evt_bus::event<EVT_TEMP, temp_sample>;
+ *
+ *   static void on_temp(const temp_sample &s) { ... }
+ *
+ *   evt_bus::subscribe<evt_temp, on_temp>();
+ *   evt_bus::subscribe<evt_temp, &logger::on_temp>(logger_instance);
+ *   evt_bus::publish<evt_temp>(temp_sample{2350, 1});
+ * @endcode
+ *
+ * Callables follow the usual callback rules: they run in the dispatcher context and
+ * MUST NOT block. Objects bound by reference must outlive their subscription.
+ */
+
+#include <cstring>
+#include <type_traits>
+
+#include "evt_bus/evt_bus.h"
+
+namespace evt_bus {
+
+/**
+ * @brief Typed event descriptor.
+ *
+ * @tparam Id Event identifier (must be < EVT_BUS_MAX_EVT_IDS).
+ * @tparam T  Payload type, trivially copyable and at most EVT_INLINE_MAX bytes.
+ *            Use void for signal-only events.
+ */
+template <evt_id_t Id, typename T = void>
+struct event {
+  static_assert(Id < EVT_BUS_MAX_EVT_IDS, "event id out of range (EVT_BUS_MAX_EVT_IDS)");
+  static_assert(std::is_trivially_copyable<T>::value, "event payload must be trivially copyable");
+  static_assert(sizeof(T) <= EVT_INLINE_MAX, "event payload exceeds EVT_INLINE_MAX");
+
+  static constexpr evt_id_t id = Id;
+  static constexpr size_t   size = sizeof(T);
+  using payload_type = T;
+};
+
+template <evt_id_t Id>
+struct event<Id, void> {
+  static_assert(Id < EVT_BUS_MAX_EVT_IDS, "event id out of range (EVT_BUS_MAX_EVT_IDS)");
+
+  static constexpr evt_id_t id = Id;
+  static constexpr size_t   size = 0;
+  using payload_type = void;
+};
+
+namespace detail {
+
+template <typename Evt>
+using payload_t = typename Evt::payload_type;
+
+template <typename Evt>
+constexpr bool has_payload = !std::is_void<payload_t<Evt>>::value;
+
+/* Envelope -> typed payload. memcpy because evt_t::payload is only byte-aligned. */
+template <typename Evt>
+inline bool decode(const evt_t *evt, payload_t<Evt> &out)
+{
+  if (evt->len != sizeof(payload_t<Evt>)) return false;
+  std::memcpy(&out, evt->payload, sizeof(payload_t<Evt>));
+  return true;
+}
+
+/* Invoke f with the decoded payload (or no argument for void events) */
+template <typename Evt, typename F>
+inline void invoke(const evt_t *evt, F &&f)
+{
+  if constexpr (has_payload<Evt>) {
+    payload_t<Evt> p;
+    if (decode<Evt>(evt, p)) f(static_cast<const payload_t<Evt> &>(p));
+  } else {
+    f();
+  }
+}
+
+template <typename Evt, auto Fn>
+void fn_trampoline(const evt_t *evt, void *)
+{
+  invoke<Evt>(evt, [](auto &&...args) { Fn(args...); });
+}
+
+template <typename Evt, auto Method, typename C>
+void method_trampoline(const evt_t *evt, void *ctx)
+{
+  C *obj = static_cast<C *>(ctx);
+  invoke<Evt>(evt, [obj](auto &&...args) { (obj->*Method)(args...); });
+}
+
+template <typename Evt, typename F>
+void callable_trampoline(const evt_t *evt, void *ctx)
+{
+  invoke<Evt>(evt, *static_cast<F *>(ctx));
+}
+
+} /* namespace detail */
+
+/* ------------------------------- Publish ---------------------------------- */
+
+/** @brief Publish a typed event (see evt_bus_publish_ex()). */
+template <typename Evt>
+inline evt_pub_result_t publish(const detail::payload_t<Evt> &payload)
+{
+  return evt_bus_publish_ex(Evt::id, &payload, Evt::size);
+}
+
+/** @brief Publish a signal-only event. */
+template <typename Evt>
+inline evt_pub_result_t publish()
+{
+  static_assert(!detail::has_payload<Evt>, "event has a payload; use publish<Evt>(payload)");
+  return evt_bus_publish_ex(Evt::id, nullptr, 0);
+}
+
+/** @brief ISR variant of publish(). */
+template <typename Evt>
+inline evt_pub_result_t publish_from_isr(const detail::payload_t<Evt> &payload)
+{
+  return evt_bus_publish_from_isr_ex(Evt::id, &payload, Evt::size);
+}
+
+/** @brief Publish on behalf of a registered publisher token (see evt_bus_publish_as()). */
+template <typename Evt>
+inline evt_pub_result_t publish_as(evt_pub_id_t pub, const detail::payload_t<Evt> &payload)
+{
+  return evt_bus_publish_as(pub, Evt::id, &payload, Evt::size);
+}
+
+/* ------------------------------ Subscribe --------------------------------- */
+
+/**
+ * @brief Subscribe a free function (or captureless lambda converted to a function pointer).
+ *
+ * @tparam Fn Callable as Fn(const T&), or Fn() for void events.
+ */
+template <typename Evt, auto Fn>
+inline evt_sub_handle_t subscribe()
+{
+  return evt_bus_subscribe(Evt::id, &detail::fn_trampoline<Evt, Fn>, nullptr);
+}
+
+/**
+ * @brief Subscribe a member function of @p obj.
+ *
+ * @tparam Method Pointer to member, called as (obj.*Method)(const T&).
+ */
+template <typename Evt, auto Method, typename C>
+inline evt_sub_handle_t subscribe(C &obj)
+{
+  return evt_bus_subscribe(Evt::id, &detail::method_trampoline<Evt, Method, C>, &obj);
+}
+
+/**
+ * @brief Subscribe a caller-owned callable (e.g. a capturing lambda held in static storage).
+ *
+ * The callable is referenced, not copied: it must outlive the subscription.
+ */
+template <typename Evt, typename F>
+inline evt_sub_handle_t subscribe(F &callable)
+{
+  static_assert(!std::is_const<F>::value, "callable is invoked through a non-const pointer");
+  return evt_bus_subscribe(Evt::id, &detail::callable_trampoline<Evt, F>, &callable);
+}
+
+/** @brief Unsubscribe (same semantics as evt_bus_unsubscribe()). */
+inline void unsubscribe(evt_sub_handle_t handle)
+{
+  evt_bus_unsubscribe(handle);
+}
+
+/** @brief Decode the typed payload of a raw envelope; false on ID/length mismatch. */
+template <typename Evt>
+inline bool payload(const evt_t &evt, detail::payload_t<Evt> &out)
+{
+  return evt.id == Evt::id && detail::decode<Evt>(&evt, out);
+}
+
+} /* namespace evt_bus */
+
+#endif /* EVT_BUS_HPP */
@@ -0,0 +1,149 @@
+#ifndef EVT_BUS_BRIDGE_H
+#define EVT_BUS_BRIDGE_H
+
+/**
+ * @file evt_bus_bridge.h
+ * @brief Forward selected event IDs over a byte-stream link (UART, SPI, pipe, ...).
+ *
+ * TX: the bridge subscribes to a set of IDs and packs their events into frames, several
+ * records per frame, written through a pluggable link hook. RX: bytes read from the link
+ * are fed to evt_bus_bridge_rx(), which resynchronizes on the frame header, checks the
+ * CRC and republishes the decoded events on the local bus.
+ *
+ * Frame format:
+ *   0xE5 0xB5 | body_len (u16 LE) | body[body_len] | crc16 (u16 LE)
+ *   body   : record...
+ *   record : evt_id len payload[len]   (evt_id and len are unsigned LEB128 varints)
+ * crc16 is CRC-16/CCITT-FALSE over body_len and body.
+ *
+ * Context rules:
+ * - Forwarding (the subscriber callbacks) and evt_bus_bridge_flush() run in the
+ *   dispatcher context; the link write hook is called from there.
+ * - evt_bus_bridge_rx() runs in the reader's task context (publishes, never dispatches).
+ * TX and RX state are separate, so one bridge can serve both directions of a link.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "evt_bus/evt_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest frame on the wire (header + body + CRC); sizes both TX and RX buffers */
+#ifndef EVT_BRIDGE_MAX_FRAME
+#define EVT_BRIDGE_MAX_FRAME 256u
+#endif
+
+/* Most IDs one bridge forwards */
+#ifndef EVT_BRIDGE_MAX_IDS
+#define EVT_BRIDGE_MAX_IDS 16u
+#endif
+
+#define EVT_BRIDGE_SYNC0     0xE5u
+#define EVT_BRIDGE_SYNC1     0xB5u
+#define EVT_BRIDGE_OVERHEAD  6u     /* sync + body_len + crc */
+#define EVT_BRIDGE_MAX_BODY  (EVT_BRIDGE_MAX_FRAME - EVT_BRIDGE_OVERHEAD)
+
+/* Largest encoded record: 3-byte id + 3-byte len + payload */
+#define EVT_BRIDGE_MAX_RECORD (3u + 3u + EVT_INLINE_MAX)
+
+EVT_BUS_STATIC_ASSERT(EVT_BRIDGE_MAX_BODY >= EVT_BRIDGE_MAX_RECORD,
+                      "EVT_BRIDGE_MAX_FRAME must hold one full-size record");
+EVT_BUS_STATIC_ASSERT(EVT_BRIDGE_MAX_BODY <= UINT16_MAX,
+                      "EVT_BRIDGE_MAX_FRAME body must fit the u16 length field");
+
+/* Byte-stream write hook. Returns false if the frame was not taken (counted, dropped). */
+typedef struct {
+  void *ctx;
+  bool (*write)(void *ctx, const uint8_t *data, size_t len);
+} evt_bridge_link_t;
+
+typedef struct {
+  const evt_id_t *ids;           /* IDs forwarded to the link */
+  size_t          n_ids;         /* <= EVT_BRIDGE_MAX_IDS */
+  uint16_t        max_records;   /* send once a frame holds this many; 0 = when full */
+  uint32_t        max_delay_us;  /* send once the oldest record is this old; 0 = off */
+} evt_bridge_cfg_t;
+
+typedef struct {
+  uint32_t tx_frames;
+  uint32_t tx_records;
+  uint32_t tx_dropped;       /* records in frames the link refused */
+  uint32_t rx_frames;        /* frames with a valid CRC */
+  uint32_t rx_records;       /* republished on the local bus */
+  uint32_t rx_rejected;      /* refused by the local bus (backpressure) */
+  uint32_t rx_looped;        /* IDs this bridge also forwards: dropped, would echo */
+  uint32_t rx_crc_errors;
+  uint32_t rx_format_errors; /* bad length or malformed record */
+} evt_bridge_stats_t;
+
+/* Bridge state. Fields are private except stats. */
+typedef struct {
+  evt_bus_t        *bus;
+  evt_bridge_link_t link;
+  uint16_t          max_records;
+  uint32_t          max_delay_us;
+  evt_sub_handle_t  subs[EVT_BRIDGE_MAX_IDS];
+  size_t            n_subs;
+  uint8_t           tx_ids[(EVT_BUS_MAX_EVT_IDS + 7u) / 8u];
+
+  /* TX: dispatcher context */
+  uint8_t  tx_buf[EVT_BRIDGE_MAX_FRAME];
+  size_t   tx_len;           /* body bytes buffered */
+  uint16_t tx_count;
+  uint32_t tx_first_us;
+
+  /* RX: reader context */
+  uint8_t  rx_buf[EVT_BRIDGE_MAX_FRAME];
+  uint8_t  rx_state;
+  size_t   rx_pos;
+  size_t   rx_len;
+
+  evt_bridge_stats_t stats;
+} evt_bridge_t;
+
+/**
+ * @brief Start forwarding @p cfg->ids of @p bus to @p link.
+ *
+ * Subscribes to all IDs at once (evt_bus_inst_subscribe_many()). The same bridge
+ * decodes frames passed to evt_bus_bridge_rx().
+ *
+ * @return false on invalid arguments or if the subscriptions failed.
+ */
+bool evt_bus_bridge_start(evt_bridge_t *br, evt_bus_t *bus, const evt_bridge_link_t *link,
+                          const evt_bridge_cfg_t *cfg);
+
+/**
+ * @brief Stop forwarding (unsubscribes). Buffered records are discarded; flush first.
+ */
+void evt_bus_bridge_stop(evt_bridge_t *br);
+
+/**
+ * @brief Send the partially filled frame, if any.
+ *
+ * Dispatcher context only. Call it when the dispatcher runs out of events, so the tail
+ * of a burst is not held back until the next one.
+ */
+void evt_bus_bridge_flush(evt_bridge_t *br);
+
+/**
+ * @brief Feed bytes read from the link; complete frames are republished on the bus.
+ *
+ * Accepts any chunking. Garbage and corrupted frames are skipped until the next header.
+ */
+void evt_bus_bridge_rx(evt_bridge_t *br, const uint8_t *data, size_t len);
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) update.
+ */
+uint16_t evt_bus_bridge_crc16(uint16_t crc, const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVT_BUS_BRIDGE_H */
@@ -13,6 +13,12 @@
  *
  */
 
+/* Optional project configuration, included before the defaults below so its values
+ * win (e.g. -DEVT_BUS_USER_CONFIG='"app_evt_config.h"' from tools/evt_bus_gen.py). */
+#ifdef EVT_BUS_USER_CONFIG
+#include EVT_BUS_USER_CONFIG
+#endif
+
  /* Payload is always copied into the queued event (no pointer payloads). */
 #ifndef EVT_INLINE_MAX
 #define EVT_INLINE_MAX 16u  /* tune based on typical payload sizes */
@@ -32,7 +38,136 @@
 #define EVT_BUS_MAX_HANDLES (EVT_BUS_MAX_SUBSCRIBERS_PER_EVT * EVT_BUS_MAX_EVT_IDS)
 #endif
 
-_Static_assert(EVT_INLINE_MAX <= UINT16_MAX,
-               "EVT_INLINE_MAX must fit in uint16_t");
+/* Queue slots kept free for critical event IDs (see evt_policy_t.critical).
+ * Default for evt_bus_set_reserved_slots(); 0 disables the reservation. */
+#ifndef EVT_BUS_RESERVED_SLOTS
+#define EVT_BUS_RESERVED_SLOTS 0u
+#endif
+
+/* Poll step of an EVT_BP_BLOCK publisher waiting for a slot above the reservation
+ * (backend waiter_sleep). */
+#ifndef EVT_BUS_RESERVE_POLL_MS
+#define EVT_BUS_RESERVE_POLL_MS 1u
+#endif
+
+/* Publisher tokens with per-publisher quotas (see evt_bus_publisher_register).
+ * 0 disables the feature and keeps evt_t without the publisher field. */
+#ifndef EVT_BUS_MAX_PUBLISHERS
+#define EVT_BUS_MAX_PUBLISHERS 0u
+#endif
+
+/* Compact-memory profile: store handles, envelope IDs and lengths in the narrowest
+ * type the limits above allow (8-bit when they fit). Changes evt_t / evt_sub_handle_t;
+ * 8-bit handle generations wrap after 256 reuses of a handle slot. */
+#ifndef EVT_BUS_COMPACT
+#define EVT_BUS_COMPACT 0
+#endif
+
+/* Envelope metadata: evt_t carries a per-bus publish sequence number and the backend
+ * now_us publish timestamp, and the dispatcher tracks queue latency and sequence gaps
+ * (see evt_bus_meta_stats). 0 keeps evt_t unchanged. */
+#ifndef EVT_BUS_ENVELOPE_META
+#define EVT_BUS_ENVELOPE_META 0
+#endif
+
+/* Retained last-value slots (see evt_bus_set_retained): the core keeps the last
+ * dispatched event of up to this many IDs and can replay it to late subscribers.
+ * 0 disables the feature. */
+#ifndef EVT_BUS_MAX_RETAINED
+#define EVT_BUS_MAX_RETAINED 0u
+#endif
+
+/* Publish-side dedup slots (see evt_bus_set_dedup): up to this many IDs drop identical
+ * back-to-back publishes while a copy is queued or within a time window. 0 disables the
+ * feature. */
+#ifndef EVT_BUS_MAX_DEDUP
+#define EVT_BUS_MAX_DEDUP 0u
+#endif
+
+/* Batch subscriber slots (see evt_bus_subscribe_batch) and the largest batch each one
+ * buffers. Every slot holds EVT_BUS_BATCH_MAX_EVENTS envelopes. 0 disables the feature. */
+#ifndef EVT_BUS_MAX_BATCH_SUBS
+#define EVT_BUS_MAX_BATCH_SUBS 0u
+#endif
+
+#ifndef EVT_BUS_BATCH_MAX_EVENTS
+#define EVT_BUS_BATCH_MAX_EVENTS 8u
+#endif
+
+/* One-shot waiter table (see evt_bus_wait_for): tasks blocked until an event ID is
+ * dispatched. 0 disables the feature. Requires the backend waiter_* hooks. */
+#ifndef EVT_BUS_MAX_WAITERS
+#define EVT_BUS_MAX_WAITERS 0u
+#endif
+
+/* Reply slots for request/response (see evt_bus_request): callers blocked until a
+ * responder answers their request directly into the slot. 0 disables the feature.
+ * Adds a correlation ID to evt_t. Requires the backend waiter_* hooks. */
+#ifndef EVT_BUS_MAX_REQUESTS
+#define EVT_BUS_MAX_REQUESTS 0u
+#endif
+
+/* Worker contexts the backend offers for parallel fan-out of one event (see
+ * evt_bus_set_parallel). The dispatcher runs one share itself, so an event is spread over
+ * up to EVT_BUS_FANOUT_WORKERS + 1 contexts. 0 disables the feature. Requires the
+ * backend fanout_* hooks. */
+#ifndef EVT_BUS_FANOUT_WORKERS
+#define EVT_BUS_FANOUT_WORKERS 0u
+#endif
+
+/* Direct lane for single-subscriber IDs: the dispatcher caches the sole subscriber of an ID
+ * and delivers to it without the lock or the row scan until the subscription changes.
+ * Adds one cached entry per event ID and one ID per handle to evt_bus_t. */
+#ifndef EVT_BUS_DIRECT_LANE
+#define EVT_BUS_DIRECT_LANE 0
+#endif
+
+/* On-demand liveness probe (see evt_bus_ping / evt_bus_liveness): ping control events
+ * acknowledged in queue order plus a "busy since" record of the event being dispatched.
+ * Replaces periodic dispatcher wakeups for liveness monitoring. */
+#ifndef EVT_BUS_LIVENESS
+#define EVT_BUS_LIVENESS 0
+#endif
+
+/* Per-subscriber decimation and minimum interval, checked in the dispatch snapshot (see
+ * evt_bus_subscribe_throttled). Adds 16 bytes per handle to evt_bus_t. */
+#ifndef EVT_BUS_SUB_THROTTLE
+#define EVT_BUS_SUB_THROTTLE 0
+#endif
+
+/* Slow-callback watchdog: per-callback time budget with overrun reporting and optional
+ * suspension of offending subscribers (see evt_bus_set_cb_watchdog). Adds two bytes
+ * per handle to evt_bus_t. */
+#ifndef EVT_BUS_CB_WATCHDOG
+#define EVT_BUS_CB_WATCHDOG 0
+#endif
+
+/* C++ consumers (evt_bus.hpp) include this header too */
+#ifdef __cplusplus
+#define EVT_BUS_STATIC_ASSERT(cond, msg) static_assert(cond, msg)
+#else
+#define EVT_BUS_STATIC_ASSERT(cond, msg) _Static_assert(cond, msg)
+#endif
+
+EVT_BUS_STATIC_ASSERT(EVT_BUS_MAX_PUBLISHERS < 255u,
+                      "EVT_BUS_MAX_PUBLISHERS must fit in evt_pub_id_t");
+
+EVT_BUS_STATIC_ASSERT(EVT_BUS_MAX_RETAINED < 255u,
+                      "EVT_BUS_MAX_RETAINED must fit in the uint8_t slot map");
+
+EVT_BUS_STATIC_ASSERT(EVT_BUS_MAX_DEDUP < 255u,
+                      "EVT_BUS_MAX_DEDUP must fit in the uint8_t slot map");
+
+EVT_BUS_STATIC_ASSERT(EVT_BUS_MAX_REQUESTS < 255u,
+                      "EVT_BUS_MAX_REQUESTS must fit in the low byte of evt_corr_t");
+
+EVT_BUS_STATIC_ASSERT(EVT_BUS_BATCH_MAX_EVENTS > 0u && EVT_BUS_BATCH_MAX_EVENTS <= UINT16_MAX,
+                      "EVT_BUS_BATCH_MAX_EVENTS must be in 1..65535");
+
+EVT_BUS_STATIC_ASSERT(EVT_INLINE_MAX <= UINT16_MAX,
+                      "EVT_INLINE_MAX must fit in uint16_t");
+
+EVT_BUS_STATIC_ASSERT(!EVT_BUS_LIVENESS || EVT_INLINE_MAX >= 5u,
+                      "EVT_BUS_LIVENESS needs EVT_INLINE_MAX >= 5 for the ping ticket");
 
 #endif /* EVT_BUS_CONFIG_H */
\ No newline at end of file
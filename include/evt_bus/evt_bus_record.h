@@ -0,0 +1,144 @@
+#ifndef EVT_BUS_RECORD_H
+#define EVT_BUS_RECORD_H
+
+/**
+ * @file evt_bus_record.h
+ * @brief Event stream recorder / replayer.
+ *
+ * The recorder taps every event the dispatcher of a bus takes off the queue
+ * (evt_bus_inst_set_tap()) and writes it to a pluggable sink, in queue order and
+ * including ISR publishes. The replayer reads a recording back and republishes it,
+ * either as fast as possible or at the original pacing, to reproduce field load on
+ * the host.
+ *
+ * Stream format (integers are unsigned LEB128 varints):
+ *   header : 'E' 'V' 'T' 'R' version
+ *   record : delta_us evt_id len payload[len]
+ * delta_us is relative to the previous record (the first one to evt_bus_rec_start()),
+ * taken from the publish timestamp with EVT_BUS_ENVELOPE_META and from the backend
+ * now_us clock at dispatch otherwise (0 without one). Publishes stamped out of queue
+ * order get delta 0.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "evt_bus/evt_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EVT_REC_VERSION 1u
+
+/* Largest encoded record: 5-byte delta + 3-byte id + 3-byte len + payload */
+#define EVT_REC_MAX_RECORD (5u + 3u + 3u + EVT_INLINE_MAX)
+
+/* Byte sink (file, UART, RAM ring, ...). Returns false if the bytes were not taken. */
+typedef struct {
+  void *ctx;
+  bool (*write)(void *ctx, const uint8_t *data, size_t len);
+} evt_rec_sink_t;
+
+/* Byte source. Returns the number of bytes read, 0 at end of stream. */
+typedef struct {
+  void *ctx;
+  size_t (*read)(void *ctx, uint8_t *data, size_t len);
+} evt_rec_source_t;
+
+/* Recorder state. Fields are private; read the counters after evt_bus_rec_stop(). */
+typedef struct {
+  evt_bus_t      *bus;
+  evt_rec_sink_t  sink;
+  evt_tap_t       tap;
+  uint32_t        last_us;
+  uint32_t        records;   /* records written */
+  uint32_t        skipped;   /* sink write failures */
+} evt_recorder_t;
+
+typedef enum {
+  EVT_REC_OK = 0,
+  EVT_REC_END,          /* clean end of stream */
+  EVT_REC_ERR_FORMAT,   /* bad header, truncated or malformed record */
+} evt_rec_status_t;
+
+typedef struct {
+  uint32_t delta_us;
+  evt_t    evt;
+} evt_rec_entry_t;
+
+typedef enum {
+  EVT_REPLAY_FAST = 0,  /* publish back-to-back */
+  EVT_REPLAY_PACED,     /* honour the recorded deltas */
+} evt_replay_mode_t;
+
+typedef struct {
+  uint8_t mode;                                /* evt_replay_mode_t */
+  void  (*sleep_us)(void *ctx, uint32_t us);   /* required for EVT_REPLAY_PACED */
+  void   *sleep_ctx;
+} evt_replay_cfg_t;
+
+typedef struct {
+  uint32_t         published;  /* accepted by the bus */
+  uint32_t         rejected;   /* refused by the bus (backpressure, invalid id) */
+  evt_rec_status_t status;     /* how the stream ended */
+} evt_replay_stats_t;
+
+/**
+ * @brief Write the stream header and start recording the events dispatched on @p bus.
+ *
+ * The sink is only called by the dispatcher (one record at a time, no bus lock held),
+ * so it needs no locking of its own but delays dispatch while it writes. Replaces any
+ * previously installed tap.
+ *
+ * @return false on invalid arguments or if the sink refused the header.
+ */
+bool evt_bus_rec_start(evt_recorder_t *rec, evt_bus_t *bus, const evt_rec_sink_t *sink);
+
+/**
+ * @brief Stop recording (removes the tap).
+ *
+ * Safe while the bus is running: once it returns the sink is no longer called and
+ * @p rec may be reused. Do not call it from the sink.
+ */
+void evt_bus_rec_stop(evt_recorder_t *rec);
+
+/**
+ * @brief Encode one record into @p out (at least EVT_REC_MAX_RECORD bytes).
+ *
+ * @return Encoded length.
+ */
+size_t evt_bus_rec_encode(uint8_t *out, uint32_t delta_us, const evt_t *evt);
+
+/**
+ * @brief Consume and check the stream header.
+ */
+bool evt_bus_rec_read_header(const evt_rec_source_t *src);
+
+/**
+ * @brief Decode the next record.
+ *
+ * @return EVT_REC_OK with @p out filled, EVT_REC_END at a record boundary end of
+ *         stream, EVT_REC_ERR_FORMAT otherwise.
+ */
+evt_rec_status_t evt_bus_rec_read_next(const evt_rec_source_t *src, evt_rec_entry_t *out);
+
+/**
+ * @brief Republish a recording on @p bus through evt_bus_inst_publish_ex().
+ *
+ * Paced mode schedules each record at its recorded offset from the first one, using
+ * the bus backend now_us clock to absorb drift when available.
+ *
+ * @param stats Optional result counters.
+ *
+ * @return true if the stream was replayed to its end.
+ */
+bool evt_bus_replay(evt_bus_t *bus, const evt_rec_source_t *src,
+                    const evt_replay_cfg_t *cfg, evt_replay_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVT_BUS_RECORD_H */
@@ -23,27 +23,139 @@ extern "C" {
 #include "evt_bus/evt_bus_config.h"
 
 typedef uint16_t evt_id_t;
-typedef uint16_t hndl_id_t;
+typedef uint8_t  evt_pub_id_t;
+typedef uint32_t evt_corr_t;   /* request correlation ID: reply slot + 1 | generation << 8 */
 
+/* Storage types: narrowed by EVT_BUS_COMPACT when the configured limits allow */
+#if EVT_BUS_COMPACT && (EVT_BUS_MAX_HANDLES < 0xFFu)
+typedef uint8_t  hndl_id_t;
+typedef uint8_t  hndl_gen_t;
+#define EVT_HANDLE_ID_INVALID 0xFFu
+#else
+typedef uint16_t hndl_id_t;
+typedef uint16_t hndl_gen_t;
 #define EVT_HANDLE_ID_INVALID 0xFFFFu
+#endif
+
+/* Envelope IDs also carry EVT_BUS_CTRL_ID, one past the last application ID */
+#if EVT_BUS_COMPACT && (EVT_BUS_MAX_EVT_IDS < 0xFFu)
+typedef uint8_t  evt_env_id_t;
+#else
+typedef evt_id_t evt_env_id_t;
+#endif
+
+#if EVT_BUS_COMPACT && (EVT_INLINE_MAX <= 0xFFu)
+typedef uint8_t  evt_env_len_t;
+#else
+typedef uint16_t evt_env_len_t;
+#endif
+
+#define EVT_PUB_ID_NONE       0u   /* anonymous publisher (no quota) */
+#define EVT_CORR_NONE         0u   /* not a request */
+#define EVT_BUS_WAIT_FOREVER  UINT32_MAX  /* evt_bus_wait_for() / waiter_sleep timeout */
+
+/* Reserved envelope ID for core control events (e.g. retained replay). Dispatchers
+ * pass it to evt_bus_dispatch_evt() like any other event; it has no subscribers. */
+#define EVT_BUS_CTRL_ID       ((evt_id_t)EVT_BUS_MAX_EVT_IDS)
+
+EVT_BUS_STATIC_ASSERT(EVT_BUS_MAX_HANDLES < EVT_HANDLE_ID_INVALID,
+                      "EVT_BUS_MAX_HANDLES must leave room for EVT_HANDLE_ID_INVALID");
+EVT_BUS_STATIC_ASSERT(EVT_BUS_MAX_EVT_IDS < (1u << (8u * sizeof(evt_env_id_t))),
+                      "EVT_BUS_MAX_EVT_IDS must leave room for EVT_BUS_CTRL_ID");
 
 typedef struct {
-  evt_id_t id;            /* EVT_* */
-  uint16_t    len;           /* bytes; must be <= EVT_INLINE_MAX */
+  evt_env_id_t  id;       /* EVT_* */
+  evt_env_len_t len;      /* bytes; must be <= EVT_INLINE_MAX */
   uint8_t     payload[EVT_INLINE_MAX];
+#if EVT_BUS_ENVELOPE_META
+  uint32_t    seq;        /* per-bus publish sequence number (wraps) */
+  uint32_t    ts_us;      /* backend now_us at publish, 0 without a clock */
+#endif
+#if EVT_BUS_MAX_PUBLISHERS > 0
+  evt_pub_id_t pub;       /* publisher token, EVT_PUB_ID_NONE if anonymous */
+#endif
+#if EVT_BUS_MAX_REQUESTS > 0
+  evt_corr_t  corr;       /* evt_bus_request() correlation ID, EVT_CORR_NONE otherwise */
+#endif
 } evt_t;
 
 
 typedef struct __attribute__((packed)) {
-  hndl_id_t id;
-  uint16_t gen; /* generated count */
+  hndl_id_t  id;
+  hndl_gen_t gen; /* generated count */
 } evt_sub_handle_t;
 
+/* Backpressure mode applied when the backend queue has no room for a new event */
+typedef enum {
+  EVT_BP_DROP_NEW = 0,  /* default: reject the new event */
+  EVT_BP_DROP_OLDEST,   /* evict the oldest queued event to make room */
+  EVT_BP_BLOCK,         /* task publishers wait up to timeout_ms for room */
+} evt_bp_mode_t;
+
+/* Per-event-ID publish policy (all-zero == drop-new, not critical) */
+typedef struct {
+  uint8_t  mode;        /* evt_bp_mode_t */
+  bool     critical;    /* may consume the reserved queue capacity */
+  uint32_t timeout_ms;  /* EVT_BP_BLOCK only */
+} evt_policy_t;
+
+/* Publish outcome (see evt_bus_publish_ex) */
+typedef enum {
+  EVT_PUB_OK = 0,             /* enqueued */
+  EVT_PUB_OK_DROPPED_OLDEST,  /* enqueued after evicting the oldest queued event */
+  EVT_PUB_ERR_INVALID,        /* bad evt_id / payload arguments */
+  EVT_PUB_ERR_NO_BACKEND,     /* backend does not provide the required enqueue */
+  EVT_PUB_ERR_FULL,           /* queue full (drop-new) */
+  EVT_PUB_ERR_RESERVED,       /* only reserved capacity left and evt_id is not critical */
+  EVT_PUB_ERR_TIMEOUT,        /* EVT_BP_BLOCK: no room within timeout_ms */
+  EVT_PUB_ERR_QUOTA,          /* publisher already has max_inflight events queued */
+  EVT_PUB_ERR_RATE,           /* publisher token bucket is empty */
+  EVT_PUB_OK_DUPLICATE,       /* dedup ID: an identical event is queued or was accepted
+                               * within the window; not enqueued again */
+  EVT_PUB_ERR_NO_REPLY,       /* evt_bus_request(): enqueued, but no reply within timeout_ms */
+  EVT_PUB_ERR_NO_SLOT,        /* evt_bus_request(): every reply slot is taken; not enqueued */
+} evt_pub_result_t;
+
+/* Dispatcher-side envelope statistics (see evt_bus_meta_stats, EVT_BUS_ENVELOPE_META) */
+typedef struct {
+  uint32_t dispatched;       /* events seen by the dispatcher */
+  uint32_t seq_gaps;         /* sequence numbers never dispatched (rejected or evicted);
+                              * 0 with remote dispatch */
+  uint32_t seq_reordered;    /* events older than one already dispatched; 0 with remote dispatch */
+  uint32_t last_latency_us;  /* publish -> dispatch of the last event */
+  uint32_t max_latency_us;
+} evt_meta_stats_t;
+
+/* Per-publisher admission limits (see evt_bus_publisher_register) */
+typedef struct {
+  uint16_t max_inflight;  /* queued-but-not-dispatched events; 0 => unlimited */
+  uint32_t rate_per_sec;  /* token-bucket refill rate; 0 => no rate limit */
+  uint16_t burst;         /* token-bucket depth (>= 1 when rate_per_sec > 0) */
+} evt_pub_quota_t;
+
+static inline bool evt_pub_ok(evt_pub_result_t r)
+{
+  return (r == EVT_PUB_OK) || (r == EVT_PUB_OK_DROPPED_OLDEST) || (r == EVT_PUB_OK_DUPLICATE);
+}
+
+/* Callback signature: runs on event-bus task context */
+/* user_ctx is optional context provided at subscribe time */
+typedef void (*evt_cb_t)(const evt_t *evt, void *user_ctx);
+
+/* One worker's share of a parallel fan-out: cbs[i](evt, ctxs[i]) for i < n.
+ * Run it with evt_bus_fanout_job_run(). */
+typedef struct {
+  const evt_t    *evt;
+  const evt_cb_t *cbs;
+  void * const   *ctxs;
+  size_t          n;
+} evt_fanout_job_t;
+
 typedef struct {
   void* ctx; /* opaque backend state (FreeRTOS queue handle, ringbuf instance, etc.) */
 
   /* Enqueue a message (thread context). Returns false on full/failure. */
-  bool (*enqueue)(const evt_t *evt);
+  bool (*enqueue)(void* ctx, const evt_t *evt);
 
   /* Dequeue a message WITH blocking/wait. Returns true if msg written. */
   bool (*dequeue_block)(void* ctx, evt_t* evt_out);
@@ -52,20 +164,321 @@ typedef struct {
   bool (*dequeue_nb)(void* ctx, evt_t* evt_out);
 
   /* Optional: ISR-safe enqueue (NULL if not supported). */
-  bool (*enqueue_isr)(const evt_t *evt);
+  bool (*enqueue_isr)(void* ctx, const evt_t *evt);
+
+  /* Optional: enqueue, waiting up to timeout_ms for room (task context only).
+   * Used by EVT_BP_BLOCK; without it blocking IDs behave as drop-new. */
+  bool (*enqueue_timeout)(void* ctx, const evt_t *evt, uint32_t timeout_ms);
+
+  /* Optional: discard the oldest queued event. Returns false if nothing was dropped.
+   * The discarded event is copied to dropped.
+   * Used by EVT_BP_DROP_OLDEST; without it those IDs behave as drop-new. */
+  bool (*drop_oldest)(void* ctx, bool from_isr, evt_t *dropped);
+
+  /* Optional: number of free queue slots. Required for reserved capacity (EVT_BP_BLOCK
+   * IDs poll it with waiter_sleep() while only the reservation is free). */
+  size_t (*free_slots)(void* ctx, bool from_isr);
+
+  /* Optional: monotonic microsecond clock (wraps at 2^32). Callable from task and ISR.
+   * Required for publisher rate limits. */
+  uint32_t (*now_us)(void* ctx);
+
+  /* Optional: evt_bus_wait_for() support (all three or none).
+   * waiter_self() returns a token for the calling task, waiter_sleep() blocks the calling
+   * task until waiter_wake(token) or timeout_ms (EVT_BUS_WAIT_FOREVER) and returns false
+   * on timeout. A wake may arrive after the wait ended; the core tolerates early returns. */
+  void *(*waiter_self)(void* ctx);
+  bool  (*waiter_sleep)(void* ctx, uint32_t timeout_ms);
+  void  (*waiter_wake)(void* ctx, void *waiter);
 
   /* Optional: protect subscribe/unsubscribe vs dispatch if needed (NULL if not used). */
   void (*lock)(void* ctx);
   void (*unlock)(void* ctx);
 
-  /* Optional: backend init function (NULL if not used). */
-  bool (*init)(void);
+  /* Optional: parallel fan-out (EVT_BUS_FANOUT_WORKERS > 0, both or none; dispatcher
+   * context). fanout_start() hands @p job to worker @p worker (< EVT_BUS_FANOUT_WORKERS)
+   * and returns false if it cannot (the dispatcher then runs the job itself). The job
+   * stays valid until fanout_join(), which returns once every started job has run. */
+  bool (*fanout_start)(void* ctx, unsigned worker, const evt_fanout_job_t *job);
+  void (*fanout_join)(void* ctx);
+
+  /* Optional: shared lock for sections that only read the tables (both or none; needs
+   * lock/unlock). Holders may overlap each other but never lock(). Used by the dispatch
+   * snapshot and read-only queries; without it they take lock(). */
+  void (*read_lock)(void* ctx);
+  void (*read_unlock)(void* ctx);
+
+  /* Optional: backend init function (NULL if not used). Called by evt_bus_inst_init(). */
+  bool (*init)(void* ctx);
+
+  /* Events may be dispatched by another evt_bus_t (e.g. in another process), so this
+   * bus never sees them leave the queue. The core then refuses limits that wait for
+   * that: in-flight publisher quotas, dedup of a copy that is still queued (only
+   * the dedup window applies) and liveness pings (dispatchers ignore foreign ones).
+   * Envelope sequence gaps/reordering are not tracked either. */
+  bool remote_dispatch;
 
 } evt_bus_backend_t;
 
-/* Callback signature: runs on event-bus task context */
-/* user_ctx is optional context provided at subscribe time */
-typedef void (*evt_cb_t)(const evt_t *evt, void *user_ctx);
+/* One entry of evt_bus_subscribe_many() */
+typedef struct {
+  evt_id_t evt_id;
+  evt_cb_t cb;
+  void    *user_ctx;
+} evt_sub_req_t;
+
+/* Batch callback: @p n (>= 1) events of one ID in dispatch order. The array is only
+ * valid during the call. Runs on event-bus task context. */
+typedef void (*evt_batch_cb_t)(const evt_t *evts, size_t n, void *user_ctx);
+
+/* Batch subscriber settings (see evt_bus_subscribe_batch) */
+typedef struct {
+  uint16_t max_events;   /* deliver when this many are buffered (0 => EVT_BUS_BATCH_MAX_EVENTS) */
+  uint32_t window_us;    /* also deliver once the oldest is this old; 0 = count only */
+} evt_batch_cfg_t;
+
+/* Throttled subscriber settings (see evt_bus_subscribe_throttled). An event is delivered
+ * only if both limits allow it. */
+typedef struct {
+  uint16_t every_n;          /* deliver the first of every N events (0, 1 => all) */
+  uint32_t min_interval_us;  /* and at most one per interval; 0 = no limit */
+} evt_sub_throttle_t;
+
+/* Dedup settings (see evt_bus_set_dedup) */
+typedef struct {
+  uint32_t window_us;   /* also drop repeats this soon after the last accepted copy;
+                         * 0 = only while that copy is still queued */
+} evt_dedup_cfg_t;
+
+/* Dispatch tap (see evt_bus_set_tap): fn sees every application event the dispatcher
+ * takes off the queue, in queue order and before its subscribers. Runs in the dispatcher
+ * context without the bus lock; must be short. Installed by pointer: keep it unchanged
+ * and valid while installed. */
+typedef struct {
+  void (*fn)(const evt_t *evt, void *ctx);
+  void  *ctx;
+} evt_tap_t;
+
+/* Watchdog report: @p handle overran its budget for `strikes` consecutive callbacks,
+ * the last one taking elapsed_us on evt_id. Runs in the dispatcher context. */
+typedef void (*evt_cb_overrun_hook_t)(evt_sub_handle_t handle, evt_id_t evt_id,
+                                      uint32_t elapsed_us, bool suspended, void *hook_ctx);
+
+/* Slow-callback watchdog settings (see evt_bus_set_cb_watchdog) */
+typedef struct {
+  uint32_t              budget_us;     /* per-callback budget; 0 disables the watchdog */
+  uint8_t               strikes;       /* consecutive overruns before reporting (0 => 1) */
+  bool                  auto_suspend;  /* skip the subscriber until resumed */
+  evt_cb_overrun_hook_t on_overrun;    /* optional */
+  void                 *hook_ctx;
+} evt_cb_watchdog_t;
+
+/* ---- Bus instance storage ------------------------------------------------
+ * Defined here so applications can allocate instances statically.
+ * All fields are private to the core; use the evt_bus_inst_* API.
+ */
+
+/* Hot: read for every delivered event. The handle id is the pool index. */
+typedef struct {
+  evt_cb_t cb;            /* NULL => free */
+  void* user_ctx;
+} evt_subscriber_t;
+
+/* Indexed by event ID */
+typedef struct {
+  evt_sub_handle_t subscribers[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
+} evt_subscription_t;
+
+#if EVT_BUS_MAX_PUBLISHERS > 0
+/* Counters are accessed with atomic builtins (lock-free, ISR-safe) */
+typedef struct {
+  evt_pub_quota_t quota;        /* immutable after registration */
+  uint32_t        inflight;     /* queued, not yet dispatched */
+  uint32_t        tokens;       /* token-bucket level */
+  uint32_t        last_refill;  /* now_us of the last credited refill */
+} evt_publisher_t;
+#endif
+
+#if EVT_BUS_MAX_RETAINED > 0
+/* Last dispatched event of a retained ID (written by the dispatcher only) */
+typedef struct {
+  evt_t evt;
+  bool  valid;
+} evt_retained_t;
+#endif
+
+#if EVT_BUS_MAX_DEDUP > 0
+/* Dedup state of one ID, lock-free: publishers (task and ISR) and the dispatcher update it
+ * with atomic builtins. key is the hash of the last accepted event, bit 0 set while it is
+ * queued. */
+typedef struct {
+  uint32_t key;
+  uint32_t accepted_us;   /* now_us of the last accepted event */
+  uint32_t window_us;     /* under lock */
+} evt_dedup_t;
+#endif
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+/* Batch subscriber slot: registered as a regular subscriber whose callback collects
+ * into buf. buf/count/first_us are touched by the dispatcher only. */
+typedef struct {
+  struct evt_bus_s *bus;
+  evt_batch_cb_t    cb;          /* NULL => free, under lock */
+  void             *user_ctx;
+  evt_sub_handle_t  handle;
+  evt_batch_cfg_t   cfg;
+  uint32_t          first_us;    /* arrival of buf[0] */
+  uint16_t          count;
+  evt_t             buf[EVT_BUS_BATCH_MAX_EVENTS];
+} evt_batch_t;
+#endif
+
+#if EVT_BUS_SUB_THROTTLE
+/* Per-handle throttle: cfg is set under lock at subscribe, the rest is dispatcher only */
+typedef struct {
+  evt_sub_throttle_t cfg;
+  uint16_t           skip;      /* events to drop before the next delivery */
+  bool               primed;    /* last_us is valid */
+  uint32_t           last_us;   /* now_us of the last delivery */
+} evt_throttle_t;
+#endif
+
+#if EVT_BUS_DIRECT_LANE
+/* Cached sole subscriber of an event ID. The dispatcher fills it during a locked snapshot;
+ * anything that could make it wrong clears valid under the lock. */
+typedef struct {
+  evt_cb_t         cb;
+  void            *user_ctx;
+  evt_sub_handle_t handle;    /* pool index + generation (watchdog reports) */
+  bool             timed;     /* watchdog budget was set when filled */
+  uint8_t          valid;     /* atomic */
+} evt_lane_t;
+#endif
+
+#if EVT_BUS_MAX_WAITERS > 0
+/* One-shot waiter slot */
+typedef struct {
+  void    *task;     /* backend waiter token */
+  evt_t   *out;      /* copy of the matching event, may be NULL */
+  evt_id_t id;
+  uint8_t  state;    /* free / pending / done */
+} evt_waiter_t;
+#endif
+
+#if EVT_BUS_MAX_REQUESTS > 0
+/* Reply slot of a pending evt_bus_request() */
+typedef struct {
+  void    *task;     /* backend waiter token */
+  evt_t   *reply;    /* caller's reply buffer, may be NULL */
+  uint32_t gen;      /* requests issued on this slot, upper bits of the correlation ID */
+  uint8_t  state;    /* free / pending / done */
+} evt_req_slot_t;
+#endif
+
+typedef struct evt_bus_s {
+  evt_bus_backend_t *backend;
+
+  evt_subscriber_t   subscriber_pool[EVT_BUS_MAX_HANDLES];
+  evt_subscription_t subscriptions[EVT_BUS_MAX_EVT_IDS];
+
+  /* Cold: only compared against handles on (un)subscribe and slot validation */
+  hndl_gen_t         subscriber_gen[EVT_BUS_MAX_HANDLES];
+
+  evt_policy_t policies[EVT_BUS_MAX_EVT_IDS];
+  size_t       reserved_slots;
+
+  const evt_tap_t *tap;        /* replaced as a whole by evt_bus_set_tap() */
+  uint8_t          tap_busy;   /* dispatcher inside tap->fn */
+
+#if EVT_BUS_MAX_RETAINED > 0
+  uint8_t        retained_slot[EVT_BUS_MAX_EVT_IDS];    /* slot + 1, 0 = not retained */
+  evt_retained_t retained[EVT_BUS_MAX_RETAINED];
+  uint8_t        replay_pending[EVT_BUS_MAX_HANDLES];   /* under lock */
+  uint32_t       replay_count;                          /* pending replays, under lock */
+#endif
+
+#if EVT_BUS_MAX_DEDUP > 0
+  uint8_t     dedup_slot[EVT_BUS_MAX_EVT_IDS];   /* slot + 1, 0 = no dedup, under lock */
+  evt_dedup_t dedup[EVT_BUS_MAX_DEDUP];
+#endif
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+  evt_batch_t batches[EVT_BUS_MAX_BATCH_SUBS];
+  uint32_t    batch_used;   /* slots in use, under lock */
+  uint32_t    batch_open;   /* slots with buffered events, dispatcher only */
+#endif
+
+#if EVT_BUS_MAX_WAITERS > 0
+  evt_waiter_t waiters[EVT_BUS_MAX_WAITERS];   /* under lock */
+  uint32_t     waiting;                        /* pending waiters, under lock */
+#endif
+
+#if EVT_BUS_MAX_REQUESTS > 0
+  evt_req_slot_t requests[EVT_BUS_MAX_REQUESTS];   /* under lock */
+#endif
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+  uint8_t parallel_ids[(EVT_BUS_MAX_EVT_IDS + 7u) / 8u];   /* under lock */
+#endif
+
+#if EVT_BUS_SUB_THROTTLE
+  evt_throttle_t throttle[EVT_BUS_MAX_HANDLES];
+#endif
+
+#if EVT_BUS_DIRECT_LANE
+  evt_lane_t lanes[EVT_BUS_MAX_EVT_IDS];
+  evt_id_t   lane_of[EVT_BUS_MAX_HANDLES];   /* ID + 1 whose lane caches the handle, under lock */
+#endif
+
+#if EVT_BUS_CB_WATCHDOG
+  evt_cb_watchdog_t watchdog;
+  uint8_t           wd_strikes[EVT_BUS_MAX_HANDLES];    /* dispatcher only */
+  uint8_t           wd_suspended[EVT_BUS_MAX_HANDLES];  /* under lock */
+#endif
+
+#if EVT_BUS_LIVENESS
+  uint32_t pings_sent;      /* atomic */
+  uint32_t pings_acked;     /* atomic, written by the dispatcher */
+  uint32_t busy_seq;        /* atomic, odd while dispatching: guards busy_id/busy_since_us */
+  evt_id_t busy_id;
+  uint32_t busy_since_us;
+#endif
+
+#if EVT_BUS_ENVELOPE_META
+  uint32_t         next_seq;     /* atomic: stamped by publishers */
+  uint32_t         expect_seq;   /* dispatcher only */
+  evt_meta_stats_t meta;         /* dispatcher only */
+#endif
+
+#if EVT_BUS_MAX_PUBLISHERS > 0
+  evt_publisher_t publishers[EVT_BUS_MAX_PUBLISHERS];
+  uint32_t        publisher_count;
+#endif
+} evt_bus_t;
+
+/* Liveness snapshot (see evt_bus_liveness) */
+typedef struct {
+  uint32_t pings_sent;      /* pings queued so far */
+  uint32_t pings_acked;     /* pings the dispatcher reached, in queue order */
+  bool     busy;            /* dispatcher is inside evt_bus_dispatch_evt() */
+  evt_id_t busy_id;         /* event being dispatched (EVT_BUS_CTRL_ID for control), if busy */
+  uint32_t busy_since_us;   /* now_us when that event was dequeued, if busy */
+} evt_bus_liveness_t;
+
+/* Static RAM report (see evt_bus_footprint) */
+typedef struct {
+  size_t bus;            /* sizeof(evt_bus_t), one per instance */
+  size_t subscribers;    /* hot cb/ctx pool */
+  size_t generations;    /* cold handle generations */
+  size_t subscriptions;  /* per-ID handle slots */
+  size_t policies;
+  size_t publishers;     /* 0 unless EVT_BUS_MAX_PUBLISHERS > 0 */
+  size_t retained;       /* 0 unless EVT_BUS_MAX_RETAINED > 0 */
+  size_t batches;        /* 0 unless EVT_BUS_MAX_BATCH_SUBS > 0 */
+  size_t throttles;      /* 0 unless EVT_BUS_SUB_THROTTLE */
+  size_t envelope;       /* sizeof(evt_t): cost of one queue slot in the backend */
+  size_t handle;         /* sizeof(evt_sub_handle_t) */
+} evt_bus_footprint_t;
 
 #ifdef __cplusplus
 }
@@ -9,6 +9,8 @@
 #include "evt_bus/evt_bus.h"
 #include "evt_bus/evt_bus_config.h"
 
+#include <string.h>
+
 /* -------- Port config defaults (override via compile defs or a config header) -------- */
 #ifndef EVT_BUS_FREERTOS_TASK_NAME
 #define EVT_BUS_FREERTOS_TASK_NAME "evt_bus"
@@ -32,126 +34,369 @@
 #define EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS 0  /* 0 => disabled (block forever) */
 #endif
 
-typedef struct {
-  volatile TickType_t last_beat;
-  volatile uint32_t   beat_count;
-  volatile uint32_t   events_dispatched;
-} evt_bus_fr_hb_t;
-
-static evt_bus_fr_hb_t s_hb;
-
-static inline void fr_heartbeat_tick(void)
+static inline void fr_heartbeat_tick(evt_bus_freertos_t *port)
 {
-  s_hb.last_beat = xTaskGetTickCount();
-  s_hb.beat_count++;
+  port->hb.last_beat = xTaskGetTickCount();
+  port->hb.beat_count++;
 }
 
-static inline void fr_heartbeat_on_dispatch(void)
+static inline void fr_heartbeat_on_dispatch(evt_bus_freertos_t *port)
 {
-  s_hb.events_dispatched++;
+  port->hb.events_dispatched++;
 }
 
 /* Function prototypes */
-bool evt_bus_freertos_init(void);
+static bool fr_init(void *ctx);
+static bool fr_enqueue(void *ctx, const evt_t *evt);
+static bool fr_dequeue_block(void *ctx, evt_t *evt_out);
+static bool fr_enqueue_isr(void *ctx, const evt_t *evt);
+static bool fr_enqueue_timeout(void *ctx, const evt_t *evt, uint32_t timeout_ms);
+static bool fr_drop_oldest(void *ctx, bool from_isr, evt_t *dropped);
+static size_t fr_free_slots(void *ctx, bool from_isr);
+static uint32_t fr_now_us(void *ctx);
+static void *fr_waiter_self(void *ctx);
+static bool fr_waiter_sleep(void *ctx, uint32_t timeout_ms);
+static void fr_waiter_wake(void *ctx, void *waiter);
+static void fr_lock(void *ctx);
+static void fr_unlock(void *ctx);
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_RW
+static void fr_read_lock(void *ctx);
+static void fr_read_unlock(void *ctx);
+#define FR_READ_LOCK   fr_read_lock
+#define FR_READ_UNLOCK fr_read_unlock
+#else
+#define FR_READ_LOCK   NULL
+#define FR_READ_UNLOCK NULL
+#endif
 static void evt_bus_dispatcher_task(void *arg);
+#if EVT_BUS_FANOUT_WORKERS > 0
+static bool fr_fanout_start(void *ctx, unsigned worker, const evt_fanout_job_t *job);
+static void fr_fanout_join(void *ctx);
+#define FR_FANOUT_START fr_fanout_start
+#define FR_FANOUT_JOIN  fr_fanout_join
+#else
+#define FR_FANOUT_START NULL
+#define FR_FANOUT_JOIN  NULL
+#endif
 
-/* -------- Port-owned backend state -------- */
-typedef struct {
-  QueueHandle_t q;
-} freertos_backend_ctx_t;
-
-static freertos_backend_ctx_t s_ctx;
-
-/* Core references this symbol (declared extern in core .c) */
-evt_bus_backend_t evt_bus_backend = {
-  .ctx          = NULL,
-  .enqueue      = NULL,
-  .dequeue_nb   = NULL,
-  .dequeue_block= NULL,
-  .enqueue_isr  = NULL,
-  .lock         = NULL,
-  .unlock       = NULL,
-  .init         = evt_bus_freertos_init,
-};
+#define FR_BACKEND_INIT(port_ptr) {           \
+  .ctx             = (port_ptr),              \
+  .enqueue         = fr_enqueue,              \
+  .dequeue_nb      = NULL,                    \
+  .dequeue_block   = fr_dequeue_block,        \
+  .enqueue_isr     = fr_enqueue_isr,          \
+  .enqueue_timeout = fr_enqueue_timeout,      \
+  .drop_oldest     = fr_drop_oldest,          \
+  .free_slots      = fr_free_slots,           \
+  .now_us          = fr_now_us,               \
+  .waiter_self     = fr_waiter_self,          \
+  .waiter_sleep    = fr_waiter_sleep,         \
+  .waiter_wake     = fr_waiter_wake,          \
+  .fanout_start    = FR_FANOUT_START,         \
+  .fanout_join     = FR_FANOUT_JOIN,          \
+  .lock            = fr_lock,                 \
+  .unlock          = fr_unlock,               \
+  .read_lock       = FR_READ_LOCK,            \
+  .read_unlock     = FR_READ_UNLOCK,          \
+  .init            = fr_init,                 \
+}
+
+/* -------- Port-owned state for the default bus -------- */
+static evt_bus_freertos_t s_port;
+
+/* Core references this symbol (declared extern in core .c).
+ * Backend functions refuse to run until fr_init() created the queue/mutex. */
+evt_bus_backend_t evt_bus_backend = FR_BACKEND_INIT(&s_port);
 
 /* -------- Backend function implementations -------- */
 
-static bool fr_enqueue(const evt_t *evt)
+static bool fr_enqueue(void *ctx, const evt_t *evt)
 {
-  if (s_ctx.q == NULL) return false;
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (port->q == NULL) return false;
   /* evt_t is POD and fixed-size => send by copy */
-  return (xQueueSend(s_ctx.q, evt, 0) == pdPASS);
+  return (xQueueSend(port->q, evt, 0) == pdPASS);
 }
 
 static bool fr_dequeue_block(void *ctx, evt_t *evt_out)
 {
-  (void)ctx;
-  if (s_ctx.q == NULL) return false;
-  return (xQueueReceive(s_ctx.q, evt_out, pdMS_TO_TICKS(EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS)) == pdPASS);
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (port->q == NULL) return false;
+  return (xQueueReceive(port->q, evt_out, pdMS_TO_TICKS(EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS)) == pdPASS);
+}
+
+static bool fr_enqueue_isr(void *ctx, const evt_t *evt)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (port->q == NULL) return false;
+
+  BaseType_t hpw = pdFALSE;
+  BaseType_t ok = xQueueSendFromISR(port->q, evt, &hpw);
+  portYIELD_FROM_ISR(hpw);
+  return (ok == pdPASS);
 }
 
-static bool fr_enqueue_isr(const evt_t *evt)
+static bool fr_enqueue_timeout(void *ctx, const evt_t *evt, uint32_t timeout_ms)
 {
-  if (s_ctx.q == NULL) return false;
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (port->q == NULL) return false;
+  return (xQueueSend(port->q, evt, pdMS_TO_TICKS(timeout_ms)) == pdPASS);
+}
+
+static bool fr_drop_oldest(void *ctx, bool from_isr, evt_t *dropped)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (port->q == NULL) return false;
+
+  if (!from_isr) {
+    return (xQueueReceive(port->q, dropped, 0) == pdPASS);
+  }
 
   BaseType_t hpw = pdFALSE;
-  BaseType_t ok = xQueueSendFromISR(s_ctx.q, evt, &hpw);
+  BaseType_t ok = xQueueReceiveFromISR(port->q, dropped, &hpw);
   portYIELD_FROM_ISR(hpw);
   return (ok == pdPASS);
 }
 
+static size_t fr_free_slots(void *ctx, bool from_isr)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (port->q == NULL) return 0;
+  if (!from_isr) {
+    return (size_t)uxQueueSpacesAvailable(port->q);
+  }
+  /* uxQueueSpacesAvailable() is not ISR-safe */
+  return (size_t)port->cfg.queue_depth - (size_t)uxQueueMessagesWaitingFromISR(port->q);
+}
+
+static uint32_t fr_now_us(void *ctx)
+{
+  (void)ctx;
+  /* Tick resolution; the FromISR variant is safe from both contexts. Computed from the
+   * tick rate: portTICK_PERIOD_MS is 0 above 1000 Hz. */
+  const uint64_t ticks = (uint64_t)xTaskGetTickCountFromISR();
+  return (uint32_t)(ticks * 1000000u / (uint64_t)configTICK_RATE_HZ);
+}
+
+/* evt_bus_wait_for(): direct-to-task notifications, no per-waiter RTOS object */
+static void *fr_waiter_self(void *ctx)
+{
+  (void)ctx;
+  return xTaskGetCurrentTaskHandle();
+}
+
+static bool fr_waiter_sleep(void *ctx, uint32_t timeout_ms)
+{
+  (void)ctx;
+  const TickType_t to = (timeout_ms == EVT_BUS_WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+#if EVT_BUS_FREERTOS_NOTIFY_INDEX > 0
+  return ulTaskNotifyTakeIndexed(EVT_BUS_FREERTOS_NOTIFY_INDEX, pdTRUE, to) > 0;
+#else
+  return ulTaskNotifyTake(pdTRUE, to) > 0;
+#endif
+}
 
-static StaticSemaphore_t s_mtx_buf;
-static SemaphoreHandle_t s_mtx;
+static void fr_waiter_wake(void *ctx, void *waiter)
+{
+  (void)ctx;
+#if EVT_BUS_FREERTOS_NOTIFY_INDEX > 0
+  (void)xTaskNotifyGiveIndexed((TaskHandle_t)waiter, EVT_BUS_FREERTOS_NOTIFY_INDEX);
+#else
+  (void)xTaskNotifyGive((TaskHandle_t)waiter);
+#endif
+}
 
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_SPIN
+/* The core never blocks or calls back into user code while holding the lock */
 static void fr_lock(void *ctx)
 {
+#if defined(portMUX_INITIALIZER_UNLOCKED)
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  taskENTER_CRITICAL(&port->spin);
+#else
   (void)ctx;
-  (void)xSemaphoreTake(s_mtx, portMAX_DELAY);
+  taskENTER_CRITICAL();
+#endif
 }
 
 static void fr_unlock(void *ctx)
 {
+#if defined(portMUX_INITIALIZER_UNLOCKED)
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  taskEXIT_CRITICAL(&port->spin);
+#else
   (void)ctx;
-  (void)xSemaphoreGive(s_mtx);
+  taskEXIT_CRITICAL();
+#endif
+}
+#else
+static void fr_lock(void *ctx)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  (void)xSemaphoreTake(port->mtx, portMAX_DELAY);
+}
+
+static void fr_unlock(void *ctx)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  (void)xSemaphoreGive(port->mtx);
+}
+#endif
+
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_RW
+/* First reader takes the writer semaphore for all readers, the last one gives it back
+ * (possibly from another task, hence a binary semaphore rather than a mutex). */
+static void fr_read_lock(void *ctx)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  (void)xSemaphoreTake(port->rd_mtx, portMAX_DELAY);
+  if (++port->readers == 1u) {
+    (void)xSemaphoreTake(port->mtx, portMAX_DELAY);
+  }
+  (void)xSemaphoreGive(port->rd_mtx);
+}
+
+static void fr_read_unlock(void *ctx)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  (void)xSemaphoreTake(port->rd_mtx, portMAX_DELAY);
+  if (--port->readers == 0u) {
+    (void)xSemaphoreGive(port->mtx);
+  }
+  (void)xSemaphoreGive(port->rd_mtx);
+}
+#endif
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+static void fr_fanout_worker(void *arg)
+{
+  evt_bus_fr_worker_t *w = (evt_bus_fr_worker_t *)arg;
+
+  for (;;) {
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const evt_fanout_job_t *job = w->job;
+    if (job == NULL) continue;
+    w->job = NULL;
+    evt_bus_fanout_job_run(job);
+    (void)xTaskNotifyGive(w->owner);
+  }
+}
+
+static bool fr_fanout_start(void *ctx, unsigned worker, const evt_fanout_job_t *job)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  if (worker >= EVT_BUS_FANOUT_WORKERS) return false;
+
+  evt_bus_fr_worker_t *w = &port->workers[worker];
+  if (w->task == NULL) return false;
+  w->owner = xTaskGetCurrentTaskHandle();
+  w->job = job;
+  port->fanout_started++;
+  (void)xTaskNotifyGive(w->task);
+  return true;
+}
+
+/* Each finished job adds one to the dispatcher's notification count */
+static void fr_fanout_join(void *ctx)
+{
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+  while (port->fanout_started > 0) {
+    (void)ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    port->fanout_started--;
+  }
 }
 
+static bool fr_fanout_create(evt_bus_freertos_t *port)
+{
+  for (size_t i = 0; i < EVT_BUS_FANOUT_WORKERS; i++) {
+    evt_bus_fr_worker_t *w = &port->workers[i];
+#if EVT_BUS_FREERTOS_STATIC
+    w->task = xTaskCreateStatic(fr_fanout_worker, "evt_bus_fan",
+                                EVT_BUS_FREERTOS_FANOUT_STACK_WORDS, w, port->cfg.task_prio,
+                                w->stack, &w->task_buf);
+#else
+    if (xTaskCreate(fr_fanout_worker, "evt_bus_fan", (uint16_t)EVT_BUS_FREERTOS_FANOUT_STACK_WORDS,
+                    w, port->cfg.task_prio, &w->task) != pdPASS) {
+      w->task = NULL;
+    }
+#endif
+    if (w->task == NULL) return false;
+  }
+  return true;
+}
+#endif
+
 /**
- * @brief Initialize FreeRTOS backend + create dispatcher task.
- * Returns false on queue/task creation failure.
- *
- * @return true 
- * @return false 
+ * @brief Backend init: create queue + mutex + dispatcher task for one port instance.
+ * Called by evt_bus_inst_init(). Returns false on queue/task creation failure.
  */
-bool evt_bus_freertos_init(void)
+static bool fr_init(void *ctx)
 {
-  /* Create queue before wiring backend */
-  s_ctx.q = xQueueCreate((UBaseType_t)EVT_BUS_FREERTOS_QUEUE_DEPTH, (UBaseType_t)sizeof(evt_t));
-  if (s_ctx.q == NULL) return false;
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)ctx;
+
+  /* Port-owned default instance serves the default bus */
+  if (port->bus == NULL) port->bus = evt_bus_default();
+
+  if (port->cfg.task_name   == NULL) port->cfg.task_name   = EVT_BUS_FREERTOS_TASK_NAME;
+  if (port->cfg.task_prio   == 0)    port->cfg.task_prio   = (UBaseType_t)EVT_BUS_FREERTOS_TASK_PRIO;
+  if (port->cfg.stack_words == 0)    port->cfg.stack_words = (uint32_t)EVT_BUS_FREERTOS_STACK_WORDS;
+  if (port->cfg.queue_depth == 0)    port->cfg.queue_depth = (UBaseType_t)EVT_BUS_FREERTOS_QUEUE_DEPTH;
 
-  s_mtx = xSemaphoreCreateMutexStatic(&s_mtx_buf);
-  if (s_mtx == NULL) return false;
+#if EVT_BUS_FREERTOS_STATIC
+  /* Embedded storage bounds the runtime config */
+  if (port->cfg.queue_depth > (UBaseType_t)EVT_BUS_FREERTOS_QUEUE_DEPTH) return false;
+  if (port->cfg.stack_words > (uint32_t)EVT_BUS_FREERTOS_STACK_WORDS)    return false;
 
-  /* Wire backend */
-  evt_bus_backend.ctx = &s_ctx;
-  evt_bus_backend.enqueue = fr_enqueue;
-  evt_bus_backend.dequeue_block = fr_dequeue_block;
-  evt_bus_backend.enqueue_isr = fr_enqueue_isr;
+  port->q = xQueueCreateStatic(port->cfg.queue_depth, (UBaseType_t)sizeof(evt_t),
+                               port->q_storage, &port->q_buf);
+#else
+  port->q = xQueueCreate(port->cfg.queue_depth, (UBaseType_t)sizeof(evt_t));
+#endif
+  if (port->q == NULL) return false;
 
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_SPIN
+#if defined(portMUX_INITIALIZER_UNLOCKED)
+  portMUX_INITIALIZE(&port->spin);
+#endif
+#elif EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_RW
+  port->mtx = xSemaphoreCreateBinaryStatic(&port->mtx_buf);
+  port->rd_mtx = xSemaphoreCreateMutexStatic(&port->rd_mtx_buf);
+  if (port->mtx == NULL || port->rd_mtx == NULL) return false;
+  (void)xSemaphoreGive(port->mtx);   /* binary semaphores start empty */
+  port->readers = 0;
+#else
+  port->mtx = xSemaphoreCreateMutexStatic(&port->mtx_buf);
+  if (port->mtx == NULL) return false;
+#endif
 
-  evt_bus_backend.lock = fr_lock;
-  evt_bus_backend.unlock = fr_unlock;
+#if EVT_BUS_FANOUT_WORKERS > 0
+  /* Workers first: the dispatcher may hand out jobs as soon as it runs */
+  if (!fr_fanout_create(port)) return false;
+#endif
 
   /* Create dispatcher task */
+#if EVT_BUS_FREERTOS_STATIC
+  TaskHandle_t task = xTaskCreateStatic(
+      evt_bus_dispatcher_task,
+      port->cfg.task_name,
+      port->cfg.stack_words,
+      port,
+      port->cfg.task_prio,
+      port->stack,
+      &port->task_buf);
+
+  return (task != NULL);
+#else
   BaseType_t ok = xTaskCreate(
       evt_bus_dispatcher_task,
-      EVT_BUS_FREERTOS_TASK_NAME,
-      (uint16_t)EVT_BUS_FREERTOS_STACK_WORDS,
-      NULL,
-      (UBaseType_t)EVT_BUS_FREERTOS_TASK_PRIO,
+      port->cfg.task_name,
+      (uint16_t)port->cfg.stack_words,
+      port,
+      port->cfg.task_prio,
       NULL);
 
   return (ok == pdPASS);
+#endif
 }
 
 
@@ -159,7 +404,7 @@ bool evt_bus_freertos_init(void)
 
 static void evt_bus_dispatcher_task(void *arg)
 {
-  (void)arg;
+  evt_bus_freertos_t *port = (evt_bus_freertos_t *)arg;
 
   evt_t evt;
 
@@ -169,18 +414,30 @@ static void evt_bus_dispatcher_task(void *arg)
   for (;;)
   {
     /* Wake periodically to tick heartbeat even when idle */
-    if (xQueueReceive(s_ctx.q, &evt, to) == pdPASS) {
-      evt_bus_dispatch_evt(&evt);
-      fr_heartbeat_on_dispatch();
+    if (xQueueReceive(port->q, &evt, to) == pdPASS) {
+      evt_bus_inst_dispatch_evt(port->bus, &evt);
+      fr_heartbeat_on_dispatch(port);
+    } else {
+      /* Idle: close expired batch windows */
+      evt_bus_inst_batch_poll(port->bus);
     }
-    fr_heartbeat_tick();
+    fr_heartbeat_tick(port);
   }
 #else
   for (;;)
   {
-    /* Pure blocking, no periodic wakeups */
-    if (xQueueReceive(s_ctx.q, &evt, portMAX_DELAY) == pdPASS) {
-      evt_bus_dispatch_evt(&evt);
+    /* No periodic wakeups: block until work, or until an open batch window expires */
+    const uint32_t due_us = evt_bus_inst_batch_next_due_us(port->bus);
+    TickType_t to = portMAX_DELAY;
+    if (due_us != UINT32_MAX) {
+      /* Round up: waking a tick early would find the window still open */
+      const uint64_t ticks = ((uint64_t)due_us * configTICK_RATE_HZ + 999999u) / 1000000u;
+      to = (ticks < (uint64_t)portMAX_DELAY) ? (TickType_t)ticks : portMAX_DELAY - 1u;
+    }
+    if (xQueueReceive(port->q, &evt, to) == pdPASS) {
+      evt_bus_inst_dispatch_evt(port->bus, &evt);
+    } else {
+      evt_bus_inst_batch_poll(port->bus);
     }
   }
 #endif
@@ -188,6 +445,21 @@ static void evt_bus_dispatcher_task(void *arg)
 
 /* -------- Public port API -------- */
 
-TickType_t evt_bus_freertos_hb_last_tick(void)      { return s_hb.last_beat; }
-uint32_t   evt_bus_freertos_hb_beat_count(void)     { return s_hb.beat_count; }
-uint32_t   evt_bus_freertos_hb_events_dispatched(void){ return s_hb.events_dispatched; }
+bool evt_bus_freertos_inst_init(evt_bus_freertos_t *port, evt_bus_t *bus,
+                                const evt_bus_freertos_cfg_t *cfg)
+{
+  if (port == NULL || bus == NULL) return false;
+
+  memset(port, 0, sizeof(*port));
+  port->backend = (evt_bus_backend_t)FR_BACKEND_INIT(port);
+  port->bus = bus;
+  if (cfg != NULL) port->cfg = *cfg;
+
+  return evt_bus_inst_init(bus, &port->backend);
+}
+
+const evt_bus_fr_hb_t *evt_bus_freertos_inst_hb(const evt_bus_freertos_t *port) { return &port->hb; }
+
+TickType_t evt_bus_freertos_hb_last_tick(void)      { return s_port.hb.last_beat; }
+uint32_t   evt_bus_freertos_hb_beat_count(void)     { return s_port.hb.beat_count; }
+uint32_t   evt_bus_freertos_hb_events_dispatched(void){ return s_port.hb.events_dispatched; }
@@ -4,29 +4,128 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus_port_freertos_config.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Per-instance port configuration (0/NULL fields take the EVT_BUS_FREERTOS_* defaults) */
+typedef struct {
+  const char  *task_name;
+  UBaseType_t  task_prio;
+  uint32_t     stack_words;
+  UBaseType_t  queue_depth;
+} evt_bus_freertos_cfg_t;
+
+/* Dispatcher heartbeat / progress counters */
+typedef struct {
+  volatile TickType_t last_beat;
+  volatile uint32_t   beat_count;
+  volatile uint32_t   events_dispatched;
+} evt_bus_fr_hb_t;
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+/* Fan-out worker: a task at the dispatcher's priority that runs one share of a parallel
+ * fan-out per notification and notifies the dispatcher back */
+typedef struct {
+  TaskHandle_t                     task;
+  TaskHandle_t                     owner;   /* dispatcher to notify when done */
+  const evt_fanout_job_t *volatile job;
+#if EVT_BUS_FREERTOS_STATIC
+  StaticTask_t                     task_buf;
+  StackType_t                      stack[EVT_BUS_FREERTOS_FANOUT_STACK_WORDS];
+#endif
+} evt_bus_fr_worker_t;
+#endif
+
+/* Port instance: backend + RTOS objects + dispatcher for one evt_bus_t.
+ * Fields are private to the port; allocate statically and use the API below. */
+typedef struct {
+  evt_bus_backend_t       backend;
+  evt_bus_t              *bus;
+  evt_bus_freertos_cfg_t  cfg;
+
+  QueueHandle_t           q;
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_SPIN
+#if defined(portMUX_INITIALIZER_UNLOCKED)
+  portMUX_TYPE            spin;
+#endif
+#else
+  StaticSemaphore_t       mtx_buf;
+  SemaphoreHandle_t       mtx;          /* RW: binary semaphore held by writers / readers */
+#endif
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_RW
+  StaticSemaphore_t       rd_mtx_buf;
+  SemaphoreHandle_t       rd_mtx;       /* guards readers */
+  UBaseType_t             readers;
+#endif
+
+#if EVT_BUS_FREERTOS_STATIC
+  /* Queue + dispatcher storage: bring-up never touches the FreeRTOS heap */
+  StaticQueue_t           q_buf;
+  uint8_t                 q_storage[EVT_BUS_FREERTOS_QUEUE_DEPTH * sizeof(evt_t)];
+  StaticTask_t            task_buf;
+  StackType_t             stack[EVT_BUS_FREERTOS_STACK_WORDS];
+#endif
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+  evt_bus_fr_worker_t     workers[EVT_BUS_FANOUT_WORKERS];
+  UBaseType_t             fanout_started;   /* dispatcher only */
+#endif
+
+  evt_bus_fr_hb_t         hb;
+} evt_bus_freertos_t;
+
+/**
+ * @brief Initialize @p bus with its own FreeRTOS queue, mutex and dispatcher task.
+ *
+ * Use one port instance per bus (e.g. a high-priority control bus and a low-priority
+ * sensor bus). The default bus (evt_bus_init) is served by a port-owned instance.
+ *
+ * The backend clock (now_us) is the tick count converted with configTICK_RATE_HZ, so
+ * it has one-tick resolution (1000 us at 1 kHz). Rate limits, watchdog budgets, batch,
+ * dedup and throttle intervals below one tick behave as multiples of a tick.
+ *
+ * @param port Port storage (typically static); must outlive the bus.
+ * @param bus  Bus instance storage.
+ * @param cfg  Queue/task settings, or NULL for the EVT_BUS_FREERTOS_* defaults.
+ *             With EVT_BUS_FREERTOS_STATIC, queue_depth / stack_words may not exceed
+ *             EVT_BUS_FREERTOS_QUEUE_DEPTH / EVT_BUS_FREERTOS_STACK_WORDS.
+ *
+ * @return false on queue/task creation failure or an oversized static config.
+ */
+bool evt_bus_freertos_inst_init(evt_bus_freertos_t *port, evt_bus_t *bus,
+                                const evt_bus_freertos_cfg_t *cfg);
+
+/**
+ * @brief Heartbeat / progress counters of a port instance.
+ */
+const evt_bus_fr_hb_t *evt_bus_freertos_inst_hb(const evt_bus_freertos_t *port);
+
 /**
  * @brief Returns the tick count of the last heartbeat beat.
- * 
- * @return TickType_t 
+ *
+ * @return TickType_t
  */
 TickType_t evt_bus_freertos_hb_last_tick(void);
 
 /**
  * @brief Returns the number of heartbeat beats since start.
- * 
- * @return uint32_t 
+ *
+ * @return uint32_t
  */
 uint32_t   evt_bus_freertos_hb_beat_count(void);
 
 /**
  * @brief Returns the number of events dispatched since start.
- * 
- * @return uint32_t 
+ *
+ * @return uint32_t
  */
 uint32_t   evt_bus_freertos_hb_events_dispatched(void);
 
@@ -34,4 +133,4 @@ uint32_t   evt_bus_freertos_hb_events_dispatched(void);
 }
 #endif
 
-#endif /* PORTS_FREERTOS_EVT_BUS_PORT_FREERTOS_H_ */
\ No newline at end of file
+#endif /* PORTS_FREERTOS_EVT_BUS_PORT_FREERTOS_H_ */
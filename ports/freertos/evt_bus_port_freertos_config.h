@@ -3,6 +3,8 @@
 
 #include "freertos/FreeRTOS.h"
 
+#include "evt_bus/evt_bus_config.h"
+
 #if defined(ESP_PLATFORM)
 #include "sdkconfig.h"
 /* Override default FreeRTOS configuration */
@@ -11,6 +13,14 @@
 #define EVT_BUS_FREERTOS_STACK_WORDS CONFIG_EVT_BUS_PORT_STACK_WORDS
 #define EVT_BUS_FREERTOS_QUEUE_DEPTH CONFIG_EVT_BUS_PORT_QUEUE_DEPTH
 #define EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS CONFIG_EVT_BUS_PORT_HEARTBEAT_TICK_MS
+#if defined(CONFIG_EVT_BUS_PORT_STATIC_ALLOC)
+#define EVT_BUS_FREERTOS_STATIC 1
+#endif
+#if defined(CONFIG_EVT_BUS_PORT_LOCK_SPIN)
+#define EVT_BUS_FREERTOS_LOCK 1
+#elif defined(CONFIG_EVT_BUS_PORT_LOCK_RW)
+#define EVT_BUS_FREERTOS_LOCK 2
+#endif
 #endif
 
 /* FreeRTOS-specific configuration for the Event Bus port */
@@ -30,9 +40,54 @@
 #define EVT_BUS_FREERTOS_STACK_WORDS (4096 + 128)
 #endif
 
-/* Heartbeat tick rate in milliseconds */
+/* Depth of the dispatcher queue (and the embedded storage size with EVT_BUS_FREERTOS_STATIC) */
+#ifndef EVT_BUS_FREERTOS_QUEUE_DEPTH
+#define EVT_BUS_FREERTOS_QUEUE_DEPTH 16u
+#endif
+
+/* 1: create the queue and dispatcher task from storage embedded in evt_bus_freertos_t
+ * (xQueueCreateStatic / xTaskCreateStatic, requires configSUPPORT_STATIC_ALLOCATION) */
+#ifndef EVT_BUS_FREERTOS_STATIC
+#define EVT_BUS_FREERTOS_STATIC 0
+#endif
+
+/* Task notification index used to wake evt_bus_wait_for() waiters. Index 0 is shared
+ * with plain xTaskNotifyGive(); pick a free index (configTASK_NOTIFICATION_ARRAY_ENTRIES
+ * > 1) if waiting tasks use notifications themselves. */
+#ifndef EVT_BUS_FREERTOS_NOTIFY_INDEX
+#define EVT_BUS_FREERTOS_NOTIFY_INDEX 0
+#endif
+
+/* Bus lock (subscribe/unsubscribe vs dispatch snapshot; sections are a few microseconds):
+ *   MUTEX - blocking mutex with priority inheritance; safe default.
+ *   SPIN  - critical section: taskENTER_CRITICAL(&mux) spinlock on SMP ports that define
+ *           portMUX_INITIALIZER_UNLOCKED (ESP-IDF), interrupt masking on single-core ports.
+ *           No blocking and no RTOS objects; held sections also mask interrupts.
+ *   RW    - reader-writer lock: the dispatch snapshot and read-only queries share it,
+ *           subscribe/unsubscribe take it exclusively (readers are preferred). */
+#define EVT_BUS_FREERTOS_LOCK_MUTEX 0
+#define EVT_BUS_FREERTOS_LOCK_SPIN  1
+#define EVT_BUS_FREERTOS_LOCK_RW    2
+
+#ifndef EVT_BUS_FREERTOS_LOCK
+#define EVT_BUS_FREERTOS_LOCK EVT_BUS_FREERTOS_LOCK_MUTEX
+#endif
+
+/* Stack (in words) of each fan-out worker task (EVT_BUS_FANOUT_WORKERS > 0). Workers
+ * run subscriber callbacks, so size them like the dispatcher. */
+#ifndef EVT_BUS_FREERTOS_FANOUT_STACK_WORDS
+#define EVT_BUS_FREERTOS_FANOUT_STACK_WORDS EVT_BUS_FREERTOS_STACK_WORDS
+#endif
+
+/* Heartbeat tick rate in milliseconds; 0 blocks the idle dispatcher without periodic
+ * wakeups (it still wakes when an open batch window expires). EVT_BUS_LIVENESS pings
+ * need no heartbeat, so it defaults to 0 there. */
 #ifndef EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS
+#if EVT_BUS_LIVENESS
+#define EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS 0
+#else
 #define EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS 1000
 #endif
+#endif
 
 #endif /* PORTS_FREERTOS_EVT_BUS_PORT_FREERTOS_CONFIG_H_ */
\ No newline at end of file
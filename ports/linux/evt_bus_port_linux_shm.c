@@ -0,0 +1,532 @@
+#define _GNU_SOURCE
+
+#include "evt_bus_port_linux_shm.h"
+#include "evt_bus_port_linux_shm_config.h"
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus/evt_bus_config.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SHM_MAGIC   0x53554245u   /* "EBUS" */
+#define SHM_VERSION 1u
+
+#define LOAD(p, mo)           __atomic_load_n((p), (mo))
+#define STORE(p, v, mo)       __atomic_store_n((p), (v), (mo))
+#define CAS(p, exp, des)      __atomic_compare_exchange_n((p), (exp), (des), false, \
+                                                          __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+enum { READER_FREE = 0, READER_JOINING = 1, READER_ACTIVE = 2 };
+
+/* -------- Shared segment layout -------- */
+
+typedef struct {
+  uint32_t state;
+  uint32_t pid;
+  uint32_t cursor;     /* next sequence this reader consumes */
+} shm_reader_t;
+
+typedef struct {
+  uint32_t seq;        /* s + 1 once event s is committed */
+  evt_t    evt;
+} shm_slot_t;
+
+struct evt_bus_shm_region {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t capacity;
+  uint32_t evt_size;
+  uint32_t max_readers;
+
+  /* Producer side: next sequence to claim */
+  _Alignas(64) uint32_t claim;
+
+  /* Wakeup words: bumped on every commit / consume, futex-waited by the other side */
+  _Alignas(64) uint32_t data_futex;
+  uint32_t data_waiters;
+  uint32_t space_futex;
+  uint32_t space_waiters;
+
+  _Alignas(64) shm_reader_t readers[EVT_BUS_SHM_MAX_READERS];
+
+  _Alignas(64) shm_slot_t slots[];
+};
+
+static size_t region_size(uint32_t capacity)
+{
+  return sizeof(struct evt_bus_shm_region) + (size_t)capacity * sizeof(shm_slot_t);
+}
+
+/* Function prototypes */
+static bool shm_init(void *ctx);
+static bool shm_enqueue(void *ctx, const evt_t *evt);
+static bool shm_dequeue_nb(void *ctx, evt_t *evt_out);
+static bool shm_dequeue_block(void *ctx, evt_t *evt_out);
+static bool shm_enqueue_timeout(void *ctx, const evt_t *evt, uint32_t timeout_ms);
+static bool shm_drop_oldest(void *ctx, bool from_isr, evt_t *dropped);
+static size_t shm_free_slots(void *ctx, bool from_isr);
+static uint32_t shm_now_us(void *ctx);
+static void shm_lock(void *ctx);
+static void shm_unlock(void *ctx);
+#if EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_RW
+static void shm_read_lock(void *ctx);
+#define SHM_READ_LOCK   shm_read_lock
+#define SHM_READ_UNLOCK shm_unlock
+#else
+#define SHM_READ_LOCK   NULL
+#define SHM_READ_UNLOCK NULL
+#endif
+
+#define SHM_BACKEND_INIT(port_ptr) {          \
+  .ctx             = (port_ptr),              \
+  .enqueue         = shm_enqueue,             \
+  .dequeue_nb      = shm_dequeue_nb,          \
+  .dequeue_block   = shm_dequeue_block,       \
+  .enqueue_isr     = NULL,                    \
+  .enqueue_timeout = shm_enqueue_timeout,     \
+  .drop_oldest     = shm_drop_oldest,         \
+  .free_slots      = shm_free_slots,          \
+  .now_us          = shm_now_us,              \
+  .lock            = shm_lock,                \
+  .unlock          = shm_unlock,              \
+  .read_lock       = SHM_READ_LOCK,           \
+  .read_unlock     = SHM_READ_UNLOCK,         \
+  .init            = shm_init,                \
+  .remote_dispatch = true,                    \
+}
+
+/* -------- Futex helpers (shared, not FUTEX_PRIVATE: waiters live in other processes) -------- */
+
+static void shm_signal(uint32_t *word, uint32_t *waiters)
+{
+  __atomic_add_fetch(word, 1u, __ATOMIC_SEQ_CST);
+  if (LOAD(waiters, __ATOMIC_SEQ_CST) != 0u) {
+    (void)syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+  }
+}
+
+/* Sleep until *word moves away from @p seen (or timeout). Caller re-checks its condition. */
+static void shm_wait(uint32_t *word, uint32_t *waiters, uint32_t seen, uint32_t timeout_ms)
+{
+  struct timespec ts = {
+    .tv_sec  = (time_t)(timeout_ms / 1000u),
+    .tv_nsec = (long)(timeout_ms % 1000u) * 1000000L,
+  };
+
+  __atomic_add_fetch(waiters, 1u, __ATOMIC_SEQ_CST);
+  (void)syscall(SYS_futex, word, FUTEX_WAIT, seen, &ts, NULL, 0);
+  __atomic_sub_fetch(waiters, 1u, __ATOMIC_SEQ_CST);
+}
+
+static uint64_t mono_ms(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+/* Publisher tokens and request correlation IDs are process-local: never carry one
+ * across the segment */
+static inline void strip_process_local(evt_t *evt)
+{
+#if EVT_BUS_MAX_PUBLISHERS > 0
+  evt->pub = EVT_PUB_ID_NONE;
+#endif
+#if EVT_BUS_MAX_REQUESTS > 0
+  evt->corr = EVT_CORR_NONE;
+#endif
+  (void)evt;
+}
+
+/* -------- Ring -------- */
+
+/* Oldest sequence still needed by an active reader (== claim when there are none) */
+static uint32_t min_cursor(struct evt_bus_shm_region *r, uint32_t claim)
+{
+  uint32_t lag = 0;
+
+  for (uint32_t i = 0; i < EVT_BUS_SHM_MAX_READERS; i++) {
+    if (LOAD(&r->readers[i].state, __ATOMIC_ACQUIRE) != READER_ACTIVE) continue;
+
+    uint32_t d = claim - LOAD(&r->readers[i].cursor, __ATOMIC_ACQUIRE);
+    /* Cursor ahead of a stale claim snapshot: reader needs nothing older */
+    if ((int32_t)d > 0 && d > lag) lag = d;
+  }
+  return claim - lag;
+}
+
+static bool shm_enqueue(void *ctx, const evt_t *evt)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL) return false;
+
+  uint32_t c = LOAD(&r->claim, __ATOMIC_ACQUIRE);
+  do {
+    if (c - min_cursor(r, c) >= r->capacity) return false;
+  } while (!CAS(&r->claim, &c, c + 1u));
+
+  /* Slot is exclusively ours until seq is published */
+  shm_slot_t *s = &r->slots[c & (r->capacity - 1u)];
+  s->evt = *evt;
+  strip_process_local(&s->evt);
+  STORE(&s->seq, c + 1u, __ATOMIC_RELEASE);
+
+  shm_signal(&r->data_futex, &r->data_waiters);
+  return true;
+}
+
+static bool shm_enqueue_timeout(void *ctx, const evt_t *evt, uint32_t timeout_ms)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL) return false;
+
+  const uint64_t deadline = mono_ms() + timeout_ms;
+
+  for (;;) {
+    uint32_t seen = LOAD(&r->space_futex, __ATOMIC_SEQ_CST);
+    if (shm_enqueue(ctx, evt)) return true;
+
+    uint64_t now = mono_ms();
+    if (now >= deadline) return false;
+    shm_wait(&r->space_futex, &r->space_waiters, seen, (uint32_t)(deadline - now));
+  }
+}
+
+static bool shm_dequeue_nb(void *ctx, evt_t *evt_out)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL || port->reader_idx < 0) return false;
+
+  shm_reader_t *rd = &r->readers[port->reader_idx];
+  uint32_t cur = LOAD(&rd->cursor, __ATOMIC_ACQUIRE);
+
+  for (;;) {
+    shm_slot_t *s = &r->slots[cur & (r->capacity - 1u)];
+    if (LOAD(&s->seq, __ATOMIC_ACQUIRE) != cur + 1u) return false;
+
+    *evt_out = s->evt;
+    /* Fails only if a DROP_OLDEST producer skipped this event: retry from the new cursor */
+    if (CAS(&rd->cursor, &cur, cur + 1u)) break;
+  }
+
+  strip_process_local(evt_out);
+  shm_signal(&r->space_futex, &r->space_waiters);
+  return true;
+}
+
+static bool shm_dequeue_block(void *ctx, evt_t *evt_out)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL || port->reader_idx < 0) return false;
+
+  for (;;) {
+    uint32_t seen = LOAD(&r->data_futex, __ATOMIC_SEQ_CST);
+    if (shm_dequeue_nb(ctx, evt_out)) return true;
+    shm_wait(&r->data_futex, &r->data_waiters, seen, EVT_BUS_SHM_WAKE_MS);
+  }
+}
+
+static bool shm_drop_oldest(void *ctx, bool from_isr, evt_t *dropped)
+{
+  (void)from_isr;
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL) return false;
+
+  uint32_t c = LOAD(&r->claim, __ATOMIC_ACQUIRE);
+  uint32_t m = min_cursor(r, c);
+  if (m == c) return false;
+
+  shm_slot_t *s = &r->slots[m & (r->capacity - 1u)];
+  if (LOAD(&s->seq, __ATOMIC_ACQUIRE) != m + 1u) return false;   /* still being written */
+  *dropped = s->evt;
+
+  /* Move every reader still parked on the oldest event past it */
+  bool moved = false;
+  for (uint32_t i = 0; i < EVT_BUS_SHM_MAX_READERS; i++) {
+    if (LOAD(&r->readers[i].state, __ATOMIC_ACQUIRE) != READER_ACTIVE) continue;
+    uint32_t expect = m;
+    moved |= CAS(&r->readers[i].cursor, &expect, m + 1u);
+  }
+  return moved;
+}
+
+static size_t shm_free_slots(void *ctx, bool from_isr)
+{
+  (void)from_isr;
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL) return 0;
+
+  uint32_t c = LOAD(&r->claim, __ATOMIC_ACQUIRE);
+  uint32_t used = c - min_cursor(r, c);
+  return (used >= r->capacity) ? 0u : (size_t)(r->capacity - used);
+}
+
+static uint32_t shm_now_us(void *ctx)
+{
+  (void)ctx;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+#if EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_SPIN
+static void shm_lock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_spin_lock(&port->mtx);
+}
+
+static void shm_unlock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_spin_unlock(&port->mtx);
+}
+#elif EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_RW
+static void shm_lock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_rwlock_wrlock(&port->mtx);
+}
+
+static void shm_read_lock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_rwlock_rdlock(&port->mtx);
+}
+
+/* pthread_rwlock_unlock releases either side */
+static void shm_unlock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_rwlock_unlock(&port->mtx);
+}
+#else
+static void shm_lock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_mutex_lock(&port->mtx);
+}
+
+static void shm_unlock(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  (void)pthread_mutex_unlock(&port->mtx);
+}
+#endif
+
+/* -------- Segment setup -------- */
+
+static bool reader_join(evt_bus_linux_shm_t *port)
+{
+  struct evt_bus_shm_region *r = port->region;
+
+  for (uint32_t i = 0; i < EVT_BUS_SHM_MAX_READERS; i++) {
+    uint32_t expect = READER_FREE;
+    if (!CAS(&r->readers[i].state, &expect, READER_JOINING)) continue;
+
+    shm_reader_t *rd = &r->readers[i];
+    STORE(&rd->pid, (uint32_t)getpid(), __ATOMIC_RELAXED);
+    STORE(&rd->cursor, LOAD(&r->claim, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    STORE(&rd->state, READER_ACTIVE, __ATOMIC_SEQ_CST);
+
+    /* Producers that sampled the readers before we went active may have lapped the
+     * first cursor: restart from the current claim. Producers see us from now on. */
+    STORE(&rd->cursor, LOAD(&r->claim, __ATOMIC_SEQ_CST), __ATOMIC_RELEASE);
+
+    port->reader_idx = (int)i;
+    return true;
+  }
+  return false;
+}
+
+static bool region_valid(const struct evt_bus_shm_region *r, size_t map_len)
+{
+  return LOAD(&r->magic, __ATOMIC_ACQUIRE) == SHM_MAGIC &&
+         r->version == SHM_VERSION &&
+         r->evt_size == (uint32_t)sizeof(evt_t) &&
+         r->max_readers == EVT_BUS_SHM_MAX_READERS &&
+         r->capacity != 0u && (r->capacity & (r->capacity - 1u)) == 0u &&
+         map_len >= region_size(r->capacity);
+}
+
+/**
+ * @brief Backend init: create/attach the segment and take a reader cursor if requested.
+ * Called by evt_bus_inst_init().
+ */
+static bool shm_init(void *ctx)
+{
+  evt_bus_linux_shm_t *port = (evt_bus_linux_shm_t *)ctx;
+  const evt_bus_linux_shm_cfg_t *cfg = &port->cfg;
+
+  if (cfg->name == NULL) return false;
+
+  uint32_t cap = (cfg->capacity != 0u) ? cfg->capacity : EVT_BUS_SHM_CAPACITY;
+  if (cfg->create && (cap & (cap - 1u)) != 0u) return false;
+
+  int fd;
+  size_t len;
+  if (cfg->create) {
+    /* Drop a stale segment left behind by a crashed creator */
+    (void)shm_unlink(cfg->name);
+    fd = shm_open(cfg->name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+
+    len = region_size(cap);
+    if (ftruncate(fd, (off_t)len) != 0) {
+      close(fd);
+      (void)shm_unlink(cfg->name);
+      return false;
+    }
+  } else {
+    fd = shm_open(cfg->name, O_RDWR, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(struct evt_bus_shm_region)) {
+      close(fd);
+      return false;
+    }
+    len = (size_t)st.st_size;
+  }
+
+  void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    if (cfg->create) (void)shm_unlink(cfg->name);
+    return false;
+  }
+
+  struct evt_bus_shm_region *r = (struct evt_bus_shm_region *)map;
+  if (cfg->create) {
+    /* ftruncate() zero-filled the segment: cursors, counters and slot seqs start at 0 */
+    r->version     = SHM_VERSION;
+    r->capacity    = cap;
+    r->evt_size    = (uint32_t)sizeof(evt_t);
+    r->max_readers = EVT_BUS_SHM_MAX_READERS;
+    STORE(&r->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+  } else if (!region_valid(r, len)) {
+    munmap(map, len);
+    return false;
+  }
+
+  port->region  = r;
+  port->map_len = len;
+#if EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_SPIN
+  (void)pthread_spin_init(&port->mtx, PTHREAD_PROCESS_PRIVATE);
+#elif EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_RW
+  (void)pthread_rwlock_init(&port->mtx, NULL);
+#else
+  (void)pthread_mutex_init(&port->mtx, NULL);
+#endif
+
+  if (cfg->reader && !reader_join(port)) {
+    evt_bus_linux_shm_close(port);
+    return false;
+  }
+  return true;
+}
+
+/* -------- Public port API -------- */
+
+bool evt_bus_linux_shm_inst_init(evt_bus_linux_shm_t *port, evt_bus_t *bus,
+                                 const evt_bus_linux_shm_cfg_t *cfg)
+{
+  if (port == NULL || bus == NULL || cfg == NULL) return false;
+
+  memset(port, 0, sizeof(*port));
+  port->backend    = (evt_bus_backend_t)SHM_BACKEND_INIT(port);
+  port->bus        = bus;
+  port->cfg        = *cfg;
+  port->reader_idx = -1;
+
+  return evt_bus_inst_init(bus, &port->backend);
+}
+
+size_t evt_bus_linux_shm_dispatch(evt_bus_linux_shm_t *port, uint32_t timeout_ms)
+{
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL || port->reader_idx < 0) return 0;
+
+  evt_t evt;
+  const uint64_t deadline = mono_ms() + timeout_ms;
+
+  for (;;) {
+    uint32_t seen = LOAD(&r->data_futex, __ATOMIC_SEQ_CST);
+    if (shm_dequeue_nb(port, &evt)) break;
+
+    uint64_t now = mono_ms();
+    if (now >= deadline) {
+      /* Idle: close expired batch windows */
+      evt_bus_inst_batch_poll(port->bus);
+      return 0;
+    }
+    shm_wait(&r->data_futex, &r->data_waiters, seen, (uint32_t)(deadline - now));
+  }
+
+  size_t n = 0;
+  do {
+    evt_bus_inst_dispatch_evt(port->bus, &evt);
+    n++;
+  } while (n < r->capacity && shm_dequeue_nb(port, &evt));
+
+  return n;
+}
+
+uint32_t evt_bus_linux_shm_reap(evt_bus_linux_shm_t *port)
+{
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL) return 0;
+
+  uint32_t reaped = 0;
+  for (uint32_t i = 0; i < EVT_BUS_SHM_MAX_READERS; i++) {
+    if (LOAD(&r->readers[i].state, __ATOMIC_ACQUIRE) != READER_ACTIVE) continue;
+
+    pid_t pid = (pid_t)LOAD(&r->readers[i].pid, __ATOMIC_RELAXED);
+    if (kill(pid, 0) == 0 || errno != ESRCH) continue;
+
+    uint32_t expect = READER_ACTIVE;
+    if (CAS(&r->readers[i].state, &expect, READER_FREE)) {
+      reaped++;
+    }
+  }
+
+  if (reaped > 0) {
+    shm_signal(&r->space_futex, &r->space_waiters);
+  }
+  return reaped;
+}
+
+void evt_bus_linux_shm_close(evt_bus_linux_shm_t *port)
+{
+  struct evt_bus_shm_region *r = port->region;
+  if (r == NULL) return;
+
+  if (port->reader_idx >= 0) {
+    STORE(&r->readers[port->reader_idx].state, READER_FREE, __ATOMIC_RELEASE);
+    shm_signal(&r->space_futex, &r->space_waiters);
+    port->reader_idx = -1;
+  }
+
+  port->region = NULL;
+  munmap(r, port->map_len);
+
+  if (port->cfg.create) {
+    (void)shm_unlink(port->cfg.name);
+  }
+}
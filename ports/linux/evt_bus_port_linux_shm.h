@@ -0,0 +1,108 @@
+#ifndef PORTS_LINUX_EVT_BUS_PORT_LINUX_SHM_H_
+#define PORTS_LINUX_EVT_BUS_PORT_LINUX_SHM_H_
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus_port_linux_shm_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Cross-process transport: the event ring and its sequence counters live in a POSIX
+ * shared-memory segment mapped by every participating process.
+ *
+ * - Producers claim ring slots with a CAS on a shared sequence counter and copy the
+ *   envelope straight into the mapping (no syscall, no kernel copy per event).
+ * - Each reader process owns a cursor and receives every event (fanout). A slot is
+ *   reused only once all active readers have moved past it, so a full ring applies
+ *   the bus backpressure policies to producers.
+ * - Idle readers / blocked producers sleep on futexes; producers only enter the
+ *   kernel when somebody is actually waiting.
+ *
+ * Subscriptions, policies and locks stay process-local (one evt_bus_t per process).
+ * Publisher tokens are process-local too and are not carried across the segment.
+ */
+
+/* Per-instance transport configuration */
+typedef struct {
+  const char *name;      /* shm object name, e.g. "/evt_bus_gw" */
+  uint32_t    capacity;  /* ring slots when creating (power of two), 0 => EVT_BUS_SHM_CAPACITY */
+  bool        create;    /* true: (re)create the segment; false: attach to an existing one */
+  bool        reader;    /* true: take a reader cursor and receive every event */
+} evt_bus_linux_shm_cfg_t;
+
+struct evt_bus_shm_region;
+
+/* Port instance. Fields are private to the port; use the API below. */
+typedef struct {
+  evt_bus_backend_t           backend;
+  evt_bus_t                  *bus;
+  evt_bus_linux_shm_cfg_t     cfg;
+
+  struct evt_bus_shm_region  *region;
+  size_t                      map_len;
+  int                         reader_idx;   /* -1 when not a reader */
+#if EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_SPIN
+  pthread_spinlock_t          mtx;          /* process-local subscription tables */
+#elif EVT_BUS_SHM_LOCK == EVT_BUS_SHM_LOCK_RW
+  pthread_rwlock_t            mtx;
+#else
+  pthread_mutex_t             mtx;
+#endif
+} evt_bus_linux_shm_t;
+
+/**
+ * @brief Map (or create) the shared segment and initialize @p bus on top of it.
+ *
+ * Exactly one process creates the segment (cfg->create); the others attach. Attaching
+ * fails until the creator has finished initializing it, or if the segment was built
+ * with a different evt_t layout / EVT_BUS_SHM_MAX_READERS.
+ *
+ * @param port Port storage; must outlive the bus.
+ * @param bus  Bus instance storage (evt_bus_default() to drive the global API).
+ * @param cfg  Segment name and role.
+ *
+ * @return false on invalid config, mapping failure or no free reader cursor.
+ */
+bool evt_bus_linux_shm_inst_init(evt_bus_linux_shm_t *port, evt_bus_t *bus,
+                                 const evt_bus_linux_shm_cfg_t *cfg);
+
+/**
+ * @brief Dispatch pending events of a reader instance.
+ *
+ * Waits up to @p timeout_ms for the first event, then drains what is available
+ * (at most one ring's worth) through evt_bus_inst_dispatch_evt(). On timeout, delivers
+ * expired batch windows (evt_bus_inst_batch_poll()).
+ *
+ * @return Number of events dispatched.
+ */
+size_t evt_bus_linux_shm_dispatch(evt_bus_linux_shm_t *port, uint32_t timeout_ms);
+
+/**
+ * @brief Release dead readers' cursors.
+ *
+ * A reader process that exits without evt_bus_linux_shm_close() pins its cursor and
+ * eventually stalls producers. Call periodically from any process.
+ *
+ * @return Number of cursors released.
+ */
+uint32_t evt_bus_linux_shm_reap(evt_bus_linux_shm_t *port);
+
+/**
+ * @brief Leave the segment (reader cursor released, mapping removed).
+ *
+ * The creator also unlinks the segment name. The bus must not be used afterwards.
+ */
+void evt_bus_linux_shm_close(evt_bus_linux_shm_t *port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTS_LINUX_EVT_BUS_PORT_LINUX_SHM_H_ */
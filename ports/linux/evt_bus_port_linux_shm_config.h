@@ -0,0 +1,33 @@
+#ifndef PORTS_LINUX_EVT_BUS_PORT_LINUX_SHM_CONFIG_H_
+#define PORTS_LINUX_EVT_BUS_PORT_LINUX_SHM_CONFIG_H_
+
+/* Linux shared-memory transport configuration */
+
+/* Ring slots of a newly created segment (power of two) */
+#ifndef EVT_BUS_SHM_CAPACITY
+#define EVT_BUS_SHM_CAPACITY 256u
+#endif
+
+/* Reader cursors per segment (each reader process receives every event) */
+#ifndef EVT_BUS_SHM_MAX_READERS
+#define EVT_BUS_SHM_MAX_READERS 8u
+#endif
+
+/* Upper bound of a single futex sleep in dequeue_block (re-checks the ring afterwards) */
+#ifndef EVT_BUS_SHM_WAKE_MS
+#define EVT_BUS_SHM_WAKE_MS 1000u
+#endif
+
+/* Process-local bus lock: MUTEX (pthread mutex), SPIN (pthread spinlock, for few
+ * threads pinned to separate cores) or RW (pthread rwlock: the dispatch snapshot and
+ * read-only queries share it). SPIN and RW need the POSIX.1-2001 <pthread.h> types in
+ * every file including the port header (e.g. -D_POSIX_C_SOURCE=200809L with -std=c11). */
+#define EVT_BUS_SHM_LOCK_MUTEX 0
+#define EVT_BUS_SHM_LOCK_SPIN  1
+#define EVT_BUS_SHM_LOCK_RW    2
+
+#ifndef EVT_BUS_SHM_LOCK
+#define EVT_BUS_SHM_LOCK EVT_BUS_SHM_LOCK_MUTEX
+#endif
+
+#endif /* PORTS_LINUX_EVT_BUS_PORT_LINUX_SHM_CONFIG_H_ */
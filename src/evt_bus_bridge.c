@@ -0,0 +1,274 @@
+#include "evt_bus/evt_bus_bridge.h"
+#include "evt_bus/evt_bus_config.h"
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HDR_LEN 4u   /* sync + body_len; the body follows in tx_buf / rx_buf */
+
+enum {
+    RX_SYNC0 = 0,
+    RX_SYNC1,
+    RX_LEN0,
+    RX_LEN1,
+    RX_BODY,
+    RX_CRC0,
+    RX_CRC1,
+};
+
+/* Local helpers */
+
+static size_t put_varint(uint8_t *out, uint32_t v)
+{
+    size_t n = 0;
+    while (v >= 0x80u) {
+        out[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool get_varint(const uint8_t *in, size_t len, size_t *pos, uint32_t *v)
+{
+    uint32_t acc = 0;
+
+    for (unsigned shift = 0; shift < 35u && *pos < len; shift += 7u) {
+        const uint8_t b = in[(*pos)++];
+        acc |= (uint32_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            *v = acc;
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t varint_len(uint32_t v)
+{
+    size_t n = 1;
+    while (v >= 0x80u) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static inline uint32_t bus_now_us(const evt_bus_t *bus)
+{
+    const evt_bus_backend_t *be = bus->backend;
+    return (be->now_us != NULL) ? be->now_us(be->ctx) : 0u;
+}
+
+static inline bool forwards(const evt_bridge_t *br, uint32_t evt_id)
+{
+    return (br->tx_ids[evt_id / 8u] & (1u << (evt_id % 8u))) != 0;
+}
+
+uint16_t evt_bus_bridge_crc16(uint16_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8);
+        for (unsigned b = 0; b < 8u; b++) {
+            crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* -------- TX (dispatcher context) -------- */
+
+void evt_bus_bridge_flush(evt_bridge_t *br)
+{
+    if (br == NULL || br->tx_count == 0) {
+        return;
+    }
+
+    uint8_t *f = br->tx_buf;
+    f[0] = EVT_BRIDGE_SYNC0;
+    f[1] = EVT_BRIDGE_SYNC1;
+    f[2] = (uint8_t)(br->tx_len & 0xFFu);
+    f[3] = (uint8_t)(br->tx_len >> 8);
+
+    const uint16_t crc = evt_bus_bridge_crc16(0xFFFFu, &f[2], 2u + br->tx_len);
+    f[HDR_LEN + br->tx_len]      = (uint8_t)(crc & 0xFFu);
+    f[HDR_LEN + br->tx_len + 1u] = (uint8_t)(crc >> 8);
+
+    if (br->link.write(br->link.ctx, f, HDR_LEN + br->tx_len + 2u)) {
+        br->stats.tx_frames++;
+        br->stats.tx_records += br->tx_count;
+    } else {
+        br->stats.tx_dropped += br->tx_count;
+    }
+    br->tx_len = 0;
+    br->tx_count = 0;
+}
+
+static void bridge_tx_cb(const evt_t *evt, void *user_ctx)
+{
+    evt_bridge_t *br = (evt_bridge_t *)user_ctx;
+    const size_t rec_len = varint_len(evt->id) + varint_len(evt->len) + evt->len;
+
+    if (br->tx_len + rec_len > EVT_BRIDGE_MAX_BODY) {
+        evt_bus_bridge_flush(br);
+    }
+    if (br->tx_count == 0 && br->max_delay_us > 0) {
+        br->tx_first_us = bus_now_us(br->bus);
+    }
+
+    uint8_t *p = &br->tx_buf[HDR_LEN + br->tx_len];
+    size_t n = put_varint(p, evt->id);
+    n += put_varint(p + n, evt->len);
+    memcpy(p + n, evt->payload, evt->len);
+    br->tx_len += n + evt->len;
+    br->tx_count++;
+
+    if (br->max_records > 0 && br->tx_count >= br->max_records) {
+        evt_bus_bridge_flush(br);
+    } else if (br->max_delay_us > 0 &&
+               (uint32_t)(bus_now_us(br->bus) - br->tx_first_us) >= br->max_delay_us) {
+        evt_bus_bridge_flush(br);
+    }
+}
+
+bool evt_bus_bridge_start(evt_bridge_t *br, evt_bus_t *bus, const evt_bridge_link_t *link,
+                          const evt_bridge_cfg_t *cfg)
+{
+    if (br == NULL || bus == NULL || bus->backend == NULL || link == NULL ||
+        link->write == NULL || cfg == NULL || cfg->n_ids > EVT_BRIDGE_MAX_IDS ||
+        (cfg->ids == NULL && cfg->n_ids > 0)) {
+        return false;
+    }
+
+    memset(br, 0, sizeof(*br));
+    br->bus = bus;
+    br->link = *link;
+    br->max_records = cfg->max_records;
+    br->max_delay_us = cfg->max_delay_us;
+
+    evt_sub_req_t reqs[EVT_BRIDGE_MAX_IDS];
+    for (size_t i = 0; i < cfg->n_ids; i++) {
+        const evt_id_t id = cfg->ids[i];
+        if (id >= EVT_BUS_MAX_EVT_IDS) {
+            return false;
+        }
+        br->tx_ids[id / 8u] |= (uint8_t)(1u << (id % 8u));
+        reqs[i].evt_id = id;
+        reqs[i].cb = bridge_tx_cb;
+        reqs[i].user_ctx = br;
+    }
+
+    if (!evt_bus_inst_subscribe_many(bus, reqs, cfg->n_ids, br->subs)) {
+        return false;
+    }
+    br->n_subs = cfg->n_ids;
+    return true;
+}
+
+void evt_bus_bridge_stop(evt_bridge_t *br)
+{
+    if (br == NULL || br->bus == NULL) {
+        return;
+    }
+    evt_bus_inst_unsubscribe_many(br->bus, br->subs, br->n_subs);
+    br->n_subs = 0;
+    br->tx_len = 0;
+    br->tx_count = 0;
+}
+
+/* -------- RX (reader context) -------- */
+
+static void bridge_rx_frame(evt_bridge_t *br)
+{
+    const uint8_t *body = &br->rx_buf[HDR_LEN];
+    size_t pos = 0;
+
+    br->stats.rx_frames++;
+
+    while (pos < br->rx_len) {
+        uint32_t id, len;
+        if (!get_varint(body, br->rx_len, &pos, &id) ||
+            !get_varint(body, br->rx_len, &pos, &len) ||
+            id >= EVT_BUS_MAX_EVT_IDS || len > EVT_INLINE_MAX || len > br->rx_len - pos) {
+            br->stats.rx_format_errors++;
+            return;
+        }
+
+        if (forwards(br, id)) {
+            br->stats.rx_looped++;
+        } else if (evt_pub_ok(evt_bus_inst_publish_ex(br->bus, (evt_id_t)id, &body[pos], len))) {
+            br->stats.rx_records++;
+        } else {
+            br->stats.rx_rejected++;
+        }
+        pos += len;
+    }
+}
+
+void evt_bus_bridge_rx(evt_bridge_t *br, const uint8_t *data, size_t len)
+{
+    if (br == NULL || br->bus == NULL || (data == NULL && len > 0)) {
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t b = data[i];
+
+        switch (br->rx_state) {
+        case RX_SYNC0:
+            if (b == EVT_BRIDGE_SYNC0) {
+                br->rx_buf[0] = b;
+                br->rx_state = RX_SYNC1;
+            }
+            break;
+
+        case RX_SYNC1:
+            br->rx_buf[1] = b;
+            br->rx_state = (b == EVT_BRIDGE_SYNC1) ? RX_LEN0
+                         : (b == EVT_BRIDGE_SYNC0) ? RX_SYNC1 : RX_SYNC0;
+            break;
+
+        case RX_LEN0:
+            br->rx_buf[2] = b;
+            br->rx_state = RX_LEN1;
+            break;
+
+        case RX_LEN1:
+            br->rx_buf[3] = b;
+            br->rx_len = (size_t)br->rx_buf[2] | ((size_t)b << 8);
+            br->rx_pos = 0;
+            if (br->rx_len == 0 || br->rx_len > EVT_BRIDGE_MAX_BODY) {
+                br->stats.rx_format_errors++;
+                br->rx_state = RX_SYNC0;
+            } else {
+                br->rx_state = RX_BODY;
+            }
+            break;
+
+        case RX_BODY:
+            br->rx_buf[HDR_LEN + br->rx_pos++] = b;
+            if (br->rx_pos == br->rx_len) {
+                br->rx_state = RX_CRC0;
+            }
+            break;
+
+        case RX_CRC0:
+            br->rx_buf[HDR_LEN + br->rx_len] = b;
+            br->rx_state = RX_CRC1;
+            break;
+
+        case RX_CRC1:
+        default: {
+            const uint16_t want = (uint16_t)(br->rx_buf[HDR_LEN + br->rx_len] | ((uint16_t)b << 8));
+            if (evt_bus_bridge_crc16(0xFFFFu, &br->rx_buf[2], 2u + br->rx_len) == want) {
+                bridge_rx_frame(br);
+            } else {
+                br->stats.rx_crc_errors++;
+            }
+            br->rx_state = RX_SYNC0;
+            break;
+        }
+        }
+    }
+}
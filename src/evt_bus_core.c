@@ -8,22 +8,23 @@
 #include <assert.h>
 
 
-typedef struct{
-    evt_sub_handle_t handle;
-    evt_cb_t cb;
-    void* user_ctx;
-} evt_subscriber_t;
+/* Defined in port file. Weak so images that only use explicit instances link without it. */
+extern evt_bus_backend_t evt_bus_backend __attribute__((weak));
 
-typedef struct{
-    evt_id_t id;
-    evt_sub_handle_t subscribers[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
-} evt_subscription_t;
+/* Instance behind the evt_bus_* default API */
+static evt_bus_t default_bus;
 
+/* Lock-free counters: atomic builtins work on the plain fields of the public evt_bus_t */
+#define ATOMIC_LOAD(p)            __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ATOMIC_STORE(p, v)        __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define ATOMIC_ADD(p, v)          __atomic_fetch_add((p), (v), __ATOMIC_ACQ_REL)
+#define ATOMIC_SUB(p, v)          __atomic_fetch_sub((p), (v), __ATOMIC_ACQ_REL)
+#define ATOMIC_CAS(p, exp, v)     __atomic_compare_exchange_n((p), (exp), (v), false, \
+                                                              __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
 
-static evt_subscriber_t subscriber_pool[EVT_BUS_MAX_HANDLES];
-static evt_subscription_t subscriptions[EVT_BUS_MAX_EVT_IDS];
-
-extern evt_bus_backend_t evt_bus_backend; /* Defined in port file */
+/* Settings and statistics read outside the lock: tear-free, no ordering */
+#define RELAXED_LOAD(p)           __atomic_load_n((p), __ATOMIC_RELAXED)
+#define RELAXED_STORE(p, v)       __atomic_store_n((p), (v), __ATOMIC_RELAXED)
 
 /* Local helpers */
 
@@ -31,275 +32,2232 @@ static inline bool evt_handle_is_valid(evt_sub_handle_t h) {
   return h.id != EVT_HANDLE_ID_INVALID;
 }
 
-static bool allocate_handle(evt_sub_handle_t *out_handle){
+static inline void bus_lock(evt_bus_t *bus)
+{
+    if (bus->backend->lock) {
+        bus->backend->lock(bus->backend->ctx);
+    }
+}
+
+static inline void bus_unlock(evt_bus_t *bus)
+{
+    if (bus->backend->unlock) {
+        bus->backend->unlock(bus->backend->ctx);
+    }
+}
+
+/* Shared lock for read-only sections; the exclusive lock if the backend has none */
+static inline void bus_read_lock(evt_bus_t *bus)
+{
+    if (bus->backend->read_lock) {
+        bus->backend->read_lock(bus->backend->ctx);
+    } else {
+        bus_lock(bus);
+    }
+}
+
+static inline void bus_read_unlock(evt_bus_t *bus)
+{
+    if (bus->backend->read_unlock) {
+        bus->backend->read_unlock(bus->backend->ctx);
+    } else {
+        bus_unlock(bus);
+    }
+}
+
+static bool allocate_handle(evt_bus_t *bus, evt_sub_handle_t *out_handle){
     for (size_t i = 0; i < EVT_BUS_MAX_HANDLES; i++){
-        if (subscriber_pool[i].cb == NULL){
+        evt_subscriber_t *sub = &bus->subscriber_pool[i];
+        if (sub->cb == NULL){
             /* Found free handle */
-            subscriber_pool[i].handle.id = (hndl_id_t)i;
-            subscriber_pool[i].handle.gen += 1; /* Increment generation */
-            out_handle->id = subscriber_pool[i].handle.id;
-            out_handle->gen = subscriber_pool[i].handle.gen;
+            bus->subscriber_gen[i] += 1; /* Increment generation */
+#if EVT_BUS_CB_WATCHDOG
+            RELAXED_STORE(&bus->wd_strikes[i], 0u);
+            bus->wd_suspended[i] = 0;
+#endif
+#if EVT_BUS_MAX_RETAINED > 0
+            bus->replay_pending[i] = 0;
+#endif
+#if EVT_BUS_SUB_THROTTLE
+            memset(&bus->throttle[i], 0, sizeof(bus->throttle[i]));
+#endif
+            out_handle->id = (hndl_id_t)i;
+            out_handle->gen = bus->subscriber_gen[i];
             return true;
         }
     }
     return false; /* No free handles */
 }
 
-static bool register_subscription_slot(const evt_id_t evt_id, const evt_sub_handle_t handle)
+/* Subscription slots store handle id + 1, so the all-zero (.bss) table is empty */
+#define SLOT_EMPTY 0u
+
+static inline hndl_id_t slot_index(evt_sub_handle_t slot)
+{
+    return (hndl_id_t)(slot.id - 1u);
+}
+
+/* Slot still points at a live subscriber of the same generation */
+static inline bool slot_is_live(const evt_bus_t *bus, evt_sub_handle_t slot)
+{
+    const size_t idx = (size_t)slot.id - 1u;
+    return slot.id != SLOT_EMPTY && idx < EVT_BUS_MAX_HANDLES &&
+           bus->subscriber_pool[idx].cb != NULL &&
+           bus->subscriber_gen[idx] == slot.gen;
+}
+
+#if EVT_BUS_CB_WATCHDOG || EVT_BUS_MAX_BATCH_SUBS > 0
+/* Caller holds the lock */
+static bool handle_is_live(const evt_bus_t *bus, evt_sub_handle_t handle)
+{
+    return evt_handle_is_valid(handle) && (size_t)handle.id < EVT_BUS_MAX_HANDLES &&
+           bus->subscriber_pool[handle.id].cb != NULL &&
+           bus->subscriber_gen[handle.id] == handle.gen;
+}
+#endif
+
+static bool register_subscription_slot(evt_bus_t *bus, const evt_id_t evt_id, const evt_sub_handle_t handle)
 {
-    evt_subscription_t *sub = &subscriptions[evt_id];
+    evt_subscription_t *sub = &bus->subscriptions[evt_id];
 
     for (size_t i = 0; i < EVT_BUS_MAX_SUBSCRIBERS_PER_EVT; i++) {
         evt_sub_handle_t *slot = &sub->subscribers[i];
 
-        if (slot->id != EVT_HANDLE_ID_INVALID) {
+        if (slot->id != SLOT_EMPTY) {
             /* self-heal stale slot */
-            if ((size_t)slot->id >= EVT_BUS_MAX_HANDLES ||
-                subscriber_pool[slot->id].cb == NULL ||
-                subscriber_pool[slot->id].handle.gen != slot->gen) {
-                slot->id = EVT_HANDLE_ID_INVALID;
+            if (!slot_is_live(bus, *slot)) {
+                slot->id = SLOT_EMPTY;
                 slot->gen = 0;
             }
         }
 
-        if (slot->id == EVT_HANDLE_ID_INVALID) {
-            *slot = handle;
+        if (slot->id == SLOT_EMPTY) {
+            slot->id = (hndl_id_t)(handle.id + 1u);
+            slot->gen = handle.gen;
             return true;
         }
     }
     return false;
 }
 
-/* Public API */
+#if EVT_BUS_DIRECT_LANE
+/* Caller holds the lock: events of @p evt_id go back through the snapshot */
+static inline void lane_drop(evt_bus_t *bus, evt_id_t evt_id)
+{
+    ATOMIC_STORE(&bus->lanes[evt_id].valid, 0u);
+}
 
-void evt_bus_init(void){
+/* Caller holds the lock: drop the lane caching handle @p idx, if any */
+static void lane_drop_handle(evt_bus_t *bus, hndl_id_t idx)
+{
+    if (bus->lane_of[idx] != 0) {
+        lane_drop(bus, (evt_id_t)(bus->lane_of[idx] - 1u));
+        bus->lane_of[idx] = 0;
+    }
+}
+
+static inline void lane_drop_all(evt_bus_t *bus)
+{
+    for (evt_id_t id = 0; id < EVT_BUS_MAX_EVT_IDS; id++) {
+        lane_drop(bus, id);
+    }
+}
+#endif
 
-    assert((evt_bus_backend.lock == NULL) == (evt_bus_backend.unlock == NULL)
+/* Bind @p bus, whose tables are already all-zero, to @p backend */
+static bool bus_bind(evt_bus_t *bus, evt_bus_backend_t *backend)
+{
+    assert((backend->lock == NULL) == (backend->unlock == NULL)
        && "evt_bus_backend lock/unlock must both be NULL or both non-NULL");
+    assert((backend->read_lock == NULL) == (backend->read_unlock == NULL)
+       && (backend->read_lock == NULL || backend->lock != NULL)
+       && "evt_bus_backend read_lock/read_unlock must both be NULL or both set, with lock");
+
+    bus->backend = backend;
 
     /* Check for init function provided in port */
-    if (evt_bus_backend.init != NULL) {
-        bool ok = evt_bus_backend.init();
-        assert(ok && "evt_bus_backend init failed");
+    if (backend->init != NULL) {
+        if (!backend->init(backend->ctx)) {
+            return false;
+        }
     } else {
         /* No init function: assume no further initialization in port needed */
     }
     assert(EVT_BUS_MAX_HANDLES > 0 && "EVT_BUS_MAX_HANDLES must be > 0");
 
-    /* Initialize subscriber pool */
-    for (size_t i = 0; i < EVT_BUS_MAX_HANDLES; i++){
-        subscriber_pool[i].cb = NULL;
-        subscriber_pool[i].user_ctx = NULL;
-        subscriber_pool[i].handle.id = EVT_HANDLE_ID_INVALID;
-        subscriber_pool[i].handle.gen = 0;
-    }
-    /* Initialize subscription table */
-    for (size_t i = 0; i < EVT_BUS_MAX_EVT_IDS; i++){
-        subscriptions[i].id = 0;
-        for (size_t j = 0; j < EVT_BUS_MAX_SUBSCRIBERS_PER_EVT; j++){
-            subscriptions[i].subscribers[j].id = EVT_HANDLE_ID_INVALID;
-            subscriptions[i].subscribers[j].gen = 0;
-        }
-    }
+    /* Only non-zero default */
+    bus->reserved_slots = EVT_BUS_RESERVED_SLOTS;
+    return true;
 }
 
+/* Public API */
+
+bool evt_bus_inst_init(evt_bus_t *bus, evt_bus_backend_t *backend){
 
+    if (bus == NULL || backend == NULL) {
+        return false;
+    }
 
-evt_sub_handle_t evt_bus_subscribe(evt_id_t evt_id, evt_cb_t cb, void* user_ctx)
-{
-    evt_sub_handle_t handle = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
-    bool locked = false;
+    /* Caller storage may hold anything (stack, reused RAM): all-zero (cb NULL = free
+     * handle, slot 0 = empty, policy 0 = drop-new) is the empty bus */
+    memset(bus, 0, sizeof(*bus));
+    return bus_bind(bus, backend);
+}
 
-    /* Cheap validation first */
-    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return handle;
-    if (cb == NULL) return handle;
+#if EVT_BUS_MAX_RETAINED > 0
+/* Caller holds the lock. Marks @p h for a replay of the retained value of @p evt_id. */
+static bool replay_mark(evt_bus_t *bus, evt_id_t evt_id, evt_sub_handle_t h)
+{
+    const uint8_t s = bus->retained_slot[evt_id];
+    if (s == 0 || !bus->retained[s - 1u].valid) {
+        return false;
+    }
+    bus->replay_pending[h.id] = 1;
+    ATOMIC_ADD(&bus->replay_count, 1u);
+    return true;
+}
 
-    /* Lock once */
-    if (evt_bus_backend.lock) {
-        evt_bus_backend.lock(evt_bus_backend.ctx);
-        locked = true;
+/* Caller holds the lock */
+static void replay_unmark(evt_bus_t *bus, hndl_id_t idx)
+{
+    if (bus->replay_pending[idx]) {
+        bus->replay_pending[idx] = 0;
+        ATOMIC_SUB(&bus->replay_count, 1u);
     }
+}
+#endif
+
+/* Caller holds the lock and has validated evt_id / cb */
+static evt_sub_handle_t subscribe_locked(evt_bus_t *bus, evt_id_t evt_id, evt_cb_t cb, void *user_ctx)
+{
+    evt_sub_handle_t handle = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
 
     /* Allocate handle */
-    if (!allocate_handle(&handle)) {
+    if (!allocate_handle(bus, &handle)) {
         handle.id = EVT_HANDLE_ID_INVALID;
         handle.gen = 0;
-        goto out;
+        return handle;
     }
 
     /* Register slot */
-    if (!register_subscription_slot(evt_id, handle)) {
+    if (!register_subscription_slot(bus, evt_id, handle)) {
         /* Optional: release the allocated handle explicitly (not strictly required if cb==NULL marks free) */
-        subscriber_pool[handle.id].cb = NULL;
-        subscriber_pool[handle.id].user_ctx = NULL;
+        bus->subscriber_pool[handle.id].cb = NULL;
+        bus->subscriber_pool[handle.id].user_ctx = NULL;
         handle.id = EVT_HANDLE_ID_INVALID;
         handle.gen = 0;
-        goto out;
+        return handle;
     }
 
-    subscriber_pool[handle.id].cb = cb;
-    subscriber_pool[handle.id].user_ctx = user_ctx;
-    subscriptions[evt_id].id = evt_id;
+    bus->subscriber_pool[handle.id].cb = cb;
+    bus->subscriber_pool[handle.id].user_ctx = user_ctx;
+#if EVT_BUS_DIRECT_LANE
+    /* No longer (or not yet known to be) the only subscriber */
+    lane_drop(bus, evt_id);
+#endif
+    return handle;
+}
+
+static evt_sub_handle_t subscribe(evt_bus_t *bus, evt_id_t evt_id, evt_cb_t cb, void *user_ctx,
+                                  bool *replay)
+{
+    evt_sub_handle_t handle = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
+
+    /* Cheap validation first */
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return handle;
+    if (cb == NULL) return handle;
+
+    /* Lock once */
+    bus_lock(bus);
+
+    handle = subscribe_locked(bus, evt_id, cb, user_ctx);
 
-out:
-    if (locked && evt_bus_backend.unlock) {
-        evt_bus_backend.unlock(evt_bus_backend.ctx);
+#if EVT_BUS_MAX_RETAINED > 0
+    /* A dispatch snapshot that includes the handle before the replay runs clears the
+     * mark: that event is the new retained value, so replaying it would duplicate it */
+    if (replay != NULL && evt_handle_is_valid(handle)) {
+        *replay = replay_mark(bus, evt_id, handle);
     }
+#else
+    (void)replay;
+#endif
+
+    bus_unlock(bus);
     return handle;
 }
 
-void evt_bus_unsubscribe(evt_sub_handle_t handle){
-    if (!evt_handle_is_valid(handle)){
-        return;
-    }
+evt_sub_handle_t evt_bus_inst_subscribe(evt_bus_t *bus, evt_id_t evt_id, evt_cb_t cb, void* user_ctx)
+{
+    return subscribe(bus, evt_id, cb, user_ctx, NULL);
+}
 
-    if ((size_t)handle.id >= EVT_BUS_MAX_HANDLES){
+/* Caller holds the lock. Invalid or stale handles are a no-op. */
+static void unsubscribe_locked(evt_bus_t *bus, evt_sub_handle_t handle)
+{
+    if (!evt_handle_is_valid(handle) || (size_t)handle.id >= EVT_BUS_MAX_HANDLES) {
         return;
     }
 
-    if (subscriber_pool[handle.id].cb == NULL){
-        /* Stale handle */
+    evt_subscriber_t *sub = &bus->subscriber_pool[handle.id];
+    if (sub->cb == NULL || bus->subscriber_gen[handle.id] != handle.gen) {
         return;
     }
 
-    if (subscriber_pool[handle.id].handle.gen != handle.gen){
-        /* Stale handle */
-        return;
-    }
+    sub->cb = NULL;
+    sub->user_ctx = NULL;
+#if EVT_BUS_MAX_RETAINED > 0
+    replay_unmark(bus, handle.id);
+#endif
+#if EVT_BUS_DIRECT_LANE
+    lane_drop_handle(bus, handle.id);
+#endif
+}
 
-    if (evt_bus_backend.lock) 
-    {
-        evt_bus_backend.lock(evt_bus_backend.ctx);
-    }
-    /* Remove from subscription slots */
-    subscriber_pool[handle.id].cb = NULL;
-    subscriber_pool[handle.id].user_ctx = NULL;
-    subscriber_pool[handle.id].handle.id = EVT_HANDLE_ID_INVALID;
-    if (evt_bus_backend.unlock) {
-        evt_bus_backend.unlock(evt_bus_backend.ctx);
-    }
+void evt_bus_inst_unsubscribe(evt_bus_t *bus, evt_sub_handle_t handle){
+    /* Validated under the lock: the slot may be freed and reused by another subscriber
+     * between an unlocked check and the removal */
+    bus_lock(bus);
+    unsubscribe_locked(bus, handle);
+    bus_unlock(bus);
 }
 
+bool evt_bus_inst_subscribe_many(evt_bus_t *bus, const evt_sub_req_t *reqs, size_t n,
+                                 evt_sub_handle_t *out)
+{
+    const evt_sub_handle_t invalid = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
 
+    if ((reqs == NULL || out == NULL) && n > 0) return false;
 
-/* Enqueue an event for later dispatch (payload model defined below). */
-bool evt_bus_publish(evt_id_t evt_id, const void *payload, size_t payload_len){
-    /* Validate inputs */
-    if (payload_len > EVT_INLINE_MAX){
-        return false;
+    /* Cheap validation first: nothing to roll back for bad arguments */
+    bool ok = true;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = invalid;
+        ok = ok && reqs[i].evt_id < EVT_BUS_MAX_EVT_IDS && reqs[i].cb != NULL;
     }
-    if (evt_id >= EVT_BUS_MAX_EVT_IDS){
-        return false;
+    if (!ok) return false;
+
+    bus_lock(bus);
+
+    size_t done = 0;
+    for (; done < n; done++) {
+        out[done] = subscribe_locked(bus, reqs[done].evt_id, reqs[done].cb, reqs[done].user_ctx);
+        if (!evt_handle_is_valid(out[done])) {
+            break;
+        }
     }
 
-    if (payload_len > 0 && payload == NULL) 
-    {
-        return false;
+    /* Out of capacity: undo before the dispatcher can snapshot any of them */
+    if (done < n) {
+        for (size_t i = 0; i < done; i++) {
+            unsubscribe_locked(bus, out[i]);
+            out[i] = invalid;
+        }
     }
 
-    if (evt_bus_backend.enqueue == NULL) {
-        return false;
+    bus_unlock(bus);
+    return done == n;
+}
+
+void evt_bus_inst_unsubscribe_many(evt_bus_t *bus, const evt_sub_handle_t *handles, size_t n)
+{
+    if (handles == NULL || n == 0) return;
+
+    bus_lock(bus);
+    for (size_t i = 0; i < n; i++) {
+        unsubscribe_locked(bus, handles[i]);
     }
+    bus_unlock(bus);
+}
 
-    evt_t evt = {0};
-    evt.id = evt_id;
-    evt.len = (uint16_t)payload_len;
-    if (payload_len) {
-        memcpy(evt.payload, payload, payload_len);
+#if EVT_BUS_MAX_PUBLISHERS > 0
+static evt_publisher_t *publisher_get(evt_bus_t *bus, evt_pub_id_t pub)
+{
+    if (pub == EVT_PUB_ID_NONE || pub > ATOMIC_LOAD(&bus->publisher_count)) {
+        return NULL;
     }
+    return &bus->publishers[pub - 1u];
+}
 
-    /* Send callback to dispatcher queue */
-    return evt_bus_backend.enqueue(&evt);
+static void tokens_credit(evt_publisher_t *p, uint32_t n)
+{
+    uint32_t cur = ATOMIC_LOAD(&p->tokens);
+    uint32_t next;
+    do {
+        next = cur + n;
+        if (next > p->quota.burst) next = p->quota.burst;
+    } while (!ATOMIC_CAS(&p->tokens, &cur, next));
 }
 
-bool evt_bus_publish_from_isr(evt_id_t evt_id, const void *payload, size_t payload_len)
+static bool tokens_take(evt_bus_t *bus, evt_publisher_t *p)
 {
-    /* Validate inputs */
-    if (payload_len > EVT_INLINE_MAX){
-        return false;
+    const uint32_t now = bus->backend->now_us(bus->backend->ctx);
+    uint32_t last = ATOMIC_LOAD(&p->last_refill);
+    const uint32_t elapsed = now - last;
+    uint64_t earned = ((uint64_t)elapsed * p->quota.rate_per_sec) / 1000000u;
+
+    if (earned > 0) {
+        /* Advance the refill mark by exactly the time that was converted to tokens,
+         * so fractional credit is kept. Only the CAS winner credits the bucket. */
+        uint32_t advance;
+        if (earned >= p->quota.burst) {
+            earned  = p->quota.burst;
+            advance = elapsed;
+        } else {
+            advance = (uint32_t)((earned * 1000000u) / p->quota.rate_per_sec);
+        }
+        if (ATOMIC_CAS(&p->last_refill, &last, last + advance)) {
+            tokens_credit(p, (uint32_t)earned);
+        }
     }
-    if (evt_id >= EVT_BUS_MAX_EVT_IDS){
-        return false;
+
+    uint32_t cur = ATOMIC_LOAD(&p->tokens);
+    do {
+        if (cur == 0) return false;
+    } while (!ATOMIC_CAS(&p->tokens, &cur, cur - 1u));
+    return true;
+}
+
+static evt_pub_result_t publisher_admit(evt_bus_t *bus, evt_publisher_t *p)
+{
+    if (p->quota.max_inflight > 0) {
+        if (ATOMIC_ADD(&p->inflight, 1u) >= p->quota.max_inflight) {
+            ATOMIC_SUB(&p->inflight, 1u);
+            return EVT_PUB_ERR_QUOTA;
+        }
+    }
+    if (p->quota.rate_per_sec > 0 && !tokens_take(bus, p)) {
+        if (p->quota.max_inflight > 0) ATOMIC_SUB(&p->inflight, 1u);
+        return EVT_PUB_ERR_RATE;
     }
+    return EVT_PUB_OK;
+}
 
-    if (payload_len > 0 && payload == NULL) 
-    {
-        return false;
+/* Undo publisher_admit() for an event that never reached the queue */
+static void publisher_reject(evt_publisher_t *p)
+{
+    if (p->quota.max_inflight > 0) ATOMIC_SUB(&p->inflight, 1u);
+    if (p->quota.rate_per_sec > 0) tokens_credit(p, 1u);
+}
+
+/* Called once per event leaving the queue (dispatched or evicted) */
+static void publisher_release(evt_bus_t *bus, const evt_t *evt)
+{
+    evt_publisher_t *p = publisher_get(bus, evt->pub);
+    if (p != NULL && p->quota.max_inflight > 0) {
+        ATOMIC_SUB(&p->inflight, 1u);
     }
+}
+#endif
 
-    if (evt_bus_backend.enqueue_isr == NULL) {
-        return false;
+static inline uint32_t bus_now_us(const evt_bus_t *bus)
+{
+    const evt_bus_backend_t *be = bus->backend;
+    return (be->now_us != NULL) ? be->now_us(be->ctx) : 0u;
+}
+
+#if EVT_BUS_ENVELOPE_META
+static void meta_stamp(evt_bus_t *bus, evt_t *evt)
+{
+    evt->seq   = ATOMIC_ADD(&bus->next_seq, 1u);
+    evt->ts_us = bus_now_us(bus);
+}
+
+/* Dispatcher context only. The only writer, so it reads the fields plainly; readers
+ * in other tasks load each field atomically (evt_bus_inst_meta_stats). */
+static void meta_account(evt_bus_t *bus, const evt_t *evt)
+{
+    evt_meta_stats_t *m = &bus->meta;
+    const int32_t ahead = (int32_t)(evt->seq - bus->expect_seq);
+
+    RELAXED_STORE(&m->dispatched, m->dispatched + 1u);
+    if (bus->backend->remote_dispatch) {
+        /* Each publishing bus numbers its own events: no single sequence to follow */
+    } else if (ahead >= 0) {
+        RELAXED_STORE(&m->seq_gaps, m->seq_gaps + (uint32_t)ahead);
+        bus->expect_seq = evt->seq + 1u;
+    } else {
+        RELAXED_STORE(&m->seq_reordered, m->seq_reordered + 1u);
     }
 
-    evt_t evt = {0};
-    evt.id = evt_id;
-    evt.len = (uint16_t)payload_len;
-    if (payload_len) {
-        memcpy(evt.payload, payload, payload_len);
+    if (bus->backend->now_us != NULL) {
+        const uint32_t latency = bus_now_us(bus) - evt->ts_us;
+        RELAXED_STORE(&m->last_latency_us, latency);
+        if (latency > m->max_latency_us) {
+            RELAXED_STORE(&m->max_latency_us, latency);
+        }
     }
+}
+#endif
+
+#if EVT_BUS_MAX_WAITERS > 0 || EVT_BUS_MAX_REQUESTS > 0
+enum { WAITER_FREE = 0, WAITER_PENDING, WAITER_DONE };
 
-    /* Send callback to dispatcher queue */
-    return evt_bus_backend.enqueue_isr(&evt);
+static bool waiter_is_done(evt_bus_t *bus, const uint8_t *state)
+{
+    bus_read_lock(bus);
+    bool done = (*state == WAITER_DONE);
+    bus_read_unlock(bus);
+    return done;
 }
 
-void evt_bus_dispatch_evt(const evt_t *evt)
+/* Sleep the calling task until @p state is done or @p timeout_ms elapsed */
+static void waiter_block(evt_bus_t *bus, const uint8_t *state, uint32_t timeout_ms)
 {
-    if (!evt) return;
+    const evt_bus_backend_t *be = bus->backend;
+    const bool has_clock = (be->now_us != NULL);
+    const uint32_t t0 = bus_now_us(bus);
+    uint32_t left = timeout_ms;
 
-    const evt_id_t evt_id = evt->id;
-    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return;
+    while (be->waiter_sleep(be->ctx, left) && !waiter_is_done(bus, state)) {
+        /* Late wake from an earlier wait: sleep again for what is left */
+        if (timeout_ms != EVT_BUS_WAIT_FOREVER && has_clock) {
+            const uint32_t spent_ms = (bus_now_us(bus) - t0) / 1000u;
+            if (spent_ms >= timeout_ms) break;
+            left = timeout_ms - spent_ms;
+        }
+    }
+}
+#endif
 
-    /* Local snapshot for just this event id */
+#if EVT_BUS_MAX_WAITERS > 0
+/* Dispatcher, under lock: complete the waiters of @p evt, collect tokens to wake */
+static size_t waiters_complete(evt_bus_t *bus, const evt_t *evt, void **wake)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < EVT_BUS_MAX_WAITERS && bus->waiting > 0; i++) {
+        evt_waiter_t *w = &bus->waiters[i];
+        if (w->state == WAITER_PENDING && w->id == evt->id) {
+            if (w->out != NULL) {
+                *w->out = *evt;
+            }
+            w->state = WAITER_DONE;
+            bus->waiting--;
+            wake[n++] = w->task;
+        }
+    }
+    return n;
+}
+#endif
+
+#if EVT_BUS_CB_WATCHDOG
+/* Dispatcher context, after the callback of @p h returned */
+static void watchdog_check(evt_bus_t *bus, evt_id_t evt_id, evt_sub_handle_t h, uint32_t elapsed_us)
+{
+    const evt_cb_watchdog_t *wd = &bus->watchdog;
+    uint8_t *strikes = &bus->wd_strikes[h.id];
+
+    /* Resets come from other tasks (handle reuse, resume) under the lock. Losing one to
+     * the update below leaves at most one stale strike, cleared by the next callback
+     * within budget. */
+    if (elapsed_us <= wd->budget_us) {
+        RELAXED_STORE(strikes, 0u);
+        return;
+    }
+    uint8_t n = RELAXED_LOAD(strikes);
+    if (n < UINT8_MAX) {
+        n++;
+    }
+    if (n < wd->strikes) {
+        RELAXED_STORE(strikes, n);
+        return;
+    }
+    RELAXED_STORE(strikes, 0u);
+
+    bool suspended = false;
+    if (wd->auto_suspend) {
+        bus_lock(bus);
+        /* The callback may have unsubscribed itself meanwhile */
+        if (bus->subscriber_pool[h.id].cb != NULL && bus->subscriber_gen[h.id] == h.gen) {
+            bus->wd_suspended[h.id] = 1;
+#if EVT_BUS_DIRECT_LANE
+            lane_drop_handle(bus, h.id);
+#endif
+            suspended = true;
+        }
+        bus_unlock(bus);
+    }
+    if (wd->on_overrun != NULL) {
+        wd->on_overrun(h, evt_id, elapsed_us, suspended, wd->hook_ctx);
+    }
+}
+#endif
+
+#if EVT_BUS_MAX_RETAINED > 0
+/* Dispatcher context only: deliver retained values to subscribers marked by
+ * evt_bus_subscribe_retained(). Only the dispatcher writes retained[], so the stored
+ * event can be passed to callbacks without the lock. */
+static void retained_replay(evt_bus_t *bus)
+{
     evt_cb_t cbs[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
-    void   *ctxs[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
-    size_t  n = 0;
+    void    *ctxs[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
+
+    for (size_t r = 0; r < EVT_BUS_MAX_RETAINED; r++) {
+        const evt_retained_t *ret = &bus->retained[r];
+        size_t n = 0;
 
+        bus_lock(bus);
+        if (bus->replay_count == 0) {
+            bus_unlock(bus);
+            return;
+        }
+        if (ret->valid) {
+            const evt_subscription_t *subscription = &bus->subscriptions[ret->evt.id];
+            for (size_t i = 0; i < EVT_BUS_MAX_SUBSCRIBERS_PER_EVT; i++) {
+                const evt_sub_handle_t slot = subscription->subscribers[i];
+                if (!slot_is_live(bus, slot) || !bus->replay_pending[slot_index(slot)]) {
+                    continue;
+                }
+                const hndl_id_t idx = slot_index(slot);
+                replay_unmark(bus, idx);
+                cbs[n]  = bus->subscriber_pool[idx].cb;
+                ctxs[n] = bus->subscriber_pool[idx].user_ctx;
+                n++;
+            }
+        }
+        bus_unlock(bus);
 
-    /* Snapshot events on lock to avoid lock contention on executing callback */
-    if (evt_bus_backend.lock) {
-        evt_bus_backend.lock(evt_bus_backend.ctx);
+        for (size_t i = 0; i < n; i++) {
+            cbs[i](&ret->evt, ctxs[i]);
+        }
     }
+}
+#endif
 
-    evt_subscription_t *subscription = &subscriptions[evt_id];
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+/* Dispatcher context only */
+static void batch_flush(evt_bus_t *bus, evt_batch_t *b)
+{
+    const size_t n = b->count;
+    b->count = 0;
+    bus->batch_open--;
+    b->cb(b->buf, n, b->user_ctx);
+}
 
-    for (size_t i = 0; i < EVT_BUS_MAX_SUBSCRIBERS_PER_EVT; i++) {
-        evt_sub_handle_t *slot = (evt_sub_handle_t *)&subscription->subscribers[i];
-        evt_sub_handle_t h = *slot;
+/* Subscriber callback of every batch handle: user_ctx is the batch slot */
+static void batch_collect(const evt_t *evt, void *user_ctx)
+{
+    evt_batch_t *b = (evt_batch_t *)user_ctx;
+    evt_bus_t *bus = b->bus;
 
-        if (h.id == EVT_HANDLE_ID_INVALID) {
-            continue;
+    if (b->cfg.window_us > 0) {
+        const uint32_t now = bus_now_us(bus);
+        if (b->count > 0 && (uint32_t)(now - b->first_us) >= b->cfg.window_us) {
+            batch_flush(bus, b);
         }
+        if (b->count == 0) {
+            b->first_us = now;
+        }
+    }
 
-        /* Validate handle id range (defensive) */
-        if ((size_t)h.id >= EVT_BUS_MAX_HANDLES) {
-            /* self-heal: reclaim invalid id slot */
-            slot->id  = EVT_HANDLE_ID_INVALID;
-            slot->gen = 0;
+    if (b->count == 0) {
+        bus->batch_open++;
+    }
+    b->buf[b->count++] = *evt;
+    if (b->count >= b->cfg.max_events) {
+        batch_flush(bus, b);
+    }
+}
+
+/* Caller holds the lock (dispatcher's snapshot): free slots of unsubscribed handles.
+ * Slots are only released here, so a collecting callback never sees its slot reused. */
+static void batch_reap(evt_bus_t *bus)
+{
+    for (size_t i = 0; i < EVT_BUS_MAX_BATCH_SUBS; i++) {
+        evt_batch_t *b = &bus->batches[i];
+        if (b->cb == NULL || handle_is_live(bus, b->handle)) {
             continue;
         }
+        if (b->count > 0) {
+            b->count = 0;
+            bus->batch_open--;
+        }
+        b->cb = NULL;
+        bus->batch_used--;
+    }
+}
+
+/* Dispatcher context only */
+static void batch_flush_expired(evt_bus_t *bus)
+{
+    const uint32_t now = bus_now_us(bus);
+    for (size_t i = 0; i < EVT_BUS_MAX_BATCH_SUBS && bus->batch_open > 0; i++) {
+        evt_batch_t *b = &bus->batches[i];
+        if (b->count > 0 && b->cfg.window_us > 0 &&
+            (uint32_t)(now - b->first_us) >= b->cfg.window_us) {
+            batch_flush(bus, b);
+        }
+    }
+}
+#endif
 
-        const evt_subscriber_t *sub = &subscriber_pool[h.id];
+#if EVT_BUS_SUB_THROTTLE
+static inline bool throttle_active(const evt_throttle_t *t)
+{
+    return t->cfg.every_n > 1u || t->cfg.min_interval_us > 0u;
+}
 
-        /* Stale handle check */
-        if (sub->cb == NULL || sub->handle.gen != h.gen) {
-            /* self-heal: reclaim dead slot */
-            slot->id  = EVT_HANDLE_ID_INVALID;
-            slot->gen = 0;
-            continue;
+/* Dispatcher only: counts one event against the handle's limits, true => deliver */
+static bool throttle_pass(evt_bus_t *bus, evt_throttle_t *t)
+{
+    if (t->cfg.every_n > 1u) {
+        if (t->skip > 0u) {
+            t->skip--;
+            return false;
+        }
+        t->skip = (uint16_t)(t->cfg.every_n - 1u);
+    }
+    if (t->cfg.min_interval_us > 0u) {
+        const uint32_t now = bus_now_us(bus);
+        if (t->primed && (uint32_t)(now - t->last_us) < t->cfg.min_interval_us) {
+            return false;
         }
+        t->last_us = now;
+        t->primed  = true;
+    }
+    return true;
+}
+#endif
 
-        /* Snapshot cb + ctx */
-        cbs[n]  = sub->cb;
-        ctxs[n] = sub->user_ctx;
-        n++;
+#if EVT_BUS_MAX_DEDUP > 0
+/* What a publish changed in its dedup slot, to undo if the event is not enqueued */
+typedef struct {
+    evt_dedup_t *slot;
+    uint32_t     key;        /* claimed: hash | pending */
+    uint32_t     prev_key;
+    uint32_t     prev_us;
+} dedup_claim_t;
+
+/* FNV-1a over ID, length and payload. Bit 0 is the pending flag; bit 1 is forced so no
+ * event matches the all-zero initial state. */
+static uint32_t dedup_hash(const evt_t *evt)
+{
+    const uint8_t hdr[4] = {
+        (uint8_t)evt->id, (uint8_t)((uint32_t)evt->id >> 8),
+        (uint8_t)evt->len, (uint8_t)((uint32_t)evt->len >> 8),
+    };
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(hdr); i++) {
+        h = (h ^ hdr[i]) * 16777619u;
+    }
+    for (size_t i = 0; i < evt->len; i++) {
+        h = (h ^ evt->payload[i]) * 16777619u;
     }
+    return (h | 2u) & ~1u;
+}
+
+static inline evt_dedup_t *dedup_get(evt_bus_t *bus, evt_id_t evt_id)
+{
+    const uint8_t slot = ATOMIC_LOAD(&bus->dedup_slot[evt_id]);
+    return (slot != 0u) ? &bus->dedup[slot - 1u] : NULL;
+}
+
+/* Publisher, task or ISR: true => @p evt repeats the last accepted event of its ID, which
+ * is still queued or inside the window. Otherwise @p evt becomes the last accepted one;
+ * dedup_undo() if it is not enqueued after all. */
+static bool dedup_repeat(evt_bus_t *bus, evt_dedup_t *d, const evt_t *evt, dedup_claim_t *c)
+{
+    const uint32_t h      = dedup_hash(evt);
+    const uint32_t window = ATOMIC_LOAD(&d->window_us);
+    const uint32_t now    = (window > 0u) ? bus_now_us(bus) : 0u;
+    /* Another bus dispatches: dedup_done() never runs here, so nothing stays pending */
+    const uint32_t pending = bus->backend->remote_dispatch ? 0u : 1u;
+    uint32_t cur = ATOMIC_LOAD(&d->key);
+
+    do {
+        if ((cur & ~1u) == h &&
+            ((cur & 1u) != 0u ||
+             (window > 0u && (uint32_t)(now - ATOMIC_LOAD(&d->accepted_us)) < window))) {
+            return true;
+        }
+    } while (!ATOMIC_CAS(&d->key, &cur, h | pending));
+
+    c->slot     = d;
+    c->key      = h | pending;
+    c->prev_key = cur;
+    c->prev_us  = ATOMIC_LOAD(&d->accepted_us);
+    ATOMIC_STORE(&d->accepted_us, now);
+    return false;
+}
 
-    if (evt_bus_backend.unlock) {
-        evt_bus_backend.unlock(evt_bus_backend.ctx);
+/* The claimed event was rejected. The previous one is restored as no longer queued:
+ * a race can let one duplicate through, but never leaves an ID blocked. */
+static void dedup_undo(const dedup_claim_t *c)
+{
+    uint32_t expected = c->key;
+    if (ATOMIC_CAS(&c->slot->key, &expected, c->prev_key & ~1u)) {
+        ATOMIC_STORE(&c->slot->accepted_us, c->prev_us);
     }
+}
 
-    /* Fan out without lock */
-    for (size_t i = 0; i < n; i++) {
-        cbs[i](evt, ctxs[i]);
+/* @p evt left the queue (dispatched or evicted): identical publishes are accepted again
+ * once the window allows */
+static void dedup_done(evt_bus_t *bus, const evt_t *evt)
+{
+    if (evt->id >= EVT_BUS_MAX_EVT_IDS) return;   /* EVT_BUS_CTRL_ID */
+    evt_dedup_t *d = dedup_get(bus, (evt_id_t)evt->id);
+    if (d == NULL) return;
+
+    uint32_t expected = dedup_hash(evt) | 1u;
+    (void)ATOMIC_CAS(&d->key, &expected, expected & ~1u);
+}
+#endif
+
+/* Control events (EVT_BUS_CTRL_ID): the first payload byte says what for, a wake-up
+ * carries none. A ping carries its ticket after the op byte. */
+enum { CTRL_WAKE = 0, CTRL_PING = 1 };
+
+static bool ctrl_enqueue(evt_bus_t *bus, uint8_t op, uint32_t ticket)
+{
+    if (bus->backend == NULL || bus->backend->enqueue == NULL) return false;
+
+    evt_t ctrl;
+    memset(&ctrl, 0, sizeof(ctrl));
+    ctrl.id = (evt_env_id_t)EVT_BUS_CTRL_ID;
+    if (op == CTRL_PING) {
+        ctrl.len        = (evt_env_len_t)(1u + sizeof(ticket));
+        ctrl.payload[0] = op;
+        memcpy(&ctrl.payload[1], &ticket, sizeof(ticket));
     }
+#if EVT_BUS_ENVELOPE_META
+    meta_stamp(bus, &ctrl);
+#endif
+    return bus->backend->enqueue(bus->backend->ctx, &ctrl);
+}
+
+static bool build_evt(evt_t *evt, evt_id_t evt_id, const void *payload, size_t payload_len)
+{
+    /* Validate inputs */
+    if (payload_len > EVT_INLINE_MAX){
+        return false;
+    }
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS){
+        return false;
+    }
+
+    if (payload_len > 0 && payload == NULL)
+    {
+        return false;
+    }
+
+    memset(evt, 0, sizeof(*evt));
+    evt->id = (evt_env_id_t)evt_id;
+    evt->len = (evt_env_len_t)payload_len;
+    if (payload_len) {
+        memcpy(evt->payload, payload, payload_len);
+    }
+    return true;
+}
+
+/* Published by evt_bus_request(): carries a correlation ID */
+static inline bool evt_is_request(const evt_t *evt)
+{
+#if EVT_BUS_MAX_REQUESTS > 0
+    return evt->corr != EVT_CORR_NONE;
+#else
+    (void)evt;
+    return false;
+#endif
+}
+
+/* True if a free queue slot above @p reserved is left once @p freed (0 or 1) more slots
+ * are free. Always true without a reservation or without the free_slots hook */
+static bool above_reserve(const evt_bus_backend_t *be, size_t reserved, size_t freed, bool from_isr)
+{
+    return reserved == 0u || be->free_slots == NULL ||
+           be->free_slots(be->ctx, from_isr) > reserved - freed;
+}
+
+/* Task context: poll in EVT_BUS_RESERVE_POLL_MS sleeps until a slot above @p reserved
+ * is free or *left_ms elapsed. *left_ms is reduced by the time spent. Without the
+ * waiter_sleep hook only the current state is checked */
+static bool reserve_wait(evt_bus_t *bus, size_t reserved, uint32_t *left_ms)
+{
+    const evt_bus_backend_t *be = bus->backend;
+    const uint32_t timeout_ms = *left_ms;
+    const uint32_t t0 = bus_now_us(bus);
+    uint32_t slept_ms = 0;
+
+    for (;;) {
+        if (timeout_ms != EVT_BUS_WAIT_FOREVER) {
+            /* A sleep lasts at least its step: count them when the clock is coarse or absent */
+            uint32_t spent_ms = (bus_now_us(bus) - t0) / 1000u;
+            if (spent_ms < slept_ms) {
+                spent_ms = slept_ms;
+            }
+            *left_ms = (spent_ms < timeout_ms) ? timeout_ms - spent_ms : 0u;
+        }
+        if (above_reserve(be, reserved, 0u, false)) {
+            return true;
+        }
+        if (*left_ms == 0u || be->waiter_sleep == NULL) {
+            return false;
+        }
+        (void)be->waiter_sleep(be->ctx, EVT_BUS_RESERVE_POLL_MS);
+        slept_ms += EVT_BUS_RESERVE_POLL_MS;
+    }
+}
+
+static evt_pub_result_t enqueue_with_policy(evt_bus_t *bus, const evt_t *evt, bool from_isr)
+{
+    const evt_bus_backend_t *be = bus->backend;
+    bool (*enqueue)(void *, const evt_t *) = from_isr ? be->enqueue_isr : be->enqueue;
+
+    if (enqueue == NULL) {
+        return EVT_PUB_ERR_NO_BACKEND;
+    }
+
+    /* Written under the lock by evt_bus_set_policy(), read here without it: each field is
+     * loaded atomically, a publish racing a change may combine old and new fields */
+    const evt_policy_t *stored = &bus->policies[evt->id];
+    const evt_policy_t p = {
+        .mode       = RELAXED_LOAD(&stored->mode),
+        .critical   = RELAXED_LOAD(&stored->critical),
+        .timeout_ms = RELAXED_LOAD(&stored->timeout_ms),
+    };
+    const evt_policy_t *pol = &p;
+
+    /* Non-critical IDs may only take the slots above the reservation, whatever the mode */
+    const size_t reserved = pol->critical ? 0u : RELAXED_LOAD(&bus->reserved_slots);
+
+    switch (pol->mode) {
+    case EVT_BP_DROP_OLDEST:
+        if (above_reserve(be, reserved, 0u, from_isr) && enqueue(be->ctx, evt)) {
+            return EVT_PUB_OK;
+        }
+        /* Single eviction, and only if it frees a slot this ID may take. Another
+         * producer may still refill that slot first */
+        if (be->drop_oldest != NULL && above_reserve(be, reserved, 1u, from_isr)) {
+            evt_t dropped;
+            if (be->drop_oldest(be->ctx, from_isr, &dropped)) {
+#if EVT_BUS_MAX_PUBLISHERS > 0
+                publisher_release(bus, &dropped);
+#endif
+#if EVT_BUS_MAX_DEDUP > 0
+                dedup_done(bus, &dropped);
+#endif
+                if (above_reserve(be, reserved, 0u, from_isr) && enqueue(be->ctx, evt)) {
+                    return EVT_PUB_OK_DROPPED_OLDEST;
+                }
+            }
+        }
+        return above_reserve(be, reserved, 0u, from_isr) ? EVT_PUB_ERR_FULL : EVT_PUB_ERR_RESERVED;
+
+    case EVT_BP_BLOCK:
+        if (!from_isr && be->enqueue_timeout != NULL) {
+            uint32_t left_ms = pol->timeout_ms;
+            if (!reserve_wait(bus, reserved, &left_ms)) {
+                return EVT_PUB_ERR_RESERVED;
+            }
+            return be->enqueue_timeout(be->ctx, evt, left_ms)
+                   ? EVT_PUB_OK : EVT_PUB_ERR_TIMEOUT;
+        }
+        /* ISR or no blocking support: fall back to drop-new */
+        if (!above_reserve(be, reserved, 0u, from_isr)) {
+            return EVT_PUB_ERR_RESERVED;
+        }
+        return enqueue(be->ctx, evt) ? EVT_PUB_OK : EVT_PUB_ERR_FULL;
+
+    case EVT_BP_DROP_NEW:
+    default:
+        if (!above_reserve(be, reserved, 0u, from_isr)) {
+            return EVT_PUB_ERR_RESERVED;
+        }
+        return enqueue(be->ctx, evt) ? EVT_PUB_OK : EVT_PUB_ERR_FULL;
+    }
+}
+
+/* Publisher-token path: admission, enqueue, rollback on rejection */
+static evt_pub_result_t publish_admitted(evt_bus_t *bus, evt_pub_id_t pub, evt_t *evt, bool from_isr)
+{
+#if EVT_BUS_MAX_PUBLISHERS > 0
+    evt_publisher_t *p = publisher_get(bus, pub);
+    if (p == NULL) {
+        return EVT_PUB_ERR_INVALID;
+    }
+
+    evt_pub_result_t r = publisher_admit(bus, p);
+    if (r != EVT_PUB_OK) {
+        return r;
+    }
+
+    evt->pub = pub;
+    r = enqueue_with_policy(bus, evt, from_isr);
+    if (!evt_pub_ok(r)) {
+        publisher_reject(p);
+    }
+    return r;
+#else
+    (void)bus;
+    (void)pub;
+    (void)evt;
+    (void)from_isr;
+    return EVT_PUB_ERR_INVALID;
+#endif
+}
+
+/* Publish an envelope built by build_evt() */
+static evt_pub_result_t publish_evt(evt_bus_t *bus, evt_pub_id_t pub, evt_t *evt, bool from_isr)
+{
+#if EVT_BUS_MAX_DEDUP > 0
+    /* Before quotas and sequence numbers: a repeat costs the publisher nothing */
+    dedup_claim_t claim = { .slot = NULL };
+    evt_dedup_t *dd = evt_is_request(evt) ? NULL : dedup_get(bus, evt->id);
+    if (dd != NULL && dedup_repeat(bus, dd, evt, &claim)) {
+        return EVT_PUB_OK_DUPLICATE;
+    }
+#endif
+#if EVT_BUS_ENVELOPE_META
+    meta_stamp(bus, evt);
+#endif
+
+    evt_pub_result_t r = (pub == EVT_PUB_ID_NONE)
+                         ? enqueue_with_policy(bus, evt, from_isr)
+                         : publish_admitted(bus, pub, evt, from_isr);
+#if EVT_BUS_MAX_DEDUP > 0
+    if (claim.slot != NULL && !evt_pub_ok(r)) {
+        dedup_undo(&claim);
+    }
+#endif
+    return r;
+}
+
+static evt_pub_result_t publish_as(evt_bus_t *bus, evt_pub_id_t pub, evt_id_t evt_id,
+                                   const void *payload, size_t payload_len, bool from_isr)
+{
+    evt_t evt;
+    if (!build_evt(&evt, evt_id, payload, payload_len)) {
+        return EVT_PUB_ERR_INVALID;
+    }
+    return publish_evt(bus, pub, &evt, from_isr);
+}
+
+evt_pub_result_t evt_bus_inst_publish_ex(evt_bus_t *bus, evt_id_t evt_id,
+                                         const void *payload, size_t payload_len)
+{
+    return publish_as(bus, EVT_PUB_ID_NONE, evt_id, payload, payload_len, false);
+}
+
+evt_pub_result_t evt_bus_inst_publish_from_isr_ex(evt_bus_t *bus, evt_id_t evt_id,
+                                                  const void *payload, size_t payload_len)
+{
+    return publish_as(bus, EVT_PUB_ID_NONE, evt_id, payload, payload_len, true);
+}
+
+/* Enqueue an event for later dispatch (payload model defined below). */
+bool evt_bus_inst_publish(evt_bus_t *bus, evt_id_t evt_id, const void *payload, size_t payload_len){
+    return evt_pub_ok(evt_bus_inst_publish_ex(bus, evt_id, payload, payload_len));
+}
+
+bool evt_bus_inst_publish_from_isr(evt_bus_t *bus, evt_id_t evt_id, const void *payload, size_t payload_len)
+{
+    return evt_pub_ok(evt_bus_inst_publish_from_isr_ex(bus, evt_id, payload, payload_len));
+}
+
+evt_pub_result_t evt_bus_inst_publish_as(evt_bus_t *bus, evt_pub_id_t pub, evt_id_t evt_id,
+                                         const void *payload, size_t payload_len)
+{
+    return publish_as(bus, pub, evt_id, payload, payload_len, false);
+}
+
+evt_pub_result_t evt_bus_inst_publish_as_from_isr(evt_bus_t *bus, evt_pub_id_t pub, evt_id_t evt_id,
+                                                  const void *payload, size_t payload_len)
+{
+    return publish_as(bus, pub, evt_id, payload, payload_len, true);
+}
+
+evt_pub_id_t evt_bus_inst_publisher_register(evt_bus_t *bus, const evt_pub_quota_t *quota)
+{
+#if EVT_BUS_MAX_PUBLISHERS > 0
+    evt_pub_id_t pub = EVT_PUB_ID_NONE;
+    const evt_bus_backend_t *be = bus->backend;
+
+    if (quota == NULL) return EVT_PUB_ID_NONE;
+    if (quota->rate_per_sec > 0 && (quota->burst == 0 || be->now_us == NULL)) {
+        return EVT_PUB_ID_NONE;
+    }
+    /* In-flight credit comes back on dispatch, which another bus would do */
+    if (quota->max_inflight > 0 && be->remote_dispatch) {
+        return EVT_PUB_ID_NONE;
+    }
+
+    bus_lock(bus);
+    uint32_t n = ATOMIC_LOAD(&bus->publisher_count);
+    if (n < EVT_BUS_MAX_PUBLISHERS) {
+        evt_publisher_t *p = &bus->publishers[n];
+        p->quota = *quota;
+        ATOMIC_STORE(&p->inflight, 0u);
+        ATOMIC_STORE(&p->tokens, (uint32_t)quota->burst);
+        ATOMIC_STORE(&p->last_refill, quota->rate_per_sec > 0 ? be->now_us(be->ctx) : 0u);
+        /* Publish the slot only once it is fully initialized */
+        ATOMIC_STORE(&bus->publisher_count, n + 1u);
+        pub = (evt_pub_id_t)(n + 1u);
+    }
+    bus_unlock(bus);
+    return pub;
+#else
+    (void)bus;
+    (void)quota;
+    return EVT_PUB_ID_NONE;
+#endif
+}
+
+bool evt_bus_inst_set_policy(evt_bus_t *bus, evt_id_t evt_id, const evt_policy_t *policy)
+{
+    static const evt_policy_t default_policy = { .mode = EVT_BP_DROP_NEW };
+
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return false;
+    if (policy == NULL) policy = &default_policy;
+    if (policy->mode > EVT_BP_BLOCK) return false;
+
+    evt_policy_t *stored = &bus->policies[evt_id];
+    bus_lock(bus);
+    RELAXED_STORE(&stored->mode, policy->mode);
+    RELAXED_STORE(&stored->critical, policy->critical);
+    RELAXED_STORE(&stored->timeout_ms, policy->timeout_ms);
+    bus_unlock(bus);
+    return true;
+}
+
+void evt_bus_inst_set_reserved_slots(evt_bus_t *bus, size_t slots)
+{
+    RELAXED_STORE(&bus->reserved_slots, slots);
+}
+
+void evt_bus_inst_set_tap(evt_bus_t *bus, const evt_tap_t *tap)
+{
+    const evt_bus_backend_t *be = bus->backend;
+
+    /* Pairs with tap_run(): once tap_busy reads 0, the dispatcher sees the new tap */
+    __atomic_store_n(&bus->tap, tap, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&bus->tap_busy, __ATOMIC_SEQ_CST) != 0u) {
+        if (be != NULL && be->waiter_sleep != NULL) {
+            (void)be->waiter_sleep(be->ctx, 1u);
+        }
+    }
+}
+
+void evt_bus_fanout_job_run(const evt_fanout_job_t *job)
+{
+    for (size_t i = 0; i < job->n; i++) {
+        job->cbs[i](job->evt, job->ctxs[i]);
+    }
+}
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+static inline bool id_is_parallel(const evt_bus_t *bus, evt_id_t evt_id)
+{
+    return (bus->parallel_ids[evt_id / 8u] & (1u << (evt_id % 8u))) != 0;
+}
+
+/* Dispatcher context: split the snapshot into shares, run the first one here and join
+ * the workers before returning, so the next event still starts after this one ended */
+static void fanout_parallel(evt_bus_t *bus, const evt_t *evt, const evt_cb_t *cbs,
+                            void * const *ctxs, size_t n)
+{
+    const evt_bus_backend_t *be = bus->backend;
+    evt_fanout_job_t jobs[EVT_BUS_FANOUT_WORKERS + 1u];
+    bool             local[EVT_BUS_FANOUT_WORKERS + 1u];
+    bool             started = false;
+
+    const size_t max_shares = EVT_BUS_FANOUT_WORKERS + 1u;
+    const size_t per = (n + max_shares - 1u) / max_shares;
+    const size_t shares = (n + per - 1u) / per;
+
+    for (size_t s = 0; s < shares; s++) {
+        const size_t first = s * per;
+        jobs[s].evt  = evt;
+        jobs[s].cbs  = &cbs[first];
+        jobs[s].ctxs = &ctxs[first];
+        jobs[s].n    = (n - first < per) ? (n - first) : per;
+        local[s] = (s == 0) || !be->fanout_start(be->ctx, (unsigned)(s - 1u), &jobs[s]);
+        started = started || !local[s];
+    }
+
+    /* Own share, plus any share no worker took */
+    for (size_t s = 0; s < shares; s++) {
+        if (local[s]) {
+            evt_bus_fanout_job_run(&jobs[s]);
+        }
+    }
+    if (started) {
+        be->fanout_join(be->ctx);
+    }
+}
+#endif
+
+#if EVT_BUS_DIRECT_LANE
+/* Dispatcher, under lock: cache the sole live subscriber of @p evt_id */
+static void lane_fill(evt_bus_t *bus, evt_id_t evt_id, evt_sub_handle_t h)
+{
+    evt_lane_t *lane = &bus->lanes[evt_id];
+    lane->cb       = bus->subscriber_pool[h.id].cb;
+    lane->user_ctx = bus->subscriber_pool[h.id].user_ctx;
+    lane->handle   = h;
+#if EVT_BUS_CB_WATCHDOG
+    lane->timed    = (bus->watchdog.budget_us > 0);
+#endif
+    bus->lane_of[h.id] = (evt_id_t)(evt_id + 1u);
+    ATOMIC_STORE(&lane->valid, 1u);
+}
+
+/* Dispatcher only: deliver through the lane of the event's ID, without the lock or the
+ * row scan. Only the dispatcher writes a lane, so its fields cannot change under us.
+ * false => no valid lane, take the snapshot. */
+static bool lane_dispatch(evt_bus_t *bus, const evt_t *evt)
+{
+    const evt_lane_t *lane = &bus->lanes[evt->id];
+    if (ATOMIC_LOAD(&lane->valid) == 0u) return false;
+
+#if EVT_BUS_CB_WATCHDOG
+    if (lane->timed) {
+        const evt_sub_handle_t h = lane->handle;
+        const uint32_t t0 = bus_now_us(bus);
+        lane->cb(evt, lane->user_ctx);
+        watchdog_check(bus, (evt_id_t)evt->id, h, bus_now_us(bus) - t0);
+        return true;
+    }
+#endif
+    lane->cb(evt, lane->user_ctx);
+    return true;
+}
+#endif
+
+/* Under the shared lock: does the dispatch snapshot for @p evt_id write bus state
+ * (retained store, batch reaping, waiter completion)? */
+static inline bool snapshot_writes(const evt_bus_t *bus, evt_id_t evt_id)
+{
+    bool writes = false;
+#if EVT_BUS_MAX_RETAINED > 0
+    writes = writes || (bus->retained_slot[evt_id] != 0);
+#endif
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    writes = writes || (bus->batch_used > 0);
+#endif
+#if EVT_BUS_MAX_WAITERS > 0
+    writes = writes || (bus->waiting > 0);
+#endif
+    (void)bus;
+    (void)evt_id;
+    return writes;
+}
+
+/* Dispatcher context. Store-then-load on both sides (sequentially consistent): either
+ * evt_bus_inst_set_tap() sees tap_busy and waits, or this load sees its new tap */
+static void tap_run(evt_bus_t *bus, const evt_t *evt)
+{
+    __atomic_store_n(&bus->tap_busy, 1u, __ATOMIC_SEQ_CST);
+    const evt_tap_t *tap = __atomic_load_n(&bus->tap, __ATOMIC_SEQ_CST);
+    if (tap != NULL) {
+        tap->fn(evt, tap->ctx);
+    }
+    ATOMIC_STORE(&bus->tap_busy, 0u);
+}
+
+static void dispatch(evt_bus_t *bus, const evt_t *evt)
+{
+#if EVT_BUS_MAX_PUBLISHERS > 0
+    /* The event has left the queue: give the slot back to its publisher */
+    publisher_release(bus, evt);
+#endif
+#if EVT_BUS_MAX_DEDUP > 0
+    dedup_done(bus, evt);
+#endif
+#if EVT_BUS_ENVELOPE_META
+    meta_account(bus, evt);
+#endif
+#if EVT_BUS_MAX_RETAINED > 0
+    /* Lock-free peek: the mark is published before the control event is queued */
+    if (ATOMIC_LOAD(&bus->replay_count) > 0) {
+        retained_replay(bus);
+    }
+#endif
+#if EVT_BUS_LIVENESS
+    /* With remote dispatch the ticket belongs to another bus's counter: ignore it */
+    if (evt->id == EVT_BUS_CTRL_ID && evt->len == 1u + sizeof(uint32_t) &&
+        evt->payload[0] == CTRL_PING && !bus->backend->remote_dispatch) {
+        /* Acknowledge by ticket, not by count: a later ping also covers an earlier one
+         * lost from the queue (e.g. evicted by drop-oldest). Only the dispatcher writes. */
+        uint32_t ticket;
+        memcpy(&ticket, &evt->payload[1], sizeof(ticket));
+        if ((int32_t)(ticket - RELAXED_LOAD(&bus->pings_acked)) > 0) {
+            ATOMIC_STORE(&bus->pings_acked, ticket);
+        }
+    }
+#endif
+
+    const evt_id_t evt_id = evt->id;
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return;   /* incl. EVT_BUS_CTRL_ID */
+
+    if (ATOMIC_LOAD(&bus->tap) != NULL) {
+        tap_run(bus, evt);
+    }
+
+#if EVT_BUS_DIRECT_LANE
+    if (lane_dispatch(bus, evt)) return;
+#endif
+
+    /* Local snapshot for just this event id */
+    evt_cb_t cbs[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
+    void   *ctxs[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
+    size_t  n = 0;
+#if EVT_BUS_CB_WATCHDOG
+    evt_sub_handle_t hs[EVT_BUS_MAX_SUBSCRIBERS_PER_EVT];
+#endif
+#if EVT_BUS_MAX_WAITERS > 0
+    void  *wake[EVT_BUS_MAX_WAITERS];
+    size_t n_wake = 0;
+#endif
+#if EVT_BUS_FANOUT_WORKERS > 0
+    bool parallel = false;
+#endif
+#if EVT_BUS_DIRECT_LANE
+    size_t           live = 0;
+    evt_sub_handle_t sole = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
+#endif
+
+    /* Snapshot events on lock to avoid lock contention on executing callback.
+     * The shared lock suffices unless the snapshot also writes bus state. */
+    bool exclusive = (bus->backend->read_lock == NULL);
+    if (exclusive) {
+        bus_lock(bus);
+    } else {
+        bus_read_lock(bus);
+        if (snapshot_writes(bus, evt_id)) {
+            bus_read_unlock(bus);
+            bus_lock(bus);
+            exclusive = true;
+        }
+    }
+
+#if EVT_BUS_MAX_RETAINED > 0
+    if (bus->retained_slot[evt_id] != 0) {
+        evt_retained_t *ret = &bus->retained[bus->retained_slot[evt_id] - 1u];
+        ret->evt   = *evt;
+        ret->valid = true;
+    }
+#endif
+
+    evt_subscription_t *subscription = &bus->subscriptions[evt_id];
+
+    for (size_t i = 0; i < EVT_BUS_MAX_SUBSCRIBERS_PER_EVT; i++) {
+        evt_sub_handle_t *slot = &subscription->subscribers[i];
+
+        if (slot->id == SLOT_EMPTY) {
+            continue;
+        }
+
+        /* Range + stale handle check */
+        if (!slot_is_live(bus, *slot)) {
+            /* self-heal: reclaim dead slot (left to subscribe under the shared lock) */
+            if (exclusive) {
+                slot->id  = SLOT_EMPTY;
+                slot->gen = 0;
+            }
+            continue;
+        }
+
+        const hndl_id_t idx = slot_index(*slot);
+        const evt_subscriber_t *sub = &bus->subscriber_pool[idx];
+#if EVT_BUS_MAX_RETAINED > 0
+        /* Subscribed with a replay still pending (between the replay check and this
+         * lock): this event supersedes the retained value, deliver it once. Retained
+         * IDs always take the exclusive lock. */
+        if (bus->retained_slot[evt_id] != 0) {
+            replay_unmark(bus, idx);
+        }
+#endif
+#if EVT_BUS_DIRECT_LANE
+        live++;
+        sole.id  = idx;
+        sole.gen = slot->gen;
+#endif
+
+#if EVT_BUS_CB_WATCHDOG
+        if (bus->wd_suspended[idx]) {
+            continue;
+        }
+        hs[n].id  = idx;
+        hs[n].gen = slot->gen;
+#endif
+#if EVT_BUS_SUB_THROTTLE
+        evt_throttle_t *thr = &bus->throttle[idx];
+        if (throttle_active(thr) && !throttle_pass(bus, thr)) {
+            continue;
+        }
+#endif
+
+        /* Snapshot cb + ctx */
+        cbs[n]  = sub->cb;
+        ctxs[n] = sub->user_ctx;
+        n++;
+    }
+
+#if EVT_BUS_DIRECT_LANE
+    /* Only while the snapshot is read-only: a lane skips retained stores, batch reaping
+     * and waiter completion */
+    if (live == 1u && !snapshot_writes(bus, evt_id)
+#if EVT_BUS_CB_WATCHDOG
+        && !bus->wd_suspended[sole.id]
+#endif
+#if EVT_BUS_SUB_THROTTLE
+        /* Throttle state is reset under the lock when the handle is reused */
+        && !throttle_active(&bus->throttle[sole.id])
+#endif
+    ) {
+        lane_fill(bus, evt_id, sole);
+    }
+#endif
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+    parallel = (n > 1) && id_is_parallel(bus, evt_id);
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    /* Batch collectors share dispatcher-only state: keep such events serial */
+    for (size_t i = 0; parallel && i < n; i++) {
+        parallel = (cbs[i] != batch_collect);
+    }
+#endif
+#endif
+
+#if EVT_BUS_CB_WATCHDOG
+    const bool timed = (bus->watchdog.budget_us > 0);
+#endif
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    if (bus->batch_used > 0) {
+        batch_reap(bus);
+    }
+#endif
+#if EVT_BUS_MAX_WAITERS > 0
+    if (bus->waiting > 0) {
+        n_wake = waiters_complete(bus, evt, wake);
+    }
+#endif
+
+    if (exclusive) {
+        bus_unlock(bus);
+    } else {
+        bus_read_unlock(bus);
+    }
+
+#if EVT_BUS_MAX_WAITERS > 0
+    for (size_t i = 0; i < n_wake; i++) {
+        bus->backend->waiter_wake(bus->backend->ctx, wake[i]);
+    }
+#endif
+
+    /* Fan out without lock */
+    size_t i = 0;
+#if EVT_BUS_FANOUT_WORKERS > 0
+    if (parallel) {
+        fanout_parallel(bus, evt, cbs, ctxs, n);
+        i = n;
+    }
+#endif
+    for (; i < n; i++) {
+#if EVT_BUS_CB_WATCHDOG
+        const uint32_t t0 = timed ? bus_now_us(bus) : 0u;
+        cbs[i](evt, ctxs[i]);
+        if (timed) {
+            watchdog_check(bus, evt_id, hs[i], bus_now_us(bus) - t0);
+        }
+#else
+        cbs[i](evt, ctxs[i]);
+#endif
+    }
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    if (bus->batch_open > 0) {
+        batch_flush_expired(bus);
+    }
+#endif
+}
+
+void evt_bus_inst_dispatch_evt(evt_bus_t *bus, const evt_t *evt)
+{
+    if (!evt) return;
+
+#if EVT_BUS_LIVENESS
+    /* Seqlock, only the dispatcher writes: busy_seq goes odd, then busy_id /
+     * busy_since_us are updated. The release fence keeps the odd value ahead of them for
+     * a reader that sees the new fields, so it retries (see evt_bus_inst_liveness()) */
+    const uint32_t seq = RELAXED_LOAD(&bus->busy_seq);
+    RELAXED_STORE(&bus->busy_seq, seq + 1u);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    RELAXED_STORE(&bus->busy_id, (evt->id < EVT_BUS_MAX_EVT_IDS) ? (evt_id_t)evt->id : EVT_BUS_CTRL_ID);
+    RELAXED_STORE(&bus->busy_since_us, bus_now_us(bus));
+    dispatch(bus, evt);
+    ATOMIC_STORE(&bus->busy_seq, seq + 2u);
+#else
+    dispatch(bus, evt);
+#endif
+}
+
+bool evt_bus_inst_ping(evt_bus_t *bus, uint32_t *ticket)
+{
+#if EVT_BUS_LIVENESS
+    /* Another bus would dispatch the ping: this one could never see it acknowledged */
+    if (bus->backend != NULL && bus->backend->remote_dispatch) {
+        return false;
+    }
+    const uint32_t t = ATOMIC_ADD(&bus->pings_sent, 1u) + 1u;
+    if (!ctrl_enqueue(bus, CTRL_PING, t)) {
+        /* Give the ticket back unless a later ping already took the next one */
+        uint32_t expect = t;
+        (void)ATOMIC_CAS(&bus->pings_sent, &expect, t - 1u);
+        return false;
+    }
+    if (ticket != NULL) *ticket = t;
+    return true;
+#else
+    (void)bus;
+    (void)ticket;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_ping_acked(evt_bus_t *bus, uint32_t ticket)
+{
+#if EVT_BUS_LIVENESS
+    return (int32_t)(ATOMIC_LOAD(&bus->pings_acked) - ticket) >= 0;
+#else
+    (void)bus;
+    (void)ticket;
+    return false;
+#endif
+}
+
+void evt_bus_inst_liveness(evt_bus_t *bus, evt_bus_liveness_t *out)
+{
+    if (out == NULL) return;
+    memset(out, 0, sizeof(*out));
+#if EVT_BUS_LIVENESS
+    uint32_t s0;
+    uint32_t s1;
+    do {
+        s0 = ATOMIC_LOAD(&bus->busy_seq);
+        out->busy_id       = RELAXED_LOAD(&bus->busy_id);
+        out->busy_since_us = RELAXED_LOAD(&bus->busy_since_us);
+        /* Keeps the field loads ahead of the re-check: a newer field implies a newer s1 */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        s1 = RELAXED_LOAD(&bus->busy_seq);
+    } while (s0 != s1);
+    out->busy = (s0 & 1u) != 0u;
+    if (!out->busy) {
+        out->busy_id       = 0;
+        out->busy_since_us = 0;
+    }
+    out->pings_sent  = ATOMIC_LOAD(&bus->pings_sent);
+    out->pings_acked = ATOMIC_LOAD(&bus->pings_acked);
+#else
+    (void)bus;
+#endif
+}
+
+bool evt_bus_inst_set_retained(evt_bus_t *bus, evt_id_t evt_id)
+{
+#if EVT_BUS_MAX_RETAINED > 0
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return false;
+
+    bus_lock(bus);
+#if EVT_BUS_DIRECT_LANE
+    lane_drop(bus, evt_id);
+#endif
+    bool ok = (bus->retained_slot[evt_id] != 0);
+    for (size_t r = 0; !ok && r < EVT_BUS_MAX_RETAINED; r++) {
+        bool used = false;
+        for (size_t id = 0; id < EVT_BUS_MAX_EVT_IDS && !used; id++) {
+            used = (bus->retained_slot[id] == r + 1u);
+        }
+        if (!used) {
+            bus->retained[r].valid = false;
+            bus->retained_slot[evt_id] = (uint8_t)(r + 1u);
+            ok = true;
+        }
+    }
+    bus_unlock(bus);
+    return ok;
+#else
+    (void)bus;
+    (void)evt_id;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_get_retained(evt_bus_t *bus, evt_id_t evt_id, evt_t *out)
+{
+#if EVT_BUS_MAX_RETAINED > 0
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS || out == NULL) return false;
+
+    bus_read_lock(bus);
+    const uint8_t s = bus->retained_slot[evt_id];
+    const bool ok = (s != 0 && bus->retained[s - 1u].valid);
+    if (ok) {
+        *out = bus->retained[s - 1u].evt;
+    }
+    bus_read_unlock(bus);
+    return ok;
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)out;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_set_dedup(evt_bus_t *bus, evt_id_t evt_id, const evt_dedup_cfg_t *cfg)
+{
+#if EVT_BUS_MAX_DEDUP > 0
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return false;
+    if (cfg != NULL && cfg->window_us > 0 && bus->backend->now_us == NULL) return false;
+    /* Without a window, a copy counts until it is dispatched, which another bus would do */
+    if (cfg != NULL && cfg->window_us == 0 && bus->backend->remote_dispatch) return false;
+
+    bus_lock(bus);
+    uint8_t slot = bus->dedup_slot[evt_id];
+    if (cfg == NULL) {
+        ATOMIC_STORE(&bus->dedup_slot[evt_id], (uint8_t)0u);
+        bus_unlock(bus);
+        return true;
+    }
+    for (size_t r = 0; slot == 0 && r < EVT_BUS_MAX_DEDUP; r++) {
+        bool used = false;
+        for (size_t id = 0; id < EVT_BUS_MAX_EVT_IDS && !used; id++) {
+            used = (bus->dedup_slot[id] == r + 1u);
+        }
+        if (!used) {
+            evt_dedup_t *d = &bus->dedup[r];
+            ATOMIC_STORE(&d->key, 0u);
+            ATOMIC_STORE(&d->accepted_us, 0u);
+            slot = (uint8_t)(r + 1u);
+        }
+    }
+    if (slot != 0) {
+        ATOMIC_STORE(&bus->dedup[slot - 1u].window_us, cfg->window_us);
+        /* Published last: publishers see a reset slot */
+        ATOMIC_STORE(&bus->dedup_slot[evt_id], slot);
+    }
+    bus_unlock(bus);
+    return slot != 0;
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)cfg;
+    return false;
+#endif
+}
+
+evt_sub_handle_t evt_bus_inst_subscribe_retained(evt_bus_t *bus, evt_id_t evt_id,
+                                                 evt_cb_t cb, void *user_ctx)
+{
+    bool replay = false;
+    evt_sub_handle_t h = subscribe(bus, evt_id, cb, user_ctx, &replay);
+
+    if (replay) {
+        /* Wake the dispatcher. If the queue is full it is about to run anyway, and
+         * the replay goes out before the next event. */
+        (void)ctrl_enqueue(bus, CTRL_WAKE, 0u);
+    }
+    return h;
+}
+
+evt_sub_handle_t evt_bus_inst_subscribe_batch(evt_bus_t *bus, evt_id_t evt_id, evt_batch_cb_t cb,
+                                              const evt_batch_cfg_t *cfg, void *user_ctx)
+{
+    evt_sub_handle_t handle = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    evt_batch_cfg_t c = { .max_events = EVT_BUS_BATCH_MAX_EVENTS, .window_us = 0 };
+    if (cfg != NULL) {
+        c = *cfg;
+        if (c.max_events == 0) c.max_events = EVT_BUS_BATCH_MAX_EVENTS;
+    }
+
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS || cb == NULL) return handle;
+    if (c.max_events > EVT_BUS_BATCH_MAX_EVENTS) return handle;
+    if (c.window_us > 0 && bus->backend->now_us == NULL) return handle;
+
+    bus_lock(bus);
+    for (size_t i = 0; i < EVT_BUS_MAX_BATCH_SUBS; i++) {
+        evt_batch_t *b = &bus->batches[i];
+        if (b->cb != NULL) {
+            continue;
+        }
+        handle = subscribe_locked(bus, evt_id, batch_collect, b);
+        if (evt_handle_is_valid(handle)) {
+            b->bus      = bus;
+            b->cb       = cb;
+            b->user_ctx = user_ctx;
+            b->handle   = handle;
+            b->cfg      = c;
+            b->count    = 0;
+            bus->batch_used++;
+#if EVT_BUS_DIRECT_LANE
+            /* Released slots are reaped by the snapshot: no lanes while batches exist */
+            lane_drop_all(bus);
+#endif
+        }
+        break;
+    }
+    bus_unlock(bus);
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)cb;
+    (void)cfg;
+    (void)user_ctx;
+#endif
+    return handle;
+}
+
+evt_sub_handle_t evt_bus_inst_subscribe_throttled(evt_bus_t *bus, evt_id_t evt_id, evt_cb_t cb,
+                                                  const evt_sub_throttle_t *cfg, void *user_ctx)
+{
+    evt_sub_handle_t handle = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
+#if EVT_BUS_SUB_THROTTLE
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS || cb == NULL || cfg == NULL) return handle;
+    if (cfg->min_interval_us > 0 && bus->backend->now_us == NULL) return handle;
+
+    bus_lock(bus);
+    handle = subscribe_locked(bus, evt_id, cb, user_ctx);
+    if (evt_handle_is_valid(handle)) {
+        bus->throttle[handle.id].cfg = *cfg;
+    }
+    bus_unlock(bus);
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)cb;
+    (void)cfg;
+    (void)user_ctx;
+#endif
+    return handle;
+}
+
+void evt_bus_inst_batch_poll(evt_bus_t *bus)
+{
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    if (bus->batch_open == 0) return;
+
+    bus_lock(bus);
+    batch_reap(bus);
+    bus_unlock(bus);
+
+    batch_flush_expired(bus);
+#else
+    (void)bus;
+#endif
+}
+
+uint32_t evt_bus_inst_batch_next_due_us(evt_bus_t *bus)
+{
+    uint32_t due = UINT32_MAX;
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    if (bus->batch_open == 0) return due;
+
+    const uint32_t now = bus_now_us(bus);
+    for (size_t i = 0; i < EVT_BUS_MAX_BATCH_SUBS; i++) {
+        const evt_batch_t *b = &bus->batches[i];
+        if (b->count == 0 || b->cfg.window_us == 0) continue;
+
+        const uint32_t age  = now - b->first_us;
+        const uint32_t left = (age >= b->cfg.window_us) ? 0u : b->cfg.window_us - age;
+        if (left < due) due = left;
+    }
+#else
+    (void)bus;
+#endif
+    return due;
+}
+
+bool evt_bus_inst_set_parallel(evt_bus_t *bus, evt_id_t evt_id, bool parallel)
+{
+#if EVT_BUS_FANOUT_WORKERS > 0
+    const evt_bus_backend_t *be = bus->backend;
+
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return false;
+    if (parallel && (be->fanout_start == NULL || be->fanout_join == NULL)) return false;
+
+    const uint8_t bit = (uint8_t)(1u << (evt_id % 8u));
+    bus_lock(bus);
+    if (parallel) {
+        bus->parallel_ids[evt_id / 8u] |= bit;
+    } else {
+        bus->parallel_ids[evt_id / 8u] &= (uint8_t)~bit;
+    }
+    bus_unlock(bus);
+    return true;
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)parallel;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_wait_for(evt_bus_t *bus, evt_id_t evt_id, evt_t *out, uint32_t timeout_ms)
+{
+#if EVT_BUS_MAX_WAITERS > 0
+    const evt_bus_backend_t *be = bus->backend;
+
+    if (evt_id >= EVT_BUS_MAX_EVT_IDS) return false;
+    if (be->waiter_self == NULL || be->waiter_sleep == NULL || be->waiter_wake == NULL) {
+        return false;
+    }
+
+    evt_waiter_t *w = NULL;
+    bus_lock(bus);
+    for (size_t i = 0; i < EVT_BUS_MAX_WAITERS; i++) {
+        if (bus->waiters[i].state == WAITER_FREE) {
+            w = &bus->waiters[i];
+            w->task  = be->waiter_self(be->ctx);
+            w->out   = out;
+            w->id    = evt_id;
+            w->state = WAITER_PENDING;
+            bus->waiting++;
+#if EVT_BUS_DIRECT_LANE
+            lane_drop(bus, evt_id);
+#endif
+            break;
+        }
+    }
+    bus_unlock(bus);
+    if (w == NULL) return false;
+
+    waiter_block(bus, &w->state, timeout_ms);
+
+    /* Release the slot; an event dispatched up to here still counts */
+    bus_lock(bus);
+    const bool done = (w->state == WAITER_DONE);
+    if (!done) {
+        bus->waiting--;
+    }
+    w->state = WAITER_FREE;
+    bus_unlock(bus);
+    return done;
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)out;
+    (void)timeout_ms;
+    return false;
+#endif
+}
+
+#if EVT_BUS_MAX_REQUESTS > 0
+static inline evt_corr_t req_corr(size_t slot, uint32_t gen)
+{
+    return (evt_corr_t)((gen << 8) | (uint32_t)(slot + 1u));
+}
+#endif
+
+evt_pub_result_t evt_bus_inst_request(evt_bus_t *bus, evt_id_t evt_id, const void *payload,
+                                      size_t payload_len, evt_t *reply, uint32_t timeout_ms)
+{
+#if EVT_BUS_MAX_REQUESTS > 0
+    const evt_bus_backend_t *be = bus->backend;
+
+    evt_t evt;
+    if (!build_evt(&evt, evt_id, payload, payload_len)) {
+        return EVT_PUB_ERR_INVALID;
+    }
+    if (be->waiter_self == NULL || be->waiter_sleep == NULL || be->waiter_wake == NULL) {
+        return EVT_PUB_ERR_NO_BACKEND;
+    }
+
+    evt_req_slot_t *rs = NULL;
+    bus_lock(bus);
+    for (size_t i = 0; i < EVT_BUS_MAX_REQUESTS; i++) {
+        if (bus->requests[i].state == WAITER_FREE) {
+            rs = &bus->requests[i];
+            rs->task  = be->waiter_self(be->ctx);
+            rs->reply = reply;
+            rs->gen++;
+            rs->state = WAITER_PENDING;
+            evt.corr  = req_corr(i, rs->gen);
+            break;
+        }
+    }
+    bus_unlock(bus);
+    if (rs == NULL) return EVT_PUB_ERR_NO_SLOT;
+
+    evt_pub_result_t r = publish_evt(bus, EVT_PUB_ID_NONE, &evt, false);
+    if (evt_pub_ok(r)) {
+        waiter_block(bus, &rs->state, timeout_ms);
+    }
+
+    /* Release the slot; a reply up to here still counts */
+    bus_lock(bus);
+    if (evt_pub_ok(r)) {
+        r = (rs->state == WAITER_DONE) ? EVT_PUB_OK : EVT_PUB_ERR_NO_REPLY;
+    }
+    rs->state = WAITER_FREE;
+    bus_unlock(bus);
+    return r;
+#else
+    (void)bus;
+    (void)evt_id;
+    (void)payload;
+    (void)payload_len;
+    (void)reply;
+    (void)timeout_ms;
+    return EVT_PUB_ERR_NO_BACKEND;
+#endif
+}
+
+bool evt_bus_inst_reply(evt_bus_t *bus, const evt_t *request, const void *payload, size_t payload_len)
+{
+#if EVT_BUS_MAX_REQUESTS > 0
+    if (request == NULL) return false;
+
+    /* The low byte names the slot, the generation rejects replies to an earlier request */
+    const evt_corr_t corr = request->corr;
+    const size_t slot = (size_t)(corr & 0xFFu);
+    if (slot == 0u || slot > EVT_BUS_MAX_REQUESTS) return false;
+
+    evt_t evt;
+    if (!build_evt(&evt, request->id, payload, payload_len)) {
+        return false;
+    }
+
+    evt_req_slot_t *rs = &bus->requests[slot - 1u];
+    void *task = NULL;
+    bool done = false;
+    bus_lock(bus);
+    if (rs->state == WAITER_PENDING && req_corr(slot - 1u, rs->gen) == corr) {
+        if (rs->reply != NULL) {
+            *rs->reply = evt;
+        }
+        rs->state = WAITER_DONE;
+        task = rs->task;
+        done = true;
+    }
+    bus_unlock(bus);
+
+    if (done) {
+        bus->backend->waiter_wake(bus->backend->ctx, task);
+    }
+    return done;
+#else
+    (void)bus;
+    (void)request;
+    (void)payload;
+    (void)payload_len;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_set_cb_watchdog(evt_bus_t *bus, const evt_cb_watchdog_t *cfg)
+{
+#if EVT_BUS_CB_WATCHDOG
+    static const evt_cb_watchdog_t disabled = { .budget_us = 0 };
+
+    if (cfg == NULL) cfg = &disabled;
+    if (cfg->budget_us > 0 && bus->backend->now_us == NULL) return false;
+
+    bus_lock(bus);
+    bus->watchdog = *cfg;
+    if (bus->watchdog.strikes == 0) {
+        bus->watchdog.strikes = 1;
+    }
+#if EVT_BUS_DIRECT_LANE
+    lane_drop_all(bus);   /* lanes cache whether to time */
+#endif
+    bus_unlock(bus);
+    return true;
+#else
+    (void)bus;
+    (void)cfg;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_resume_subscriber(evt_bus_t *bus, evt_sub_handle_t handle)
+{
+#if EVT_BUS_CB_WATCHDOG
+    bus_lock(bus);
+    bool live = handle_is_live(bus, handle);
+    if (live) {
+        bus->wd_suspended[handle.id] = 0;
+        RELAXED_STORE(&bus->wd_strikes[handle.id], 0u);
+    }
+    bus_unlock(bus);
+    return live;
+#else
+    (void)bus;
+    (void)handle;
+    return false;
+#endif
+}
+
+bool evt_bus_inst_subscriber_suspended(evt_bus_t *bus, evt_sub_handle_t handle)
+{
+#if EVT_BUS_CB_WATCHDOG
+    bus_read_lock(bus);
+    bool suspended = handle_is_live(bus, handle) && bus->wd_suspended[handle.id];
+    bus_read_unlock(bus);
+    return suspended;
+#else
+    (void)bus;
+    (void)handle;
+    return false;
+#endif
+}
+
+uint32_t evt_bus_inst_evt_age_us(const evt_bus_t *bus, const evt_t *evt)
+{
+#if EVT_BUS_ENVELOPE_META
+    if (evt == NULL || bus->backend->now_us == NULL) return 0;
+    return bus_now_us(bus) - evt->ts_us;
+#else
+    (void)bus;
+    (void)evt;
+    return 0;
+#endif
+}
+
+bool evt_bus_inst_meta_stats(const evt_bus_t *bus, evt_meta_stats_t *out)
+{
+#if EVT_BUS_ENVELOPE_META
+    if (out == NULL) return false;
+    const evt_meta_stats_t *m = &bus->meta;
+    out->dispatched      = RELAXED_LOAD(&m->dispatched);
+    out->seq_gaps        = RELAXED_LOAD(&m->seq_gaps);
+    out->seq_reordered   = RELAXED_LOAD(&m->seq_reordered);
+    out->last_latency_us = RELAXED_LOAD(&m->last_latency_us);
+    out->max_latency_us  = RELAXED_LOAD(&m->max_latency_us);
+    return true;
+#else
+    (void)bus;
+    (void)out;
+    return false;
+#endif
+}
+
+evt_bus_t *evt_bus_default(void)
+{
+    return &default_bus;
+}
+
+void evt_bus_footprint(evt_bus_footprint_t *out)
+{
+    if (out == NULL) return;
+
+    out->bus           = sizeof(evt_bus_t);
+    out->subscribers   = sizeof(default_bus.subscriber_pool);
+    out->generations   = sizeof(default_bus.subscriber_gen);
+    out->subscriptions = sizeof(default_bus.subscriptions);
+    out->policies      = sizeof(default_bus.policies);
+#if EVT_BUS_MAX_PUBLISHERS > 0
+    out->publishers    = sizeof(default_bus.publishers);
+#else
+    out->publishers    = 0;
+#endif
+#if EVT_BUS_MAX_RETAINED > 0
+    out->retained      = sizeof(default_bus.retained_slot) + sizeof(default_bus.retained) +
+                         sizeof(default_bus.replay_pending);
+#else
+    out->retained      = 0;
+#endif
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    out->batches       = sizeof(default_bus.batches);
+#else
+    out->batches       = 0;
+#endif
+#if EVT_BUS_SUB_THROTTLE
+    out->throttles     = sizeof(default_bus.throttle);
+#else
+    out->throttles     = 0;
+#endif
+    out->envelope      = sizeof(evt_t);
+    out->handle        = sizeof(evt_sub_handle_t);
+}
+
+/* Default-instance API: thin wrappers over default_bus */
+
+void evt_bus_init(void){
+    assert(&evt_bus_backend != NULL && "no port defines evt_bus_backend");
+
+    /* default_bus starts zeroed in .bss: only a re-init has tables to clear */
+    if (default_bus.backend != NULL) {
+        memset(&default_bus, 0, sizeof(default_bus));
+    }
+    bool ok = bus_bind(&default_bus, &evt_bus_backend);
+    assert(ok && "evt_bus_backend init failed");
+    (void)ok;
+}
+
+evt_sub_handle_t evt_bus_subscribe(evt_id_t evt_id, evt_cb_t cb, void* user_ctx)
+{
+    return evt_bus_inst_subscribe(&default_bus, evt_id, cb, user_ctx);
+}
+
+bool evt_bus_subscribe_many(const evt_sub_req_t *reqs, size_t n, evt_sub_handle_t *out)
+{
+    return evt_bus_inst_subscribe_many(&default_bus, reqs, n, out);
+}
+
+void evt_bus_unsubscribe_many(const evt_sub_handle_t *handles, size_t n)
+{
+    evt_bus_inst_unsubscribe_many(&default_bus, handles, n);
+}
+
+void evt_bus_unsubscribe(evt_sub_handle_t handle){
+    evt_bus_inst_unsubscribe(&default_bus, handle);
+}
+
+bool evt_bus_publish(evt_id_t evt_id, const void *payload, size_t payload_len){
+    return evt_bus_inst_publish(&default_bus, evt_id, payload, payload_len);
+}
+
+bool evt_bus_publish_from_isr(evt_id_t evt_id, const void *payload, size_t payload_len)
+{
+    return evt_bus_inst_publish_from_isr(&default_bus, evt_id, payload, payload_len);
+}
+
+evt_pub_result_t evt_bus_publish_ex(evt_id_t evt_id, const void *payload, size_t payload_len)
+{
+    return evt_bus_inst_publish_ex(&default_bus, evt_id, payload, payload_len);
+}
+
+evt_pub_result_t evt_bus_publish_from_isr_ex(evt_id_t evt_id, const void *payload, size_t payload_len)
+{
+    return evt_bus_inst_publish_from_isr_ex(&default_bus, evt_id, payload, payload_len);
+}
+
+evt_pub_result_t evt_bus_publish_as(evt_pub_id_t pub, evt_id_t evt_id,
+                                    const void *payload, size_t payload_len)
+{
+    return evt_bus_inst_publish_as(&default_bus, pub, evt_id, payload, payload_len);
+}
+
+evt_pub_result_t evt_bus_publish_as_from_isr(evt_pub_id_t pub, evt_id_t evt_id,
+                                             const void *payload, size_t payload_len)
+{
+    return evt_bus_inst_publish_as_from_isr(&default_bus, pub, evt_id, payload, payload_len);
+}
+
+evt_pub_id_t evt_bus_publisher_register(const evt_pub_quota_t *quota)
+{
+    return evt_bus_inst_publisher_register(&default_bus, quota);
+}
+
+bool evt_bus_set_policy(evt_id_t evt_id, const evt_policy_t *policy)
+{
+    return evt_bus_inst_set_policy(&default_bus, evt_id, policy);
+}
+
+void evt_bus_set_reserved_slots(size_t slots)
+{
+    evt_bus_inst_set_reserved_slots(&default_bus, slots);
+}
+
+void evt_bus_set_tap(const evt_tap_t *tap)
+{
+    evt_bus_inst_set_tap(&default_bus, tap);
+}
+
+bool evt_bus_set_retained(evt_id_t evt_id)
+{
+    return evt_bus_inst_set_retained(&default_bus, evt_id);
+}
+
+bool evt_bus_get_retained(evt_id_t evt_id, evt_t *out)
+{
+    return evt_bus_inst_get_retained(&default_bus, evt_id, out);
+}
+
+bool evt_bus_set_dedup(evt_id_t evt_id, const evt_dedup_cfg_t *cfg)
+{
+    return evt_bus_inst_set_dedup(&default_bus, evt_id, cfg);
+}
+
+evt_sub_handle_t evt_bus_subscribe_retained(evt_id_t evt_id, evt_cb_t cb, void *user_ctx)
+{
+    return evt_bus_inst_subscribe_retained(&default_bus, evt_id, cb, user_ctx);
+}
+
+evt_sub_handle_t evt_bus_subscribe_batch(evt_id_t evt_id, evt_batch_cb_t cb,
+                                         const evt_batch_cfg_t *cfg, void *user_ctx)
+{
+    return evt_bus_inst_subscribe_batch(&default_bus, evt_id, cb, cfg, user_ctx);
+}
+
+evt_sub_handle_t evt_bus_subscribe_throttled(evt_id_t evt_id, evt_cb_t cb,
+                                             const evt_sub_throttle_t *cfg, void *user_ctx)
+{
+    return evt_bus_inst_subscribe_throttled(&default_bus, evt_id, cb, cfg, user_ctx);
+}
+
+void evt_bus_batch_poll(void)
+{
+    evt_bus_inst_batch_poll(&default_bus);
+}
+
+uint32_t evt_bus_batch_next_due_us(void)
+{
+    return evt_bus_inst_batch_next_due_us(&default_bus);
+}
+
+bool evt_bus_wait_for(evt_id_t evt_id, evt_t *out, uint32_t timeout_ms)
+{
+    return evt_bus_inst_wait_for(&default_bus, evt_id, out, timeout_ms);
+}
+
+evt_pub_result_t evt_bus_request(evt_id_t evt_id, const void *payload, size_t payload_len,
+                                 evt_t *reply, uint32_t timeout_ms)
+{
+    return evt_bus_inst_request(&default_bus, evt_id, payload, payload_len, reply, timeout_ms);
+}
+
+bool evt_bus_reply(const evt_t *request, const void *payload, size_t payload_len)
+{
+    return evt_bus_inst_reply(&default_bus, request, payload, payload_len);
+}
+
+bool evt_bus_ping(uint32_t *ticket)
+{
+    return evt_bus_inst_ping(&default_bus, ticket);
+}
+
+bool evt_bus_ping_acked(uint32_t ticket)
+{
+    return evt_bus_inst_ping_acked(&default_bus, ticket);
+}
+
+void evt_bus_liveness(evt_bus_liveness_t *out)
+{
+    evt_bus_inst_liveness(&default_bus, out);
+}
+
+bool evt_bus_set_cb_watchdog(const evt_cb_watchdog_t *cfg)
+{
+    return evt_bus_inst_set_cb_watchdog(&default_bus, cfg);
+}
+
+bool evt_bus_set_parallel(evt_id_t evt_id, bool parallel)
+{
+    return evt_bus_inst_set_parallel(&default_bus, evt_id, parallel);
+}
+
+bool evt_bus_resume_subscriber(evt_sub_handle_t handle)
+{
+    return evt_bus_inst_resume_subscriber(&default_bus, handle);
+}
+
+bool evt_bus_subscriber_suspended(evt_sub_handle_t handle)
+{
+    return evt_bus_inst_subscriber_suspended(&default_bus, handle);
+}
+
+uint32_t evt_bus_evt_age_us(const evt_t *evt)
+{
+    return evt_bus_inst_evt_age_us(&default_bus, evt);
+}
+
+bool evt_bus_meta_stats(evt_meta_stats_t *out)
+{
+    return evt_bus_inst_meta_stats(&default_bus, out);
+}
+
+void evt_bus_dispatch_evt(const evt_t *evt)
+{
+    evt_bus_inst_dispatch_evt(&default_bus, evt);
 }
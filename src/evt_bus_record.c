@@ -0,0 +1,222 @@
+#include "evt_bus/evt_bus_record.h"
+#include "evt_bus/evt_bus_config.h"
+
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+static const uint8_t rec_magic[4] = { 'E', 'V', 'T', 'R' };
+
+/* Local helpers */
+
+static size_t put_varint(uint8_t *out, uint32_t v)
+{
+    size_t n = 0;
+    while (v >= 0x80u) {
+        out[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+/* Returns EVT_REC_END only if the stream ends before the first byte */
+static evt_rec_status_t get_varint(const evt_rec_source_t *src, uint32_t *v)
+{
+    uint32_t acc = 0;
+
+    for (unsigned shift = 0; shift < 35u; shift += 7u) {
+        uint8_t b;
+        if (src->read(src->ctx, &b, 1) != 1) {
+            return (shift == 0) ? EVT_REC_END : EVT_REC_ERR_FORMAT;
+        }
+        acc |= (uint32_t)(b & 0x7Fu) << shift;
+        if ((b & 0x80u) == 0) {
+            *v = acc;
+            return EVT_REC_OK;
+        }
+    }
+    return EVT_REC_ERR_FORMAT;
+}
+
+static bool read_exact(const evt_rec_source_t *src, uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        size_t n = src->read(src->ctx, data, len);
+        if (n == 0) {
+            return false;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+static inline uint32_t bus_now_us(const evt_bus_t *bus)
+{
+    const evt_bus_backend_t *be = bus->backend;
+    return (be->now_us != NULL) ? be->now_us(be->ctx) : 0u;
+}
+
+/* -------- Recorder -------- */
+
+/* Dispatcher context: records arrive one at a time, in queue order */
+static void rec_tap(const evt_t *evt, void *ctx)
+{
+    evt_recorder_t *rec = (evt_recorder_t *)ctx;
+    uint8_t buf[EVT_REC_MAX_RECORD];
+
+#if EVT_BUS_ENVELOPE_META
+    const uint32_t now = evt->ts_us;
+#else
+    const uint32_t now = bus_now_us(rec->bus);
+#endif
+    /* Producers stamp before they enqueue: a later stamp may be queued first */
+    const uint32_t delta = ((int32_t)(now - rec->last_us) > 0) ? now - rec->last_us : 0u;
+
+    size_t n = evt_bus_rec_encode(buf, delta, evt);
+    if (rec->sink.write(rec->sink.ctx, buf, n)) {
+        rec->last_us += delta;
+        rec->records++;
+    } else {
+        rec->skipped++;
+    }
+}
+
+size_t evt_bus_rec_encode(uint8_t *out, uint32_t delta_us, const evt_t *evt)
+{
+    size_t n = put_varint(out, delta_us);
+    n += put_varint(out + n, evt->id);
+    n += put_varint(out + n, evt->len);
+    memcpy(out + n, evt->payload, evt->len);
+    return n + evt->len;
+}
+
+bool evt_bus_rec_start(evt_recorder_t *rec, evt_bus_t *bus, const evt_rec_sink_t *sink)
+{
+    if (rec == NULL || bus == NULL || bus->backend == NULL || sink == NULL || sink->write == NULL) {
+        return false;
+    }
+
+    uint8_t hdr[sizeof(rec_magic) + 1];
+    memcpy(hdr, rec_magic, sizeof(rec_magic));
+    hdr[sizeof(rec_magic)] = (uint8_t)EVT_REC_VERSION;
+
+    /* Detach first: @p rec may be the tap the dispatcher is running */
+    evt_bus_inst_set_tap(bus, NULL);
+    memset(rec, 0, sizeof(*rec));
+    rec->bus = bus;
+    rec->sink = *sink;
+    if (!sink->write(sink->ctx, hdr, sizeof(hdr))) {
+        return false;
+    }
+
+    rec->last_us = bus_now_us(bus);
+    rec->tap.fn = rec_tap;
+    rec->tap.ctx = rec;
+    evt_bus_inst_set_tap(bus, &rec->tap);
+    return true;
+}
+
+void evt_bus_rec_stop(evt_recorder_t *rec)
+{
+    if (rec == NULL || rec->bus == NULL) {
+        return;
+    }
+    evt_bus_inst_set_tap(rec->bus, NULL);
+}
+
+/* -------- Reader -------- */
+
+bool evt_bus_rec_read_header(const evt_rec_source_t *src)
+{
+    uint8_t hdr[sizeof(rec_magic) + 1];
+
+    if (src == NULL || src->read == NULL || !read_exact(src, hdr, sizeof(hdr))) {
+        return false;
+    }
+    return memcmp(hdr, rec_magic, sizeof(rec_magic)) == 0 &&
+           hdr[sizeof(rec_magic)] == EVT_REC_VERSION;
+}
+
+evt_rec_status_t evt_bus_rec_read_next(const evt_rec_source_t *src, evt_rec_entry_t *out)
+{
+    uint32_t delta, id, len;
+
+    evt_rec_status_t st = get_varint(src, &delta);
+    if (st != EVT_REC_OK) {
+        return st;
+    }
+    if (get_varint(src, &id) != EVT_REC_OK || get_varint(src, &len) != EVT_REC_OK) {
+        return EVT_REC_ERR_FORMAT;
+    }
+    /* Must fit the envelope of this build (EVT_BUS_COMPACT narrows it) */
+    if (id > (uint32_t)(evt_env_id_t)~0u || len > EVT_INLINE_MAX) {
+        return EVT_REC_ERR_FORMAT;
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->delta_us = delta;
+    out->evt.id = (evt_env_id_t)id;
+    out->evt.len = (evt_env_len_t)len;
+    if (!read_exact(src, out->evt.payload, len)) {
+        return EVT_REC_ERR_FORMAT;
+    }
+    return EVT_REC_OK;
+}
+
+/* -------- Replayer -------- */
+
+bool evt_bus_replay(evt_bus_t *bus, const evt_rec_source_t *src,
+                    const evt_replay_cfg_t *cfg, evt_replay_stats_t *stats)
+{
+    evt_replay_stats_t local;
+    if (stats == NULL) {
+        stats = &local;
+    }
+    memset(stats, 0, sizeof(*stats));
+    stats->status = EVT_REC_ERR_FORMAT;
+
+    if (bus == NULL || cfg == NULL ||
+        (cfg->mode == EVT_REPLAY_PACED && cfg->sleep_us == NULL)) {
+        return false;
+    }
+    if (!evt_bus_rec_read_header(src)) {
+        return false;
+    }
+
+    const bool paced = (cfg->mode == EVT_REPLAY_PACED);
+    const bool has_clock = (bus->backend != NULL && bus->backend->now_us != NULL);
+    const uint32_t t0 = has_clock ? bus_now_us(bus) : 0u;
+    uint32_t offset = 0;   /* recorded time of the current record, from the first one */
+    bool first = true;
+
+    evt_rec_entry_t e;
+    evt_rec_status_t st;
+    while ((st = evt_bus_rec_read_next(src, &e)) == EVT_REC_OK) {
+        if (paced) {
+            if (!first) {
+                offset += e.delta_us;
+            }
+            /* Absolute schedule when a clock exists: sleeping per delta would drift */
+            uint32_t wait = first ? 0u : e.delta_us;
+            if (has_clock) {
+                uint32_t elapsed = bus_now_us(bus) - t0;
+                wait = (offset > elapsed) ? (offset - elapsed) : 0u;
+            }
+            if (wait > 0) {
+                cfg->sleep_us(cfg->sleep_ctx, wait);
+            }
+        }
+        first = false;
+
+        if (evt_pub_ok(evt_bus_inst_publish_ex(bus, e.evt.id, e.evt.payload, e.evt.len))) {
+            stats->published++;
+        } else {
+            stats->rejected++;
+        }
+    }
+
+    stats->status = st;
+    return st == EVT_REC_END;
+}
@@ -0,0 +1,196 @@
+/* ========================================================================== */
+/* File: tests/bench_evt_bus_freertos.c                                       */
+/* ========================================================================== */
+/* Host benchmark of ports/freertos on the pthread FreeRTOS simulation:
+ *   latency    - publish -> callback, one event in flight (ping-pong)
+ *   throughput - back-to-back publishes (EVT_BP_BLOCK) until all are dispatched
+ *   contended  - throughput again while query tasks read a retained value in a loop
+ * Built once per EVT_BUS_FREERTOS_LOCK mode (bench_evt_bus_freertos[_spin|_rw]).
+ * Usage: bench_evt_bus_freertos [iterations]. Exit status != 0 if events were lost. */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus_port_freertos.h"
+
+#define EVT_PING  1
+#define EVT_BULK  2
+#define EVT_STATE 3
+
+#define QUERY_TASKS 2
+
+#if EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_SPIN
+#define LOCK_NAME "spin"
+#elif EVT_BUS_FREERTOS_LOCK == EVT_BUS_FREERTOS_LOCK_RW
+#define LOCK_NAME "rw"
+#else
+#define LOCK_NAME "mutex"
+#endif
+
+#if EVT_BUS_DIRECT_LANE
+#define LANE_NAME "+lane"
+#else
+#define LANE_NAME ""
+#endif
+
+static evt_bus_t          s_bus;
+static evt_bus_freertos_t s_port;
+
+static uint32_t *s_lat_ns;
+static uint32_t  s_received;   /* atomic: written by the dispatcher task */
+static uint32_t  s_query_run;  /* atomic: query tasks loop while != 0 */
+static uint32_t  s_query_live; /* atomic: query tasks still running */
+static uint32_t  s_queries;    /* atomic */
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void cb_ping(const evt_t *evt, void *user_ctx)
+{
+  (void)user_ctx;
+  uint64_t sent;
+  memcpy(&sent, evt->payload, sizeof(sent));
+  uint32_t n = __atomic_load_n(&s_received, __ATOMIC_RELAXED);
+  s_lat_ns[n] = (uint32_t)(now_ns() - sent);
+  __atomic_store_n(&s_received, n + 1, __ATOMIC_RELEASE);
+}
+
+static void cb_bulk(const evt_t *evt, void *user_ctx)
+{
+  (void)evt; (void)user_ctx;
+  __atomic_fetch_add(&s_received, 1u, __ATOMIC_RELEASE);
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static bool wait_received(uint32_t n)
+{
+  uint64_t deadline = now_ns() + 5000000000ull;
+  while (__atomic_load_n(&s_received, __ATOMIC_ACQUIRE) < n) {
+    if (now_ns() > deadline) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool bench_latency(uint32_t iters)
+{
+  s_lat_ns = calloc(iters, sizeof(*s_lat_ns));
+  if (s_lat_ns == NULL) return false;
+  __atomic_store_n(&s_received, 0u, __ATOMIC_RELAXED);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    uint64_t t = now_ns();
+    if (!evt_bus_inst_publish(&s_bus, EVT_PING, &t, sizeof(t)) || !wait_received(i + 1)) {
+      fprintf(stderr, "latency: event %u lost\n", (unsigned)i);
+      free(s_lat_ns);
+      return false;
+    }
+  }
+
+  qsort(s_lat_ns, iters, sizeof(*s_lat_ns), cmp_u32);
+  printf("latency    : n=%u p50=%.1fus p99=%.1fus max=%.1fus\n", (unsigned)iters,
+         s_lat_ns[iters / 2] / 1000.0,
+         s_lat_ns[(uint64_t)iters * 99u / 100u] / 1000.0,
+         s_lat_ns[iters - 1] / 1000.0);
+  free(s_lat_ns);
+  return true;
+}
+
+static void query_task(void *arg)
+{
+  (void)arg;
+  evt_t last;
+  while (__atomic_load_n(&s_query_run, __ATOMIC_ACQUIRE) != 0) {
+    (void)evt_bus_inst_get_retained(&s_bus, EVT_STATE, &last);
+    __atomic_fetch_add(&s_queries, 1u, __ATOMIC_RELAXED);
+  }
+  __atomic_fetch_sub(&s_query_live, 1u, __ATOMIC_RELEASE);
+}
+
+static bool bench_throughput(uint32_t iters, const char *name)
+{
+  const evt_policy_t block = { .mode = EVT_BP_BLOCK, .timeout_ms = 1000 };
+  evt_bus_inst_set_policy(&s_bus, EVT_BULK, &block);
+  __atomic_store_n(&s_received, 0u, __ATOMIC_RELAXED);
+
+  uint64_t t0 = now_ns();
+  for (uint32_t i = 0; i < iters; i++) {
+    if (!evt_bus_inst_publish(&s_bus, EVT_BULK, &i, sizeof(i))) {
+      fprintf(stderr, "throughput: publish %u rejected\n", (unsigned)i);
+      return false;
+    }
+  }
+  if (!wait_received(iters)) {
+    fprintf(stderr, "throughput: %u of %u dispatched\n",
+            (unsigned)__atomic_load_n(&s_received, __ATOMIC_ACQUIRE), (unsigned)iters);
+    return false;
+  }
+  double s = (double)(now_ns() - t0) / 1e9;
+  printf("%-11s: n=%u %.0f evt/s (queue depth %u)\n", name, (unsigned)iters, iters / s,
+         (unsigned)s_port.cfg.queue_depth);
+  return true;
+}
+
+static bool bench_contended(uint32_t iters)
+{
+  uint32_t state = 42;
+  evt_bus_inst_set_retained(&s_bus, EVT_STATE);
+  evt_bus_inst_publish(&s_bus, EVT_STATE, &state, sizeof(state));
+
+  __atomic_store_n(&s_query_run, 1u, __ATOMIC_RELEASE);
+  __atomic_store_n(&s_query_live, QUERY_TASKS, __ATOMIC_RELEASE);
+  __atomic_store_n(&s_queries, 0u, __ATOMIC_RELAXED);
+  for (int i = 0; i < QUERY_TASKS; i++) {
+    if (xTaskCreate(query_task, "query", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1,
+                    NULL) != pdPASS) {
+      fprintf(stderr, "contended: query task not created\n");
+      return false;
+    }
+  }
+
+  uint64_t t0 = now_ns();
+  bool ok = bench_throughput(iters, "contended");
+  double s = (double)(now_ns() - t0) / 1e9;
+
+  __atomic_store_n(&s_query_run, 0u, __ATOMIC_RELEASE);
+  while (__atomic_load_n(&s_query_live, __ATOMIC_ACQUIRE) != 0) {
+    vTaskDelay(1);
+  }
+  if (ok) {
+    printf("             %u query tasks: %.0f get_retained/s\n", QUERY_TASKS,
+           __atomic_load_n(&s_queries, __ATOMIC_RELAXED) / s);
+  }
+  return ok;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t iters = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 100000u;
+  if (iters == 0) iters = 1;
+
+  if (!evt_bus_freertos_inst_init(&s_port, &s_bus, NULL)) {
+    fprintf(stderr, "port init failed\n");
+    return 1;
+  }
+  evt_bus_inst_subscribe(&s_bus, EVT_PING, cb_ping, NULL);
+  evt_bus_inst_subscribe(&s_bus, EVT_BULK, cb_bulk, NULL);
+
+  printf("lock       : %s%s\n", LOCK_NAME, LANE_NAME);
+  bool ok = bench_latency(iters) && bench_throughput(iters, "throughput") &&
+            bench_contended(iters);
+  return ok ? 0 : 1;
+}
@@ -3,6 +3,7 @@
 /* File: tests/fake_evt_bus_backend.c                                         */
 /* ========================================================================== */
 #include <string.h>
+#include <stdint.h>
 #include "evt_bus/evt_bus.h"
 #include "evt_bus/evt_bus_config.h"
 
@@ -12,22 +13,73 @@
 fake_backend_state_t g_fake_backend;
 
 /* Backend functions */
-static bool fake_enqueue(const evt_t *evt)
+static bool fake_enqueue(void *ctx, const evt_t *evt)
 {
+  (void)ctx;
   g_fake_backend.enqueue_calls++;
 
   if (!g_fake_backend.enqueue_ret) return false;
   if (!evt) return false;
 
+  if (g_fake_backend.q_depth > 0) {
+    if (g_fake_backend.q_count >= g_fake_backend.q_depth) return false;
+    size_t tail = (g_fake_backend.q_head + g_fake_backend.q_count) % FAKE_QUEUE_MAX;
+    g_fake_backend.q[tail] = *evt;
+    g_fake_backend.q_count++;
+  }
+
   g_fake_backend.last_evt = *evt;   /* evt is POD w/ inline payload */
   g_fake_backend.has_evt = true;
   return true;
 }
 
+static bool fake_enqueue_timeout(void *ctx, const evt_t *evt, uint32_t timeout_ms)
+{
+  (void)ctx;
+  /* Host tests never block: record the request and try once */
+  g_fake_backend.enqueue_timeout_calls++;
+  g_fake_backend.last_timeout_ms = timeout_ms;
+  return fake_enqueue(ctx, evt);
+}
+
+static bool fake_drop_oldest(void *ctx, bool from_isr, evt_t *dropped)
+{
+  (void)ctx; (void)from_isr;
+  g_fake_backend.drop_oldest_calls++;
+  if (g_fake_backend.q_count == 0) return false;
+
+  *dropped = g_fake_backend.q[g_fake_backend.q_head];
+  g_fake_backend.q_head = (g_fake_backend.q_head + 1) % FAKE_QUEUE_MAX;
+  g_fake_backend.q_count--;
+  return true;
+}
+
+static size_t fake_free_slots(void *ctx, bool from_isr)
+{
+  (void)ctx; (void)from_isr;
+  if (g_fake_backend.q_depth == 0) return SIZE_MAX;
+  return g_fake_backend.q_depth - g_fake_backend.q_count;
+}
+
+static uint32_t fake_now_us(void *ctx)
+{
+  (void)ctx;
+  return g_fake_backend.now_us;
+}
+
 static bool fake_dequeue_nb(void *ctx, evt_t *evt_out)
 {
   (void)ctx;
   if (!evt_out) return false;
+
+  if (g_fake_backend.q_depth > 0) {
+    if (g_fake_backend.q_count == 0) return false;
+    *evt_out = g_fake_backend.q[g_fake_backend.q_head];
+    g_fake_backend.q_head = (g_fake_backend.q_head + 1) % FAKE_QUEUE_MAX;
+    g_fake_backend.q_count--;
+    return true;
+  }
+
   if (!g_fake_backend.has_evt) return false;
 
   *evt_out = g_fake_backend.last_evt;
@@ -41,6 +93,50 @@ static bool fake_dequeue_block(void *ctx, evt_t *evt_out)
   return fake_dequeue_nb(ctx, evt_out);
 }
 
+static void *fake_waiter_self(void *ctx)
+{
+  (void)ctx;
+  return &g_fake_backend;
+}
+
+static bool fake_waiter_sleep(void *ctx, uint32_t timeout_ms)
+{
+  (void)ctx;
+  g_fake_backend.waiter_sleeps++;
+  g_fake_backend.last_sleep_ms = timeout_ms;
+  if (g_fake_backend.on_sleep) g_fake_backend.on_sleep();
+
+  if (g_fake_backend.waiter_wakes == 0) return false;   /* "timed out" */
+  g_fake_backend.waiter_wakes--;
+  return true;
+}
+
+static void fake_waiter_wake(void *ctx, void *waiter)
+{
+  (void)ctx;
+  if (waiter == &g_fake_backend) g_fake_backend.waiter_wakes++;
+}
+
+/* Jobs are held until join, so tests see what was handed off and that join ran */
+static bool fake_fanout_start(void *ctx, unsigned worker, const evt_fanout_job_t *job)
+{
+  (void)ctx;
+  if (g_fake_backend.fanout_refuse || worker >= FAKE_FANOUT_MAX) return false;
+  g_fake_backend.fanout_jobs[g_fake_backend.fanout_pending++] = *job;
+  g_fake_backend.fanout_starts++;
+  return true;
+}
+
+static void fake_fanout_join(void *ctx)
+{
+  (void)ctx;
+  for (size_t i = 0; i < g_fake_backend.fanout_pending; i++) {
+    evt_bus_fanout_job_run(&g_fake_backend.fanout_jobs[i]);
+  }
+  g_fake_backend.fanout_pending = 0;
+  g_fake_backend.fanout_joins++;
+}
+
 static void fake_lock(void *ctx)
 {
   (void)ctx;
@@ -62,6 +158,15 @@ evt_bus_backend_t evt_bus_backend = {
   .dequeue_nb   = fake_dequeue_nb,
   .dequeue_block= fake_dequeue_block,
   .enqueue_isr  = NULL,
+  .enqueue_timeout = fake_enqueue_timeout,
+  .drop_oldest  = fake_drop_oldest,
+  .free_slots   = fake_free_slots,
+  .now_us       = fake_now_us,
+  .waiter_self  = fake_waiter_self,
+  .waiter_sleep = fake_waiter_sleep,
+  .waiter_wake  = fake_waiter_wake,
+  .fanout_start = fake_fanout_start,
+  .fanout_join  = fake_fanout_join,
   .lock         = fake_lock,
   .unlock       = fake_unlock,
 };
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+
+/* Host FreeRTOS simulation (pthreads): just enough kernel for ports/freertos.
+ * Tasks are detached threads scheduled by the host (priorities are ignored) with a
+ * task notification count,
+ * queues/mutexes are real and blocking, the tick follows CLOCK_MONOTONIC. */
+
+/* Core FreeRTOS scalar types */
+typedef int32_t  BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ 1000U
+#endif
+
+#ifndef configMINIMAL_STACK_SIZE
+#define configMINIMAL_STACK_SIZE 128U
+#endif
+
+#define configSUPPORT_STATIC_ALLOCATION 1
+
+#ifndef portTICK_PERIOD_MS
+#define portTICK_PERIOD_MS (1000U / configTICK_RATE_HZ)
+#endif
+
+#ifndef pdMS_TO_TICKS
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)((xTimeInMs) / portTICK_PERIOD_MS))
+#endif
+
+/* Status codes */
+#define pdPASS   (1)
+#define pdFAIL   (0)
+#define pdTRUE   (1)
+#define pdFALSE  (0)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffu)
+
+/* SMP critical sections in the ESP-IDF style: taskENTER_CRITICAL(&mux) spins on mux */
+typedef struct { int locked; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define portMUX_INITIALIZE(mux) ((mux)->locked = 0)
+#define portYIELD_FROM_ISR(x) do { (void)(x); } while (0)
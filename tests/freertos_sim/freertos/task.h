@@ -0,0 +1,34 @@
+#pragma once
+#include "FreeRTOS.h"
+
+typedef struct sim_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+/* Opaque storage for xTaskCreateStatic (the stack buffer is not used on the host) */
+typedef struct { void *opaque[32]; } StaticTask_t;
+
+#define tskIDLE_PRIORITY (0)
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName,
+                       const uint16_t usStackDepth, void * const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask);
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName,
+                               const uint32_t ulStackDepth, void * const pvParameters,
+                               UBaseType_t uxPriority, StackType_t * const puxStackBuffer,
+                               StaticTask_t * const pxTaskBuffer);
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+
+void vPortEnterCritical(portMUX_TYPE *mux);
+void vPortExitCritical(portMUX_TYPE *mux);
+#define taskENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux)  vPortExitCritical(mux)
+
+/* Any host thread may use these: threads not created by xTaskCreate* are adopted */
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+uint32_t     ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+BaseType_t   xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
@@ -0,0 +1,445 @@
+/* ========================================================================== */
+/* File: tests/freertos_sim/freertos_sim.c                                    */
+/* ========================================================================== */
+/* Host FreeRTOS simulation on pthreads: bounded blocking queues, mutexes and binary
+ * semaphores, spinning critical sections, detached task threads with notifications and a CLOCK_MONOTONIC tick. Enough to run
+ * ports/freertos unmodified in host tests and benchmarks. */
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+struct sim_queue {
+  pthread_mutex_t m;
+  pthread_cond_t  not_empty;
+  pthread_cond_t  not_full;
+  uint8_t        *storage;
+  size_t          item_size;
+  size_t          len;
+  size_t          head;
+  size_t          count;
+  bool            owned;      /* heap-allocated by xQueueCreate */
+};
+
+struct sim_mutex {
+  pthread_mutex_t m;
+  pthread_cond_t  cv;       /* binary semaphores only */
+  bool            binary;
+  bool            given;
+};
+
+struct sim_task {
+  pthread_t       th;
+  TaskFunction_t  fn;
+  void           *arg;
+
+  /* Notification value (ulTaskNotifyTake / xTaskNotifyGive) */
+  pthread_mutex_t nm;
+  pthread_cond_t  ncv;
+  uint32_t        notify;
+};
+
+_Static_assert(sizeof(struct sim_queue) <= sizeof(StaticQueue_t), "StaticQueue_t too small");
+_Static_assert(sizeof(struct sim_mutex) <= sizeof(StaticSemaphore_t), "StaticSemaphore_t too small");
+_Static_assert(sizeof(struct sim_task)  <= sizeof(StaticTask_t), "StaticTask_t too small");
+
+/* ------------------------------- Time ------------------------------------ */
+
+static struct timespec s_t0;
+static pthread_once_t  s_t0_once = PTHREAD_ONCE_INIT;
+
+static void t0_init(void) { clock_gettime(CLOCK_MONOTONIC, &s_t0); }
+
+TickType_t xTaskGetTickCount(void)
+{
+  pthread_once(&s_t0_once, t0_init);
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint64_t ms = (uint64_t)(now.tv_sec - s_t0.tv_sec) * 1000u +
+                (uint64_t)((now.tv_nsec - s_t0.tv_nsec) / 1000000);
+  return (TickType_t)(ms / portTICK_PERIOD_MS);
+}
+
+TickType_t xTaskGetTickCountFromISR(void) { return xTaskGetTickCount(); }
+
+static void deadline_after(clockid_t clk, TickType_t ticks, struct timespec *ts)
+{
+  uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000u;
+  clock_gettime(clk, ts);
+  ns += (uint64_t)ts->tv_nsec;
+  ts->tv_sec += (time_t)(ns / 1000000000u);
+  ts->tv_nsec = (long)(ns % 1000000000u);
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+  struct timespec ts;
+  deadline_after(CLOCK_MONOTONIC, xTicksToDelay, &ts);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+}
+
+/* ------------------------------- Queues ---------------------------------- */
+
+static void q_setup(struct sim_queue *q, UBaseType_t len, UBaseType_t item, uint8_t *storage)
+{
+  pthread_condattr_t ca;
+  pthread_condattr_init(&ca);
+  pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+
+  memset(q, 0, sizeof(*q));
+  pthread_mutex_init(&q->m, NULL);
+  pthread_cond_init(&q->not_empty, &ca);
+  pthread_cond_init(&q->not_full, &ca);
+  pthread_condattr_destroy(&ca);
+
+  q->storage   = storage;
+  q->item_size = item;
+  q->len       = len;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+  if (uxQueueLength == 0) return NULL;
+
+  struct sim_queue *q = malloc(sizeof(*q));
+  uint8_t *storage = malloc((size_t)uxQueueLength * uxItemSize);
+  if (q == NULL || storage == NULL) {
+    free(q);
+    free(storage);
+    return NULL;
+  }
+  q_setup(q, uxQueueLength, uxItemSize, storage);
+  q->owned = true;
+  return q;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize,
+                                 uint8_t *pucQueueStorage, StaticQueue_t *pxQueueBuffer)
+{
+  if (uxQueueLength == 0 || pucQueueStorage == NULL || pxQueueBuffer == NULL) return NULL;
+
+  struct sim_queue *q = (struct sim_queue *)(void *)pxQueueBuffer;
+  q_setup(q, uxQueueLength, uxItemSize, pucQueueStorage);
+  return q;
+}
+
+void vQueueDelete(QueueHandle_t q)
+{
+  pthread_cond_destroy(&q->not_full);
+  pthread_cond_destroy(&q->not_empty);
+  pthread_mutex_destroy(&q->m);
+  if (q->owned) {
+    free(q->storage);
+    free(q);
+  }
+}
+
+/* Wait (q->m held) until the queue has space / an item. 0 ticks never blocks. */
+static bool q_wait(struct sim_queue *q, pthread_cond_t *cv, bool for_space, TickType_t ticks)
+{
+  struct timespec ts;
+  if (ticks != 0 && ticks != portMAX_DELAY) {
+    deadline_after(CLOCK_MONOTONIC, ticks, &ts);
+  }
+
+  while (for_space ? (q->count == q->len) : (q->count == 0)) {
+    if (ticks == 0) {
+      return false;
+    }
+    if (ticks == portMAX_DELAY) {
+      pthread_cond_wait(cv, &q->m);
+    } else if (pthread_cond_timedwait(cv, &q->m, &ts) == ETIMEDOUT) {
+      return for_space ? (q->count < q->len) : (q->count > 0);
+    }
+  }
+  return true;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+  pthread_mutex_lock(&q->m);
+  if (!q_wait(q, &q->not_full, true, xTicksToWait)) {
+    pthread_mutex_unlock(&q->m);
+    return pdFAIL;   /* errQUEUE_FULL */
+  }
+  size_t tail = (q->head + q->count) % q->len;
+  memcpy(&q->storage[tail * q->item_size], pvItemToQueue, q->item_size);
+  q->count++;
+  pthread_cond_signal(&q->not_empty);
+  pthread_mutex_unlock(&q->m);
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *pvBuffer, TickType_t xTicksToWait)
+{
+  pthread_mutex_lock(&q->m);
+  if (!q_wait(q, &q->not_empty, false, xTicksToWait)) {
+    pthread_mutex_unlock(&q->m);
+    return pdFAIL;   /* errQUEUE_EMPTY */
+  }
+  memcpy(pvBuffer, &q->storage[q->head * q->item_size], q->item_size);
+  q->head = (q->head + 1u) % q->len;
+  q->count--;
+  pthread_cond_signal(&q->not_full);
+  pthread_mutex_unlock(&q->m);
+  return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void *pvItemToQueue,
+                             BaseType_t *pxHigherPriorityTaskWoken)
+{
+  if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+  return xQueueSend(q, pvItemToQueue, 0);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t q, void *pvBuffer,
+                                BaseType_t *pxHigherPriorityTaskWoken)
+{
+  if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+  return xQueueReceive(q, pvBuffer, 0);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+  pthread_mutex_lock(&q->m);
+  UBaseType_t n = (UBaseType_t)q->count;
+  pthread_mutex_unlock(&q->m);
+  return n;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t q) { return uxQueueMessagesWaiting(q); }
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q)
+{
+  pthread_mutex_lock(&q->m);
+  UBaseType_t n = (UBaseType_t)(q->len - q->count);
+  pthread_mutex_unlock(&q->m);
+  return n;
+}
+
+/* ------------------------- Mutexes / semaphores --------------------------- */
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *pxMutexBuffer)
+{
+  if (pxMutexBuffer == NULL) return NULL;
+
+  struct sim_mutex *mtx = (struct sim_mutex *)(void *)pxMutexBuffer;
+  memset(mtx, 0, sizeof(*mtx));
+  pthread_mutex_init(&mtx->m, NULL);
+  return mtx;
+}
+
+/* Starts empty, like FreeRTOS; any thread may give it */
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer)
+{
+  if (pxSemaphoreBuffer == NULL) return NULL;
+
+  struct sim_mutex *sem = (struct sim_mutex *)(void *)pxSemaphoreBuffer;
+  memset(sem, 0, sizeof(*sem));
+  pthread_condattr_t ca;
+  pthread_condattr_init(&ca);
+  pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+  pthread_mutex_init(&sem->m, NULL);
+  pthread_cond_init(&sem->cv, &ca);
+  pthread_condattr_destroy(&ca);
+  sem->binary = true;
+  return sem;
+}
+
+static BaseType_t sem_take(struct sim_mutex *sem, TickType_t xTicksToWait)
+{
+  struct timespec ts;
+  if (xTicksToWait != portMAX_DELAY) {
+    deadline_after(CLOCK_MONOTONIC, xTicksToWait, &ts);
+  }
+
+  pthread_mutex_lock(&sem->m);
+  int rc = 0;
+  while (!sem->given && rc == 0) {
+    if (xTicksToWait == portMAX_DELAY) {
+      rc = pthread_cond_wait(&sem->cv, &sem->m);
+    } else {
+      rc = pthread_cond_timedwait(&sem->cv, &sem->m, &ts);
+    }
+  }
+  const bool ok = sem->given;
+  sem->given = false;
+  pthread_mutex_unlock(&sem->m);
+  return ok ? pdPASS : pdFAIL;
+}
+
+static BaseType_t sem_give(struct sim_mutex *sem)
+{
+  pthread_mutex_lock(&sem->m);
+  const bool was_given = sem->given;
+  sem->given = true;
+  pthread_cond_signal(&sem->cv);
+  pthread_mutex_unlock(&sem->m);
+  return was_given ? pdFAIL : pdPASS;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mtx, TickType_t xTicksToWait)
+{
+  if (mtx->binary) {
+    return sem_take(mtx, xTicksToWait);
+  }
+  if (xTicksToWait == portMAX_DELAY) {
+    return (pthread_mutex_lock(&mtx->m) == 0) ? pdPASS : pdFAIL;
+  }
+  if (xTicksToWait == 0) {
+    return (pthread_mutex_trylock(&mtx->m) == 0) ? pdPASS : pdFAIL;
+  }
+  struct timespec ts;
+  deadline_after(CLOCK_REALTIME, xTicksToWait, &ts);
+  return (pthread_mutex_timedlock(&mtx->m, &ts) == 0) ? pdPASS : pdFAIL;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mtx)
+{
+  if (mtx->binary) {
+    return sem_give(mtx);
+  }
+  return (pthread_mutex_unlock(&mtx->m) == 0) ? pdPASS : pdFAIL;
+}
+
+/* --------------------------- Critical sections --------------------------- */
+
+/* Host threads can be preempted inside the section (an ESP32 core masks interrupts),
+ * so contended waiters yield instead of burning their time slice */
+void vPortEnterCritical(portMUX_TYPE *mux)
+{
+  while (__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE) != 0) {
+    while (__atomic_load_n(&mux->locked, __ATOMIC_RELAXED) != 0) {
+      sched_yield();
+    }
+  }
+}
+
+void vPortExitCritical(portMUX_TYPE *mux)
+{
+  __atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+/* -------------------------------- Tasks ---------------------------------- */
+
+static _Thread_local struct sim_task *t_self;
+
+static void task_setup(struct sim_task *t)
+{
+  pthread_condattr_t ca;
+  pthread_condattr_init(&ca);
+  pthread_condattr_setclock(&ca, CLOCK_MONOTONIC);
+
+  memset(t, 0, sizeof(*t));
+  pthread_mutex_init(&t->nm, NULL);
+  pthread_cond_init(&t->ncv, &ca);
+  pthread_condattr_destroy(&ca);
+}
+
+static void *task_entry(void *arg)
+{
+  struct sim_task *t = (struct sim_task *)arg;
+  t_self = t;
+  t->fn(t->arg);
+  return NULL;
+}
+
+static bool task_start(struct sim_task *t, TaskFunction_t fn, void *arg)
+{
+  task_setup(t);
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+  t->fn  = fn;
+  t->arg = arg;
+  bool ok = (pthread_create(&t->th, &attr, task_entry, t) == 0);
+  pthread_attr_destroy(&attr);
+  return ok;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char * const pcName,
+                       const uint16_t usStackDepth, void * const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask)
+{
+  (void)pcName; (void)usStackDepth; (void)uxPriority;
+
+  struct sim_task *t = malloc(sizeof(*t));
+  if (t == NULL || !task_start(t, pxTaskCode, pvParameters)) {
+    free(t);
+    return pdFAIL;
+  }
+  if (pxCreatedTask) *pxCreatedTask = t;
+  return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char * const pcName,
+                               const uint32_t ulStackDepth, void * const pvParameters,
+                               UBaseType_t uxPriority, StackType_t * const puxStackBuffer,
+                               StaticTask_t * const pxTaskBuffer)
+{
+  (void)pcName; (void)ulStackDepth; (void)uxPriority;
+
+  if (puxStackBuffer == NULL || pxTaskBuffer == NULL) return NULL;
+
+  struct sim_task *t = (struct sim_task *)(void *)pxTaskBuffer;
+  return task_start(t, pxTaskCode, pvParameters) ? t : NULL;
+}
+
+/* Host threads that were not created as tasks (e.g. the test main) get a TCB on first use */
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  if (t_self == NULL) {
+    struct sim_task *t = malloc(sizeof(*t));
+    if (t == NULL) return NULL;
+    task_setup(t);
+    t->th = pthread_self();
+    t_self = t;
+  }
+  return t_self;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+  struct sim_task *t = xTaskGetCurrentTaskHandle();
+  struct timespec ts;
+  if (xTicksToWait != 0 && xTicksToWait != portMAX_DELAY) {
+    deadline_after(CLOCK_MONOTONIC, xTicksToWait, &ts);
+  }
+
+  pthread_mutex_lock(&t->nm);
+  while (t->notify == 0 && xTicksToWait != 0) {
+    if (xTicksToWait == portMAX_DELAY) {
+      pthread_cond_wait(&t->ncv, &t->nm);
+    } else if (pthread_cond_timedwait(&t->ncv, &t->nm, &ts) == ETIMEDOUT) {
+      break;
+    }
+  }
+  uint32_t v = t->notify;
+  if (v > 0) {
+    t->notify = xClearCountOnExit ? 0u : v - 1u;
+  }
+  pthread_mutex_unlock(&t->nm);
+  return v;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t t)
+{
+  pthread_mutex_lock(&t->nm);
+  t->notify++;
+  pthread_cond_signal(&t->ncv);
+  pthread_mutex_unlock(&t->nm);
+  return pdPASS;
+}
@@ -7,6 +7,7 @@ typedef uint32_t UBaseType_t;
 
 /* Pick one; this is common for 32-bit ports */
 typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
 
 /* Config needed for time conversions */
 #ifndef configTICK_RATE_HZ
@@ -2,6 +2,7 @@
 #include "FreeRTOS.h"
 
 typedef void* QueueHandle_t;
+typedef struct { uint32_t dummy; } StaticQueue_t;
 
 static inline QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
 {
@@ -9,6 +10,13 @@ static inline QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t
   return (QueueHandle_t)0x1; /* non-NULL */
 }
 
+static inline QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize,
+                                               uint8_t *pucQueueStorage, StaticQueue_t *pxQueueBuffer)
+{
+  (void)uxQueueLength; (void)uxItemSize; (void)pucQueueStorage;
+  return (QueueHandle_t)pxQueueBuffer;
+}
+
 static inline BaseType_t xQueueSend(QueueHandle_t xQueue, const void * pvItemToQueue, uint32_t xTicksToWait)
 {
   (void)xQueue; (void)pvItemToQueue; (void)xTicksToWait;
@@ -28,3 +36,22 @@ static inline BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void * pv
   return pdPASS;
 }
 
+
+static inline BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void * pvBuffer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  (void)xQueue; (void)pvBuffer;
+  if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+  return pdFAIL; /* compile-only */
+}
+
+static inline UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue)
+{
+  (void)xQueue;
+  return 0;
+}
+
+static inline UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t xQueue)
+{
+  (void)xQueue;
+  return 0;
+}
@@ -10,6 +10,12 @@ static inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *p
   return (SemaphoreHandle_t)0x1;
 }
 
+static inline SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *pxSemaphoreBuffer)
+{
+  (void)pxSemaphoreBuffer;
+  return (SemaphoreHandle_t)0x1;
+}
+
 static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, uint32_t xTicksToWait)
 {
   (void)xSemaphore; (void)xTicksToWait;
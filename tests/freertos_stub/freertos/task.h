@@ -3,6 +3,7 @@
 
 typedef void* TaskHandle_t;
 typedef void (*TaskFunction_t)(void*);
+typedef struct { uint32_t dummy; } StaticTask_t;
 
 #define tskIDLE_PRIORITY (0)
 
@@ -20,9 +21,50 @@ static inline BaseType_t xTaskCreate(
   return pdPASS;
 }
 
+static inline TaskHandle_t xTaskCreateStatic(
+  TaskFunction_t pxTaskCode,
+  const char * const pcName,
+  const uint32_t ulStackDepth,
+  void * const pvParameters,
+  UBaseType_t uxPriority,
+  StackType_t * const puxStackBuffer,
+  StaticTask_t * const pxTaskBuffer
+){
+  (void)pxTaskCode; (void)pcName; (void)ulStackDepth;
+  (void)pvParameters; (void)uxPriority; (void)puxStackBuffer;
+  return (TaskHandle_t)pxTaskBuffer;
+}
+
+/* ---- Critical section stubs (single-core style, no spinlock argument) ---- */
+#define taskENTER_CRITICAL() do { } while (0)
+#define taskEXIT_CRITICAL()  do { } while (0)
+
+/* ---- Task notification stubs ---- */
+static inline TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+  return (TaskHandle_t)0x1;
+}
+
+static inline uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+  (void)xClearCountOnExit; (void)xTicksToWait;
+  return 0; /* compile-only */
+}
+
+static inline BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+  (void)xTaskToNotify;
+  return pdPASS;
+}
+
 /* ---- Tick counter stub ---- */
 static inline TickType_t xTaskGetTickCount(void)
 {
   static TickType_t fake_tick = 0;
   return fake_tick++;   /* monotonic, wrap-safe */
 }
+
+static inline TickType_t xTaskGetTickCountFromISR(void)
+{
+  return xTaskGetTickCount();
+}
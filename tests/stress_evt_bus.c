@@ -0,0 +1,592 @@
+/* ========================================================================== */
+/* File: tests/stress_evt_bus.c                                               */
+/* ========================================================================== */
+/* Multi-threaded stress of the core on a pthread backend (bounded queue, real bus lock,
+ * condition-variable waiters). Meant to run under ThreadSanitizer (EVT_BUS_TSAN=ON):
+ *   publishers - publish / publish_from_isr / publish_as on every ID, sentinel counted
+ *   churn      - subscribe / subscribe_throttled / subscribe_retained / unsubscribe
+ *                (including stale handles), second subscriber on the direct-lane ID
+ *   requesters - evt_bus_request() against a responder, reply checked
+ *   waiters    - evt_bus_wait_for() with short timeouts
+ *   monitor    - liveness pings, watchdog resume, retained reads, policy/dedup changes,
+ *                recorder start/stop (the sink must never run after evt_bus_rec_stop())
+ *   dispatcher - dequeue_block + evt_bus_inst_dispatch_evt until the queue drains
+ * Usage: stress_evt_bus [iterations] [mutex|rw]. Exit status != 0 if an invariant broke. */
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus/evt_bus_record.h"
+
+#define EVT_SENTINEL 0   /* one permanent subscriber, every accepted publish counted */
+#define EVT_CHURN0   1   /* 1..6: subscribers come and go */
+#define EVT_CHURN_N  6
+#define EVT_LANE     7   /* one permanent subscriber, a second one comes and goes */
+#define EVT_REQ      8   /* responder */
+#define EVT_WAIT     9   /* waiters only */
+
+#define PUBLISHERS  3
+#define CHURNERS    2
+#define REQUESTERS  2
+#define WAITERS     2
+#define CHURN_SUBS  8    /* live handles per churn thread */
+
+#define QUEUE_DEPTH 32u
+#define SUB_MAGIC   0x5ab5c71bu
+
+/* -------------------------------------------------------------------------- */
+/* pthread backend                                                            */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+  pthread_mutex_t  q_mtx;
+  pthread_cond_t   q_not_empty;
+  pthread_cond_t   q_not_full;
+  evt_t            q[QUEUE_DEPTH];
+  size_t           q_head;
+  size_t           q_count;
+  bool             q_stop;
+
+  bool             rw;
+  pthread_mutex_t  bus_mtx;
+  pthread_rwlock_t bus_rw;
+} stress_port_t;
+
+/* One per thread: waiter_self() token */
+typedef struct {
+  pthread_mutex_t mtx;
+  pthread_cond_t  cond;
+  unsigned        wakes;
+} stress_waiter_t;
+
+static _Thread_local stress_waiter_t *t_waiter;
+
+static stress_port_t s_port;
+static evt_bus_t     s_bus;
+
+static void deadline_in_ms(struct timespec *ts, uint32_t ms)
+{
+  clock_gettime(CLOCK_REALTIME, ts);
+  ts->tv_sec  += (time_t)(ms / 1000u);
+  ts->tv_nsec += (long)(ms % 1000u) * 1000000L;
+  if (ts->tv_nsec >= 1000000000L) {
+    ts->tv_sec++;
+    ts->tv_nsec -= 1000000000L;
+  }
+}
+
+/* Caller holds q_mtx */
+static bool q_push(stress_port_t *p, const evt_t *evt)
+{
+  if (p->q_count == QUEUE_DEPTH) return false;
+  p->q[(p->q_head + p->q_count) % QUEUE_DEPTH] = *evt;
+  p->q_count++;
+  pthread_cond_signal(&p->q_not_empty);
+  return true;
+}
+
+static bool sp_enqueue(void *ctx, const evt_t *evt)
+{
+  stress_port_t *p = (stress_port_t *)ctx;
+  pthread_mutex_lock(&p->q_mtx);
+  bool ok = q_push(p, evt);
+  pthread_mutex_unlock(&p->q_mtx);
+  return ok;
+}
+
+static bool sp_enqueue_timeout(void *ctx, const evt_t *evt, uint32_t timeout_ms)
+{
+  stress_port_t *p = (stress_port_t *)ctx;
+  struct timespec ts;
+  deadline_in_ms(&ts, timeout_ms);
+
+  pthread_mutex_lock(&p->q_mtx);
+  while (p->q_count == QUEUE_DEPTH) {
+    if (pthread_cond_timedwait(&p->q_not_full, &p->q_mtx, &ts) != 0) break;
+  }
+  bool ok = q_push(p, evt);
+  pthread_mutex_unlock(&p->q_mtx);
+  return ok;
+}
+
+static bool sp_dequeue(stress_port_t *p, evt_t *out, bool block)
+{
+  pthread_mutex_lock(&p->q_mtx);
+  while (block && p->q_count == 0 && !p->q_stop) {
+    pthread_cond_wait(&p->q_not_empty, &p->q_mtx);
+  }
+  bool ok = (p->q_count > 0);
+  if (ok) {
+    *out = p->q[p->q_head];
+    p->q_head = (p->q_head + 1u) % QUEUE_DEPTH;
+    p->q_count--;
+    pthread_cond_signal(&p->q_not_full);
+  }
+  pthread_mutex_unlock(&p->q_mtx);
+  return ok;
+}
+
+static bool sp_dequeue_block(void *ctx, evt_t *out) { return sp_dequeue((stress_port_t *)ctx, out, true); }
+static bool sp_dequeue_nb(void *ctx, evt_t *out)    { return sp_dequeue((stress_port_t *)ctx, out, false); }
+
+static uint32_t s_sentinel_evicted;   /* atomic */
+
+static bool sp_drop_oldest(void *ctx, bool from_isr, evt_t *dropped)
+{
+  (void)from_isr;
+  if (!sp_dequeue((stress_port_t *)ctx, dropped, false)) return false;
+  if (dropped->id == EVT_SENTINEL) {
+    __atomic_add_fetch(&s_sentinel_evicted, 1u, __ATOMIC_RELAXED);
+  }
+  return true;
+}
+
+static size_t sp_free_slots(void *ctx, bool from_isr)
+{
+  stress_port_t *p = (stress_port_t *)ctx;
+  (void)from_isr;
+  pthread_mutex_lock(&p->q_mtx);
+  size_t n = QUEUE_DEPTH - p->q_count;
+  pthread_mutex_unlock(&p->q_mtx);
+  return n;
+}
+
+static uint32_t sp_now_us(void *ctx)
+{
+  (void)ctx;
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+static void *sp_waiter_self(void *ctx)
+{
+  (void)ctx;
+  return t_waiter;
+}
+
+static bool sp_waiter_sleep(void *ctx, uint32_t timeout_ms)
+{
+  (void)ctx;
+  stress_waiter_t *w = t_waiter;
+  struct timespec ts;
+  deadline_in_ms(&ts, timeout_ms == EVT_BUS_WAIT_FOREVER ? 10000u : timeout_ms);
+
+  pthread_mutex_lock(&w->mtx);
+  while (w->wakes == 0) {
+    if (pthread_cond_timedwait(&w->cond, &w->mtx, &ts) != 0) break;
+  }
+  bool woken = (w->wakes > 0);
+  if (woken) w->wakes--;
+  pthread_mutex_unlock(&w->mtx);
+  return woken;
+}
+
+static void sp_waiter_wake(void *ctx, void *waiter)
+{
+  (void)ctx;
+  stress_waiter_t *w = (stress_waiter_t *)waiter;
+  pthread_mutex_lock(&w->mtx);
+  w->wakes++;
+  pthread_cond_signal(&w->cond);
+  pthread_mutex_unlock(&w->mtx);
+}
+
+static void sp_lock(void *ctx)
+{
+  stress_port_t *p = (stress_port_t *)ctx;
+  if (p->rw) pthread_rwlock_wrlock(&p->bus_rw);
+  else       pthread_mutex_lock(&p->bus_mtx);
+}
+
+static void sp_unlock(void *ctx)
+{
+  stress_port_t *p = (stress_port_t *)ctx;
+  if (p->rw) pthread_rwlock_unlock(&p->bus_rw);
+  else       pthread_mutex_unlock(&p->bus_mtx);
+}
+
+static void sp_read_lock(void *ctx)   { pthread_rwlock_rdlock(&((stress_port_t *)ctx)->bus_rw); }
+static void sp_read_unlock(void *ctx) { pthread_rwlock_unlock(&((stress_port_t *)ctx)->bus_rw); }
+
+static evt_bus_backend_t s_backend = {
+  .ctx             = &s_port,
+  .enqueue         = sp_enqueue,
+  .dequeue_block   = sp_dequeue_block,
+  .dequeue_nb      = sp_dequeue_nb,
+  .enqueue_isr     = sp_enqueue,
+  .enqueue_timeout = sp_enqueue_timeout,
+  .drop_oldest     = sp_drop_oldest,
+  .free_slots      = sp_free_slots,
+  .now_us          = sp_now_us,
+  .waiter_self     = sp_waiter_self,
+  .waiter_sleep    = sp_waiter_sleep,
+  .waiter_wake     = sp_waiter_wake,
+  .lock            = sp_lock,
+  .unlock          = sp_unlock,
+};
+
+/* -------------------------------------------------------------------------- */
+/* Workload                                                                   */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+  uint32_t magic;     /* SUB_MAGIC while the owning thread may still be subscribed */
+  uint32_t calls;     /* atomic */
+} sub_ctx_t;
+
+static uint32_t s_iters;
+static uint32_t s_failures;        /* atomic */
+static uint32_t s_sentinel_sent;   /* atomic: accepted sentinel publishes */
+static uint32_t s_sentinel_seen;   /* dispatcher only */
+static uint32_t s_replies;         /* atomic */
+static uint32_t s_run = 1u;        /* atomic: background threads loop while != 0 */
+static evt_pub_id_t s_quota_pub;
+static uint32_t s_rec_live;        /* atomic: set before evt_bus_rec_start(), cleared after stop */
+static uint32_t s_rec_in_sink;     /* atomic: sink calls in progress */
+static uint32_t s_rec_records;     /* monitor only */
+
+#define FAIL(...) do { \
+    fprintf(stderr, __VA_ARGS__); \
+    __atomic_add_fetch(&s_failures, 1u, __ATOMIC_RELAXED); \
+  } while (0)
+
+/* Recorder sink: only the dispatcher calls it, and never once the recorder is stopped */
+static bool rec_sink_write(void *ctx, const uint8_t *data, size_t len)
+{
+  (void)ctx;
+  (void)data;
+  if (__atomic_add_fetch(&s_rec_in_sink, 1u, __ATOMIC_ACQ_REL) != 1u) {
+    FAIL("recorder sink entered concurrently\n");
+  }
+  if (len > EVT_REC_MAX_RECORD) {
+    FAIL("recorder wrote %u bytes\n", (unsigned)len);
+  }
+  sched_yield();   /* widen the window for a stop racing this write */
+  if (!__atomic_load_n(&s_rec_live, __ATOMIC_ACQUIRE)) {
+    FAIL("recorder sink called after stop\n");
+  }
+  __atomic_sub_fetch(&s_rec_in_sink, 1u, __ATOMIC_ACQ_REL);
+  return true;
+}
+
+static uint32_t xorshift(uint32_t *s)
+{
+  uint32_t x = *s;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *s = x;
+}
+
+static void check_evt(const evt_t *evt)
+{
+  if (evt->id >= EVT_BUS_MAX_EVT_IDS || evt->len > EVT_INLINE_MAX) {
+    FAIL("bad envelope id=%u len=%u\n", (unsigned)evt->id, (unsigned)evt->len);
+  }
+}
+
+static void cb_sentinel(const evt_t *evt, void *user_ctx)
+{
+  (void)user_ctx;
+  check_evt(evt);
+  s_sentinel_seen++;
+}
+
+static void cb_count(const evt_t *evt, void *user_ctx)
+{
+  sub_ctx_t *c = (sub_ctx_t *)user_ctx;
+  check_evt(evt);
+  if (__atomic_load_n(&c->magic, __ATOMIC_RELAXED) != SUB_MAGIC) {
+    FAIL("callback with a foreign context on evt %u\n", (unsigned)evt->id);
+  }
+  __atomic_add_fetch(&c->calls, 1u, __ATOMIC_RELAXED);
+}
+
+static void cb_responder(const evt_t *evt, void *user_ctx)
+{
+  (void)user_ctx;
+  uint32_t v;
+  memcpy(&v, evt->payload, sizeof(v));
+  v++;
+  if (!evt_bus_inst_reply(&s_bus, evt, &v, sizeof(v))) {
+    /* The requester may already have timed out: not an error */
+  }
+}
+
+static void *publisher_main(void *arg)
+{
+  uint32_t seed = 0x9e3779b9u * (uint32_t)(uintptr_t)arg + 1u;
+
+  for (uint32_t i = 0; i < s_iters; i++) {
+    const uint32_t r = xorshift(&seed);
+    const evt_id_t id = (evt_id_t)(r % (EVT_WAIT + 1u));
+    uint8_t payload[EVT_INLINE_MAX];
+    const size_t len = (r >> 8) % (EVT_INLINE_MAX + 1u);
+    memset(payload, (int)(r >> 16), sizeof(payload));
+
+    evt_pub_result_t res;
+    switch ((r >> 24) % 4u) {
+      case 0:  res = evt_bus_inst_publish_from_isr_ex(&s_bus, id, payload, len); break;
+      case 1:  res = evt_bus_inst_publish_as(&s_bus, s_quota_pub, id, payload, len); break;
+      default: res = evt_bus_inst_publish_ex(&s_bus, id, payload, len); break;
+    }
+    if (id == EVT_SENTINEL && (res == EVT_PUB_OK)) {
+      __atomic_add_fetch(&s_sentinel_sent, 1u, __ATOMIC_RELAXED);
+    }
+    if (res == EVT_PUB_ERR_INVALID || res == EVT_PUB_ERR_NO_BACKEND) {
+      FAIL("publish on evt %u: result %d\n", (unsigned)id, (int)res);
+    }
+    if (!evt_pub_ok(res)) {
+      sched_yield();   /* let the dispatcher make room */
+    }
+  }
+  return NULL;
+}
+
+static void *churn_main(void *arg)
+{
+  static sub_ctx_t ctxs[CHURNERS][CHURN_SUBS];
+  const unsigned me = (unsigned)(uintptr_t)arg;
+  uint32_t seed = 0x85ebca6bu * (me + 1u);
+  evt_sub_handle_t live[CHURN_SUBS];
+  evt_sub_handle_t stale[CHURN_SUBS];
+  const evt_sub_throttle_t thr = { .every_n = 3, .min_interval_us = 50 };
+
+  for (unsigned k = 0; k < CHURN_SUBS; k++) {
+    ctxs[me][k].magic = SUB_MAGIC;
+    live[k].id = EVT_HANDLE_ID_INVALID;
+    stale[k].id = EVT_HANDLE_ID_INVALID;
+  }
+
+  for (uint32_t i = 0; i < s_iters; i++) {
+    const uint32_t r = xorshift(&seed);
+    const unsigned k = r % CHURN_SUBS;
+    sub_ctx_t *c = &ctxs[me][k];
+
+    if (live[k].id != EVT_HANDLE_ID_INVALID) {
+      evt_bus_inst_unsubscribe(&s_bus, live[k]);
+      stale[k] = live[k];
+      live[k].id = EVT_HANDLE_ID_INVALID;
+      continue;
+    }
+
+    /* Stale handles must stay a no-op, even once their slot is reused */
+    evt_bus_inst_unsubscribe(&s_bus, stale[k]);
+
+    const evt_id_t id = (k == 0) ? (evt_id_t)EVT_LANE
+                                 : (evt_id_t)(EVT_CHURN0 + (r >> 8) % EVT_CHURN_N);
+    switch ((r >> 16) % 3u) {
+      case 0:  live[k] = evt_bus_inst_subscribe_throttled(&s_bus, id, cb_count, &thr, c); break;
+      case 1:  live[k] = evt_bus_inst_subscribe_retained(&s_bus, id, cb_count, c); break;
+      default: live[k] = evt_bus_inst_subscribe(&s_bus, id, cb_count, c); break;
+    }
+  }
+
+  for (unsigned k = 0; k < CHURN_SUBS; k++) {
+    evt_bus_inst_unsubscribe(&s_bus, live[k]);
+  }
+  return NULL;
+}
+
+static void *requester_main(void *arg)
+{
+  stress_waiter_t w = { .wakes = 0 };
+  pthread_mutex_init(&w.mtx, NULL);
+  pthread_cond_init(&w.cond, NULL);
+  t_waiter = &w;
+
+  uint32_t v = (uint32_t)(uintptr_t)arg << 24;
+  for (uint32_t i = 0; i < s_iters / 16u + 1u; i++, v++) {
+    evt_t reply;
+    const evt_pub_result_t r = evt_bus_inst_request(&s_bus, EVT_REQ, &v, sizeof(v), &reply, 50);
+    if (r == EVT_PUB_OK) {
+      uint32_t got;
+      memcpy(&got, reply.payload, sizeof(got));
+      if (reply.id != EVT_REQ || reply.len != sizeof(got) || got != v + 1u) {
+        FAIL("request %08x: reply %08x (id %u len %u)\n", (unsigned)v, (unsigned)got,
+             (unsigned)reply.id, (unsigned)reply.len);
+      }
+      __atomic_add_fetch(&s_replies, 1u, __ATOMIC_RELAXED);
+    } else if (r != EVT_PUB_ERR_FULL && r != EVT_PUB_ERR_NO_SLOT && r != EVT_PUB_ERR_NO_REPLY) {
+      FAIL("request %08x: result %d\n", (unsigned)v, (int)r);
+    }
+  }
+
+  t_waiter = NULL;
+  pthread_cond_destroy(&w.cond);
+  pthread_mutex_destroy(&w.mtx);
+  return NULL;
+}
+
+static void *waiter_main(void *arg)
+{
+  (void)arg;
+  stress_waiter_t w = { .wakes = 0 };
+  pthread_mutex_init(&w.mtx, NULL);
+  pthread_cond_init(&w.cond, NULL);
+  t_waiter = &w;
+
+  while (__atomic_load_n(&s_run, __ATOMIC_ACQUIRE)) {
+    evt_t out;
+    if (evt_bus_inst_wait_for(&s_bus, EVT_WAIT, &out, 2) && out.id != EVT_WAIT) {
+      FAIL("waiter got evt %u\n", (unsigned)out.id);
+    }
+  }
+
+  t_waiter = NULL;
+  pthread_cond_destroy(&w.cond);
+  pthread_mutex_destroy(&w.mtx);
+  return NULL;
+}
+
+static void *monitor_main(void *arg)
+{
+  (void)arg;
+  static evt_recorder_t rec;
+  const evt_rec_sink_t sink = { .write = rec_sink_write };
+  stress_waiter_t w = { .wakes = 0 };   /* evt_bus_rec_stop() may sleep */
+  pthread_mutex_init(&w.mtx, NULL);
+  pthread_cond_init(&w.cond, NULL);
+  t_waiter = &w;
+  uint32_t seed = 0xc2b2ae35u;
+  const evt_dedup_cfg_t dedup = { .window_us = 100 };
+  const evt_policy_t oldest = { .mode = EVT_BP_DROP_OLDEST };
+  const evt_policy_t block = { .mode = EVT_BP_BLOCK, .timeout_ms = 1 };
+
+  while (__atomic_load_n(&s_run, __ATOMIC_ACQUIRE)) {
+    const uint32_t r = xorshift(&seed);
+    const evt_id_t id = (evt_id_t)(EVT_CHURN0 + r % EVT_CHURN_N);
+    evt_t out;
+    evt_bus_liveness_t lv;
+    evt_meta_stats_t ms;
+    evt_sub_handle_t h = { .id = (hndl_id_t)((r >> 8) % EVT_BUS_MAX_HANDLES), .gen = (hndl_gen_t)(r >> 16) };
+
+    switch ((r >> 24) % 7u) {
+      case 0: (void)evt_bus_inst_ping(&s_bus, NULL); evt_bus_inst_liveness(&s_bus, &lv); break;
+      case 1: (void)evt_bus_inst_get_retained(&s_bus, EVT_CHURN0, &out); break;
+      case 2: (void)evt_bus_inst_set_dedup(&s_bus, id, (r & 1u) ? &dedup : NULL); break;
+      case 3: (void)evt_bus_inst_set_policy(&s_bus, id, (r & 1u) ? &oldest : &block); break;
+      case 4: (void)evt_bus_inst_resume_subscriber(&s_bus, h); break;
+      case 5:
+        if (__atomic_load_n(&s_rec_live, __ATOMIC_RELAXED)) {
+          evt_bus_rec_stop(&rec);
+          __atomic_store_n(&s_rec_live, 0u, __ATOMIC_RELEASE);
+          s_rec_records += rec.records;
+        } else {
+          __atomic_store_n(&s_rec_live, 1u, __ATOMIC_RELEASE);
+          (void)evt_bus_rec_start(&rec, &s_bus, &sink);
+        }
+        break;
+      default: (void)evt_bus_inst_meta_stats(&s_bus, &ms); break;
+    }
+    sched_yield();
+  }
+
+  if (__atomic_load_n(&s_rec_live, __ATOMIC_RELAXED)) {
+    evt_bus_rec_stop(&rec);
+    __atomic_store_n(&s_rec_live, 0u, __ATOMIC_RELEASE);
+    s_rec_records += rec.records;
+  }
+  t_waiter = NULL;
+  pthread_cond_destroy(&w.cond);
+  pthread_mutex_destroy(&w.mtx);
+  return NULL;
+}
+
+static void *dispatcher_main(void *arg)
+{
+  (void)arg;
+  evt_t evt;
+  while (sp_dequeue_block(&s_port, &evt)) {
+    evt_bus_inst_dispatch_evt(&s_bus, &evt);
+  }
+  return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static pthread_t spawn(void *(*fn)(void *), uintptr_t arg)
+{
+  pthread_t t;
+  if (pthread_create(&t, NULL, fn, (void *)arg) != 0) {
+    fprintf(stderr, "pthread_create failed\n");
+    exit(1);
+  }
+  return t;
+}
+
+int main(int argc, char **argv)
+{
+  s_iters = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 100000u;
+  s_port.rw = (argc > 2) && strcmp(argv[2], "rw") == 0;
+
+  pthread_mutex_init(&s_port.q_mtx, NULL);
+  pthread_cond_init(&s_port.q_not_empty, NULL);
+  pthread_cond_init(&s_port.q_not_full, NULL);
+  pthread_mutex_init(&s_port.bus_mtx, NULL);
+  pthread_rwlock_init(&s_port.bus_rw, NULL);
+  if (s_port.rw) {
+    s_backend.read_lock   = sp_read_lock;
+    s_backend.read_unlock = sp_read_unlock;
+  }
+
+  if (!evt_bus_inst_init(&s_bus, &s_backend)) {
+    fprintf(stderr, "bus init failed\n");
+    return 1;
+  }
+
+  const evt_pub_quota_t quota = { .max_inflight = 4, .rate_per_sec = 100000, .burst = 16 };
+  const evt_cb_watchdog_t wd = { .budget_us = 2000, .strikes = 2, .auto_suspend = true };
+  static sub_ctx_t lane_ctx = { .magic = SUB_MAGIC };
+  s_quota_pub = evt_bus_inst_publisher_register(&s_bus, &quota);
+  (void)evt_bus_inst_set_cb_watchdog(&s_bus, &wd);
+  (void)evt_bus_inst_set_retained(&s_bus, EVT_CHURN0);
+  evt_bus_inst_subscribe(&s_bus, EVT_SENTINEL, cb_sentinel, NULL);
+  evt_bus_inst_subscribe(&s_bus, EVT_LANE, cb_count, &lane_ctx);
+  evt_bus_inst_subscribe(&s_bus, EVT_REQ, cb_responder, NULL);
+
+  pthread_t dispatcher = spawn(dispatcher_main, 0);
+  pthread_t bg[WAITERS + 1];
+  pthread_t fg[PUBLISHERS + CHURNERS + REQUESTERS];
+  size_t n_bg = 0, n_fg = 0;
+
+  for (uintptr_t i = 0; i < WAITERS; i++)    bg[n_bg++] = spawn(waiter_main, i);
+  bg[n_bg++] = spawn(monitor_main, 0);
+  for (uintptr_t i = 0; i < PUBLISHERS; i++) fg[n_fg++] = spawn(publisher_main, i);
+  for (uintptr_t i = 0; i < CHURNERS; i++)   fg[n_fg++] = spawn(churn_main, i);
+  for (uintptr_t i = 0; i < REQUESTERS; i++) fg[n_fg++] = spawn(requester_main, i + 1u);
+
+  for (size_t i = 0; i < n_fg; i++) pthread_join(fg[i], NULL);
+  __atomic_store_n(&s_run, 0u, __ATOMIC_RELEASE);
+  for (size_t i = 0; i < n_bg; i++) pthread_join(bg[i], NULL);
+
+  /* Let the dispatcher drain what is left, then stop it */
+  pthread_mutex_lock(&s_port.q_mtx);
+  s_port.q_stop = true;
+  pthread_cond_broadcast(&s_port.q_not_empty);
+  pthread_mutex_unlock(&s_port.q_mtx);
+  pthread_join(dispatcher, NULL);
+
+  /* Drop-oldest on the churn IDs may evict sentinel events from the queue head */
+  const uint32_t sent = __atomic_load_n(&s_sentinel_sent, __ATOMIC_RELAXED);
+  const uint32_t evicted = __atomic_load_n(&s_sentinel_evicted, __ATOMIC_RELAXED);
+  if (s_sentinel_seen != sent - evicted) {
+    FAIL("sentinel: %u accepted, %u evicted, %u dispatched\n",
+         (unsigned)sent, (unsigned)evicted, (unsigned)s_sentinel_seen);
+  }
+
+  printf("stress (%s): %u iterations, sentinel %u, replies %u, lane subscriber %u calls, "
+         "%u recorded\n",
+         s_port.rw ? "rw" : "mutex", (unsigned)s_iters, (unsigned)sent,
+         (unsigned)__atomic_load_n(&s_replies, __ATOMIC_RELAXED),
+         (unsigned)__atomic_load_n(&lane_ctx.calls, __ATOMIC_RELAXED),
+         (unsigned)s_rec_records);
+  return s_failures == 0 ? 0 : 1;
+}
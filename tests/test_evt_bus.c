@@ -2,6 +2,7 @@
 /* ========================================================================== */
 /* File: tests/test_evt_bus.c                                                 */
 /* ========================================================================== */
+#include <stddef.h>
 #include <string.h>
 #include "unity.h"
 
@@ -269,6 +270,1897 @@ static void test_unsubscribe_stale_handle_is_noop_and_does_not_affect_new_sub(vo
     TEST_ASSERT_EQUAL_INT_MESSAGE(1, probe2.calls, "stale unsubscribe likely nuked the new subscriber");
 }
 
+/* ----------------------------- Bulk (un)subscribe ------------------------- */
+
+static void test_subscribe_many_takes_lock_once(void)
+{
+    cb_probe_t a = {0}, b = {0}, c = {0};
+    const evt_sub_req_t reqs[] = {
+        { .evt_id = 1, .cb = cb_probe, .user_ctx = &a },
+        { .evt_id = 2, .cb = cb_probe, .user_ctx = &b },
+        { .evt_id = 2, .cb = cb_probe, .user_ctx = &c },
+    };
+    evt_sub_handle_t hs[3];
+
+    int locks = g_fake_backend.lock_calls;
+    TEST_ASSERT_TRUE(evt_bus_subscribe_many(reqs, 3, hs));
+    TEST_ASSERT_EQUAL_INT(locks + 1, g_fake_backend.lock_calls);
+
+    TEST_ASSERT_TRUE(evt_bus_publish(2, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(0, a.calls);
+    TEST_ASSERT_EQUAL_INT(1, b.calls);
+    TEST_ASSERT_EQUAL_INT(1, c.calls);
+
+    /* Stale and invalid entries are skipped */
+    const evt_sub_handle_t bad = { .id = EVT_HANDLE_ID_INVALID, .gen = 0 };
+    const evt_sub_handle_t drop[] = { hs[0], bad, hs[2], hs[0] };
+    locks = g_fake_backend.lock_calls;
+    evt_bus_unsubscribe_many(drop, 4);
+    TEST_ASSERT_EQUAL_INT(locks + 1, g_fake_backend.lock_calls);
+
+    TEST_ASSERT_TRUE(evt_bus_publish(2, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(2, b.calls);
+    TEST_ASSERT_EQUAL_INT(1, c.calls);
+}
+
+static void test_subscribe_many_rolls_back_on_capacity(void)
+{
+    cb_probe_t p = {0}, q = {0};
+
+    /* Leave one slot on ID 4 */
+    for (size_t i = 0; i + 1 < EVT_BUS_MAX_SUBSCRIBERS_PER_EVT; i++) {
+        TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe(4, cb_probe, &p).id);
+    }
+
+    const evt_sub_req_t reqs[] = {
+        { .evt_id = 5, .cb = cb_probe, .user_ctx = &q },
+        { .evt_id = 4, .cb = cb_probe, .user_ctx = &q },
+        { .evt_id = 4, .cb = cb_probe, .user_ctx = &q },
+    };
+    evt_sub_handle_t hs[3];
+    TEST_ASSERT_FALSE(evt_bus_subscribe_many(reqs, 3, hs));
+    for (size_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, hs[i].id);
+    }
+
+    /* Nothing from the failed batch is visible, and no capacity leaked */
+    TEST_ASSERT_TRUE(evt_bus_publish(5, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_TRUE(evt_bus_publish(4, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(0, q.calls);
+    TEST_ASSERT_TRUE(evt_bus_subscribe_many(reqs, 2, hs));
+}
+
+static void test_subscribe_many_rejects_bad_args_without_locking(void)
+{
+    cb_probe_t p = {0};
+    const evt_sub_req_t reqs[] = {
+        { .evt_id = 1, .cb = cb_probe, .user_ctx = &p },
+        { .evt_id = 1, .cb = NULL,     .user_ctx = &p },
+    };
+    evt_sub_handle_t hs[2];
+
+    const int locks = g_fake_backend.lock_calls;
+    TEST_ASSERT_FALSE(evt_bus_subscribe_many(reqs, 2, hs));
+    TEST_ASSERT_FALSE(evt_bus_subscribe_many(NULL, 1, hs));
+    TEST_ASSERT_FALSE(evt_bus_subscribe_many(reqs, 1, NULL));
+    TEST_ASSERT_EQUAL_INT(locks, g_fake_backend.lock_calls);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, hs[0].id);
+
+    TEST_ASSERT_TRUE(evt_bus_subscribe_many(NULL, 0, NULL));
+    evt_bus_unsubscribe_many(NULL, 3);
+}
+
+/* ------------------------- Backpressure policies -------------------------- */
+
+static evt_pub_result_t publish_u8(evt_id_t id, uint8_t v)
+{
+    return evt_bus_publish_ex(id, &v, sizeof(v));
+}
+
+static void test_default_policy_is_drop_new(void)
+{
+    g_fake_backend.q_depth = 2;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 2));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, publish_u8(1, 3));
+    TEST_ASSERT_FALSE(evt_bus_publish((evt_id_t)1, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.drop_oldest_calls);
+}
+
+static void test_publish_ex_reports_invalid_args(void)
+{
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_INVALID, evt_bus_publish_ex((evt_id_t)1, NULL, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_INVALID, evt_bus_publish_ex((evt_id_t)EVT_BUS_MAX_EVT_IDS, NULL, 0));
+    /* Fake backend has no ISR enqueue */
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_BACKEND, evt_bus_publish_from_isr_ex((evt_id_t)1, NULL, 0));
+}
+
+static void test_drop_oldest_evicts_head(void)
+{
+    const evt_policy_t pol = { .mode = EVT_BP_DROP_OLDEST };
+    evt_t out;
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)2, &pol));
+    g_fake_backend.q_depth = 2;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(2, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(2, 2));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(2, 3));
+    TEST_ASSERT_TRUE(evt_bus_publish((evt_id_t)2, NULL, 0)); /* still accepted */
+
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &out));
+    TEST_ASSERT_EQUAL_UINT8(3, out.payload[0]);
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &out));
+    TEST_ASSERT_EQUAL_UINT16(0, out.len);
+}
+
+static void test_block_policy_passes_timeout(void)
+{
+    const evt_policy_t pol = { .mode = EVT_BP_BLOCK, .timeout_ms = 50 };
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)3, &pol));
+    g_fake_backend.q_depth = 1;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(3, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_TIMEOUT, publish_u8(3, 2));
+    TEST_ASSERT_EQUAL_INT(2, g_fake_backend.enqueue_timeout_calls);
+    TEST_ASSERT_EQUAL_UINT32(50, g_fake_backend.last_timeout_ms);
+}
+
+static void test_reserved_slots_kept_for_critical_ids(void)
+{
+    const evt_policy_t crit = { .mode = EVT_BP_DROP_NEW, .critical = true };
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)9, &crit));
+    evt_bus_set_reserved_slots(2);
+    g_fake_backend.q_depth = 4;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 2));
+    /* Bulk traffic stops at the reservation... */
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_RESERVED, publish_u8(1, 3));
+    /* ...critical traffic still gets in */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(9, 4));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(9, 5));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, publish_u8(9, 6));
+}
+
+static void test_drop_oldest_respects_reservation(void)
+{
+    const evt_policy_t pol  = { .mode = EVT_BP_DROP_OLDEST };
+    const evt_policy_t crit = { .mode = EVT_BP_DROP_NEW, .critical = true };
+    evt_t out;
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)2, &pol));
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)9, &crit));
+    evt_bus_set_reserved_slots(2);
+    g_fake_backend.q_depth = 4;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(2, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(2, 2));
+    /* Evicting the head frees a slot above the reservation */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(2, 3));
+    TEST_ASSERT_EQUAL_size_t(2, g_fake_backend.q_count);
+
+    /* Once critical IDs hold the reservation, one eviction is not enough: keep the queue */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(9, 4));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(9, 5));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_RESERVED, publish_u8(2, 6));
+    TEST_ASSERT_EQUAL_INT(1, g_fake_backend.drop_oldest_calls);
+
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &out));
+    TEST_ASSERT_EQUAL_UINT8(2, out.payload[0]);
+}
+
+static void sleep_drains_one(void)
+{
+    evt_t out;
+    (void)evt_bus_backend.dequeue_nb(NULL, &out);
+}
+
+static void test_block_waits_for_room_above_reservation(void)
+{
+    const evt_policy_t pol = { .mode = EVT_BP_BLOCK, .timeout_ms = 5 };
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)3, &pol));
+    evt_bus_set_reserved_slots(2);
+    g_fake_backend.q_depth = 3;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    /* Only the reservation is free: poll until the dispatcher drains a slot */
+    g_fake_backend.on_sleep = sleep_drains_one;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(3, 2));
+    TEST_ASSERT_EQUAL_INT(1, g_fake_backend.waiter_sleeps);
+    TEST_ASSERT_EQUAL_UINT32(EVT_BUS_RESERVE_POLL_MS, g_fake_backend.last_sleep_ms);
+    TEST_ASSERT_EQUAL_INT(1, g_fake_backend.enqueue_timeout_calls);
+    TEST_ASSERT_EQUAL_UINT32(5u - EVT_BUS_RESERVE_POLL_MS, g_fake_backend.last_timeout_ms);
+}
+
+static void test_block_reserved_times_out(void)
+{
+    const evt_policy_t pol = { .mode = EVT_BP_BLOCK, .timeout_ms = 5 };
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)3, &pol));
+    evt_bus_set_reserved_slots(2);
+    g_fake_backend.q_depth = 3;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_RESERVED, publish_u8(3, 2));
+    TEST_ASSERT_EQUAL_INT(5 / EVT_BUS_RESERVE_POLL_MS, g_fake_backend.waiter_sleeps);
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.enqueue_timeout_calls);
+    TEST_ASSERT_EQUAL_size_t(1, g_fake_backend.q_count);
+}
+
+static void test_set_policy_rejects_bad_args(void)
+{
+    const evt_policy_t bad = { .mode = 0x7F };
+    TEST_ASSERT_FALSE(evt_bus_set_policy((evt_id_t)EVT_BUS_MAX_EVT_IDS, NULL));
+    TEST_ASSERT_FALSE(evt_bus_set_policy((evt_id_t)1, &bad));
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)1, NULL));
+}
+
+/* ---------------------------- Publisher quotas ---------------------------- */
+
+static void dispatch_next(void)
+{
+    evt_t evt;
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &evt));
+    evt_bus_dispatch_evt(&evt);
+}
+
+static void test_publisher_inflight_quota_released_on_dispatch(void)
+{
+    const evt_pub_quota_t q = { .max_inflight = 2 };
+    evt_pub_id_t pub = evt_bus_publisher_register(&q);
+    TEST_ASSERT_NOT_EQUAL(EVT_PUB_ID_NONE, pub);
+    g_fake_backend.q_depth = 8;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_QUOTA, evt_bus_publish_as(pub, 1, NULL, 0));
+
+    /* Other publishers still get queue space */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_ex(1, NULL, 0));
+
+    dispatch_next();
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+}
+
+static void test_publisher_quota_not_consumed_by_rejected_publish(void)
+{
+    const evt_pub_quota_t q = { .max_inflight = 1 };
+    evt_pub_id_t pub = evt_bus_publisher_register(&q);
+    g_fake_backend.q_depth = 8;
+
+    g_fake_backend.enqueue_ret = false;
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, evt_bus_publish_as(pub, 1, NULL, 0));
+
+    g_fake_backend.enqueue_ret = true;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+}
+
+static void test_publisher_quota_released_on_drop_oldest(void)
+{
+    const evt_pub_quota_t q = { .max_inflight = 1 };
+    const evt_policy_t pol = { .mode = EVT_BP_DROP_OLDEST };
+    evt_pub_id_t pub = evt_bus_publisher_register(&q);
+
+    TEST_ASSERT_TRUE(evt_bus_set_policy(2, &pol));
+    g_fake_backend.q_depth = 1;
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, evt_bus_publish_ex(2, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, evt_bus_publish_as(pub, 2, NULL, 0));
+}
+
+static void test_publisher_token_bucket_rate_limit(void)
+{
+    const evt_pub_quota_t q = { .rate_per_sec = 10, .burst = 2 };
+    g_fake_backend.now_us = 1000;
+    evt_pub_id_t pub = evt_bus_publisher_register(&q);
+    TEST_ASSERT_NOT_EQUAL(EVT_PUB_ID_NONE, pub);
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_RATE, evt_bus_publish_as(pub, 1, NULL, 0));
+
+    /* 10/s => one token per 100 ms; 150 ms earns one and keeps the remainder */
+    g_fake_backend.now_us += 150000;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_RATE, evt_bus_publish_as(pub, 1, NULL, 0));
+    g_fake_backend.now_us += 50000;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+
+    /* Long idle refills to burst only */
+    g_fake_backend.now_us += 10000000;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(pub, 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_RATE, evt_bus_publish_as(pub, 1, NULL, 0));
+}
+
+static void test_publisher_register_limits(void)
+{
+    const evt_pub_quota_t no_burst = { .rate_per_sec = 10 };
+    const evt_pub_quota_t q = { .max_inflight = 1 };
+
+    TEST_ASSERT_EQUAL(EVT_PUB_ID_NONE, evt_bus_publisher_register(NULL));
+    TEST_ASSERT_EQUAL(EVT_PUB_ID_NONE, evt_bus_publisher_register(&no_burst));
+
+    for (unsigned i = 0; i < EVT_BUS_MAX_PUBLISHERS; i++) {
+        TEST_ASSERT_NOT_EQUAL(EVT_PUB_ID_NONE, evt_bus_publisher_register(&q));
+    }
+    TEST_ASSERT_EQUAL(EVT_PUB_ID_NONE, evt_bus_publisher_register(&q));
+
+    /* Unknown tokens are rejected, anonymous publish still works */
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_INVALID, evt_bus_publish_as((evt_pub_id_t)(EVT_BUS_MAX_PUBLISHERS + 1), 1, NULL, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_as(EVT_PUB_ID_NONE, 1, NULL, 0));
+}
+
+/* ------------------------------ Waiters ---------------------------------- */
+
+#if EVT_BUS_MAX_WAITERS > 0
+static evt_id_t s_sleep_publish_id;
+
+/* Runs while the waiter "blocks": publish + dispatch like the bus task would */
+static void sleep_publishes(void)
+{
+    const uint8_t v = 0x42;
+    TEST_ASSERT_TRUE(evt_bus_publish(s_sleep_publish_id, &v, sizeof(v)));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+static void sleep_publishes_on_second_call(void)
+{
+    if (g_fake_backend.waiter_sleeps == 2) sleep_publishes();
+}
+
+static void test_wait_for_returns_event_dispatched_while_blocked(void)
+{
+    cb_probe_t p = {0};
+    evt_bus_subscribe(5, cb_probe, &p);
+
+    s_sleep_publish_id = 5;
+    g_fake_backend.on_sleep = sleep_publishes;
+
+    evt_t out;
+    memset(&out, 0, sizeof(out));
+    TEST_ASSERT_TRUE(evt_bus_wait_for(5, &out, 100));
+    TEST_ASSERT_EQUAL_UINT16(5, out.id);
+    TEST_ASSERT_EQUAL_UINT16(1, out.len);
+    TEST_ASSERT_EQUAL_UINT8(0x42, out.payload[0]);
+    TEST_ASSERT_EQUAL_UINT32(100, g_fake_backend.last_sleep_ms);
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.waiter_wakes);
+
+    /* Subscribers still get the event; the waiter took no subscriber handle */
+    TEST_ASSERT_EQUAL_INT(1, p.calls);
+    TEST_ASSERT_EQUAL_UINT16(1, evt_bus_subscribe(6, cb_probe, &p).id);
+}
+
+static void test_wait_for_times_out_and_releases_slot(void)
+{
+    /* Other IDs do not complete the wait */
+    s_sleep_publish_id = 6;
+    g_fake_backend.on_sleep = sleep_publishes;
+    for (unsigned i = 0; i < EVT_BUS_MAX_WAITERS + 1u; i++) {
+        TEST_ASSERT_FALSE(evt_bus_wait_for(5, NULL, 10));
+    }
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.waiter_wakes);
+
+    /* Slots were released: a later wait still works */
+    s_sleep_publish_id = 5;
+    TEST_ASSERT_TRUE(evt_bus_wait_for(5, NULL, EVT_BUS_WAIT_FOREVER));
+    TEST_ASSERT_EQUAL_UINT32(EVT_BUS_WAIT_FOREVER, g_fake_backend.last_sleep_ms);
+}
+
+static void test_wait_for_ignores_stale_wake(void)
+{
+    s_sleep_publish_id = 5;
+    g_fake_backend.on_sleep = sleep_publishes_on_second_call;
+    g_fake_backend.waiter_wakes = 1;   /* left over from an earlier wait */
+
+    TEST_ASSERT_TRUE(evt_bus_wait_for(5, NULL, 100));
+    TEST_ASSERT_EQUAL_INT(2, g_fake_backend.waiter_sleeps);
+}
+
+static void test_wait_for_rejects_bad_args_and_missing_hooks(void)
+{
+    TEST_ASSERT_FALSE(evt_bus_wait_for(EVT_BUS_MAX_EVT_IDS, NULL, 10));
+
+    void *(*self)(void *) = evt_bus_backend.waiter_self;
+    evt_bus_backend.waiter_self = NULL;
+    TEST_ASSERT_FALSE(evt_bus_wait_for(1, NULL, 10));
+    evt_bus_backend.waiter_self = self;
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.waiter_sleeps);
+}
+#endif
+
+/* --------------------------- Request / response -------------------------- */
+
+#if EVT_BUS_MAX_REQUESTS > 0
+static evt_t s_last_request;
+static int   s_sleep_depth;
+
+/* Responder: answers with the request byte + 1 */
+static void cb_responder(const evt_t *evt, void *user_ctx)
+{
+    (void)user_ctx;
+    const uint8_t v = (uint8_t)(evt->payload[0] + 1u);
+    s_last_request = *evt;
+    TEST_ASSERT_TRUE(evt_bus_reply(evt, &v, sizeof(v)));
+}
+
+/* Runs while the caller "blocks": the bus task dispatches the queued request */
+static void sleep_dispatches_request(void)
+{
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+/* Runs while the caller "blocks": more requests from other tasks until the pool is empty */
+static void sleep_requests_again(void)
+{
+    if (++s_sleep_depth < (int)EVT_BUS_MAX_REQUESTS) {
+        TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_REPLY, evt_bus_request(8, NULL, 0, NULL, 10));
+    } else {
+        TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_SLOT, evt_bus_request(8, NULL, 0, NULL, 10));
+    }
+}
+
+static void test_request_gets_reply_without_queue_round_trip(void)
+{
+    evt_bus_subscribe(7, cb_responder, NULL);
+    g_fake_backend.on_sleep = sleep_dispatches_request;
+
+    const uint8_t q = 0x10;
+    evt_t reply;
+    memset(&reply, 0, sizeof(reply));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_request(7, &q, sizeof(q), &reply, 100));
+    TEST_ASSERT_EQUAL_UINT16(7, reply.id);
+    TEST_ASSERT_EQUAL_UINT16(1, reply.len);
+    TEST_ASSERT_EQUAL_UINT8(0x11, reply.payload[0]);
+    TEST_ASSERT_EQUAL(EVT_CORR_NONE, reply.corr);
+    TEST_ASSERT_EQUAL_UINT32(100, g_fake_backend.last_sleep_ms);
+    TEST_ASSERT_EQUAL_INT(1, g_fake_backend.enqueue_calls);   /* the request only */
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.waiter_wakes);
+
+    /* Every request gets a fresh correlation ID; an answered one cannot be answered again */
+    const evt_t first = s_last_request;
+    TEST_ASSERT_NOT_EQUAL(EVT_CORR_NONE, first.corr);
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_request(7, &q, sizeof(q), NULL, 100));
+    TEST_ASSERT_NOT_EQUAL(first.corr, s_last_request.corr);
+    TEST_ASSERT_FALSE(evt_bus_reply(&first, NULL, 0));
+
+    /* Plain publishes carry no correlation ID: nothing to answer */
+    TEST_ASSERT_TRUE(evt_bus_publish(9, &q, sizeof(q)));
+    TEST_ASSERT_EQUAL(EVT_CORR_NONE, g_fake_backend.last_evt.corr);
+    TEST_ASSERT_FALSE(evt_bus_reply(&g_fake_backend.last_evt, NULL, 0));
+#if EVT_BUS_MAX_DEDUP > 0
+
+    /* Identical requests are never deduplicated */
+    const evt_dedup_cfg_t dedup = { .window_us = 0 };
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(7, &dedup));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_request(7, &q, sizeof(q), NULL, 100));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_request(7, &q, sizeof(q), NULL, 100));
+#endif
+}
+
+static void test_request_times_out_and_releases_slot(void)
+{
+    /* Nobody answers */
+    g_fake_backend.on_sleep = sleep_dispatches_request;
+    for (unsigned i = 0; i < EVT_BUS_MAX_REQUESTS + 1u; i++) {
+        TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_REPLY, evt_bus_request(7, NULL, 0, NULL, 10));
+    }
+
+    /* A late reply finds the slot released and wakes nobody */
+    TEST_ASSERT_FALSE(evt_bus_reply(&g_fake_backend.last_evt, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.waiter_wakes);
+
+    /* A rejected publish never sleeps and keeps no slot */
+    g_fake_backend.enqueue_ret = false;
+    g_fake_backend.waiter_sleeps = 0;
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, evt_bus_request(7, NULL, 0, NULL, 10));
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.waiter_sleeps);
+    g_fake_backend.enqueue_ret = true;
+
+    evt_bus_subscribe(7, cb_responder, NULL);
+    const uint8_t q = 1;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_request(7, &q, sizeof(q), NULL, EVT_BUS_WAIT_FOREVER));
+}
+
+static void test_request_pool_exhaustion(void)
+{
+    s_sleep_depth = 0;
+    g_fake_backend.on_sleep = sleep_requests_again;
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_REPLY, evt_bus_request(8, NULL, 0, NULL, 10));
+    TEST_ASSERT_EQUAL_INT((int)EVT_BUS_MAX_REQUESTS, s_sleep_depth);
+    /* The request without a slot was never queued */
+    TEST_ASSERT_EQUAL_INT((int)EVT_BUS_MAX_REQUESTS, g_fake_backend.enqueue_calls);
+    TEST_ASSERT_FALSE(evt_pub_ok(EVT_PUB_ERR_NO_SLOT));
+}
+
+static void test_request_rejects_bad_args_and_missing_hooks(void)
+{
+    uint8_t big[EVT_INLINE_MAX + 1u] = {0};
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_INVALID, evt_bus_request(EVT_BUS_MAX_EVT_IDS, NULL, 0, NULL, 10));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_INVALID, evt_bus_request(1, big, sizeof(big), NULL, 10));
+    TEST_ASSERT_FALSE(evt_bus_reply(NULL, NULL, 0));
+
+    void (*wake)(void *, void *) = evt_bus_backend.waiter_wake;
+    evt_bus_backend.waiter_wake = NULL;
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_BACKEND, evt_bus_request(1, NULL, 0, NULL, 10));
+    evt_bus_backend.waiter_wake = wake;
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.enqueue_calls);
+
+    /* Oversized reply: the caller keeps waiting */
+    evt_t req;
+    memset(&req, 0, sizeof(req));
+    req.id = 1;
+    req.corr = 1u | (1u << 8);
+    TEST_ASSERT_FALSE(evt_bus_reply(&req, big, sizeof(big)));
+    req.corr = (evt_corr_t)(EVT_BUS_MAX_REQUESTS + 1u) | (1u << 8);
+    TEST_ASSERT_FALSE(evt_bus_reply(&req, NULL, 0));
+}
+#else
+static void test_request_disabled(void)
+{
+    evt_t req;
+    memset(&req, 0, sizeof(req));
+    TEST_ASSERT_EQUAL(EVT_PUB_ERR_NO_BACKEND, evt_bus_request(1, NULL, 0, NULL, 10));
+    TEST_ASSERT_FALSE(evt_bus_reply(&req, NULL, 0));
+}
+#endif
+
+/* ------------------------- Slow-callback watchdog ------------------------- */
+
+#if EVT_BUS_CB_WATCHDOG
+typedef struct {
+    uint32_t cost_us;    /* fake time spent per call */
+    int      calls;
+} costly_t;
+
+static void cb_costly(const evt_t *evt, void *user_ctx)
+{
+    (void)evt;
+    costly_t *c = (costly_t*)user_ctx;
+    c->calls++;
+    g_fake_backend.now_us += c->cost_us;
+}
+
+typedef struct {
+    int              reports;
+    evt_sub_handle_t handle;
+    evt_id_t         evt_id;
+    uint32_t         elapsed_us;
+    bool             suspended;
+} overrun_probe_t;
+
+static void on_overrun(evt_sub_handle_t handle, evt_id_t evt_id, uint32_t elapsed_us,
+                       bool suspended, void *hook_ctx)
+{
+    overrun_probe_t *p = (overrun_probe_t*)hook_ctx;
+    p->reports++;
+    p->handle = handle;
+    p->evt_id = evt_id;
+    p->elapsed_us = elapsed_us;
+    p->suspended = suspended;
+}
+
+static void test_watchdog_suspends_repeat_offender(void)
+{
+    costly_t slow = { .cost_us = 500 }, fast = { .cost_us = 10 };
+    overrun_probe_t rep = {0};
+    const evt_cb_watchdog_t wd = {
+        .budget_us = 100, .strikes = 2, .auto_suspend = true,
+        .on_overrun = on_overrun, .hook_ctx = &rep,
+    };
+    TEST_ASSERT_TRUE(evt_bus_set_cb_watchdog(&wd));
+
+    evt_sub_handle_t hs = evt_bus_subscribe(3, cb_costly, &slow);
+    evt_bus_subscribe(3, cb_costly, &fast);
+    evt_t e;
+    memset(&e, 0, sizeof(e));
+    e.id = 3;
+
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_EQUAL_INT(0, rep.reports);
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_EQUAL_INT(1, rep.reports);
+    TEST_ASSERT_EQUAL_UINT16(hs.id, rep.handle.id);
+    TEST_ASSERT_EQUAL_UINT16(hs.gen, rep.handle.gen);
+    TEST_ASSERT_EQUAL_UINT16(3, rep.evt_id);
+    TEST_ASSERT_EQUAL_UINT32(500, rep.elapsed_us);
+    TEST_ASSERT_TRUE(rep.suspended);
+    TEST_ASSERT_TRUE(evt_bus_subscriber_suspended(hs));
+
+    /* Suspended: skipped, the others still run */
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_EQUAL_INT(2, slow.calls);
+    TEST_ASSERT_EQUAL_INT(3, fast.calls);
+
+    TEST_ASSERT_TRUE(evt_bus_resume_subscriber(hs));
+    TEST_ASSERT_FALSE(evt_bus_subscriber_suspended(hs));
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_EQUAL_INT(3, slow.calls);
+    TEST_ASSERT_EQUAL_INT(1, rep.reports);   /* strikes restarted from 0 */
+
+    /* Handle slot reuse starts clean */
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_TRUE(evt_bus_subscriber_suspended(hs));
+    evt_bus_unsubscribe(hs);
+    evt_sub_handle_t h2 = evt_bus_subscribe(3, cb_costly, &fast);
+    TEST_ASSERT_EQUAL_UINT16(hs.id, h2.id);
+    TEST_ASSERT_FALSE(evt_bus_subscriber_suspended(h2));
+    TEST_ASSERT_FALSE(evt_bus_resume_subscriber(hs));
+}
+
+static void test_watchdog_report_only_needs_consecutive_overruns(void)
+{
+    costly_t c = { .cost_us = 200 };
+    overrun_probe_t rep = {0};
+    const evt_cb_watchdog_t wd = {
+        .budget_us = 100, .strikes = 2, .on_overrun = on_overrun, .hook_ctx = &rep,
+    };
+    TEST_ASSERT_TRUE(evt_bus_set_cb_watchdog(&wd));
+
+    evt_sub_handle_t h = evt_bus_subscribe(1, cb_costly, &c);
+    evt_t e;
+    memset(&e, 0, sizeof(e));
+    e.id = 1;
+
+    evt_bus_dispatch_evt(&e);          /* over */
+    c.cost_us = 50;
+    evt_bus_dispatch_evt(&e);          /* within: strikes reset */
+    c.cost_us = 200;
+    evt_bus_dispatch_evt(&e);          /* over */
+    TEST_ASSERT_EQUAL_INT(0, rep.reports);
+    evt_bus_dispatch_evt(&e);          /* over, second in a row */
+    TEST_ASSERT_EQUAL_INT(1, rep.reports);
+    TEST_ASSERT_FALSE(rep.suspended);
+    TEST_ASSERT_FALSE(evt_bus_subscriber_suspended(h));
+    TEST_ASSERT_EQUAL_INT(4, c.calls);
+
+    /* Disabled: no timing */
+    TEST_ASSERT_TRUE(evt_bus_set_cb_watchdog(NULL));
+    evt_bus_dispatch_evt(&e);
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_EQUAL_INT(1, rep.reports);
+}
+
+static void test_watchdog_requires_clock(void)
+{
+    const evt_cb_watchdog_t wd = { .budget_us = 100 };
+    uint32_t (*now_us)(void *) = evt_bus_backend.now_us;
+
+    evt_bus_backend.now_us = NULL;
+    TEST_ASSERT_FALSE(evt_bus_set_cb_watchdog(&wd));
+    TEST_ASSERT_TRUE(evt_bus_set_cb_watchdog(NULL));
+    evt_bus_backend.now_us = now_us;
+}
+#endif
+
+/* ---------------------------- Envelope metadata --------------------------- */
+
+#if EVT_BUS_ENVELOPE_META
+static uint32_t s_age_in_cb;
+
+static void cb_age(const evt_t *evt, void *user_ctx)
+{
+    (void)user_ctx;
+    s_age_in_cb = evt_bus_evt_age_us(evt);
+}
+
+static evt_t meta_evt(uint32_t seq, uint32_t ts_us)
+{
+    evt_t e;
+    memset(&e, 0, sizeof(e));
+    e.id = 1;
+    e.seq = seq;
+    e.ts_us = ts_us;
+    return e;
+}
+
+static void test_envelope_meta_stamps_seq_and_latency(void)
+{
+    g_fake_backend.q_depth = FAKE_QUEUE_MAX;
+    evt_bus_subscribe(1, cb_age, NULL);
+
+    g_fake_backend.now_us = 1000;
+    TEST_ASSERT_TRUE(evt_bus_publish(1, NULL, 0));
+    g_fake_backend.now_us = 1200;
+    TEST_ASSERT_TRUE(evt_bus_publish(1, NULL, 0));
+
+    TEST_ASSERT_EQUAL_UINT32(0, g_fake_backend.q[0].seq);
+    TEST_ASSERT_EQUAL_UINT32(1, g_fake_backend.q[1].seq);
+    TEST_ASSERT_EQUAL_UINT32(1000, g_fake_backend.q[0].ts_us);
+    TEST_ASSERT_EQUAL_UINT32(1200, g_fake_backend.q[1].ts_us);
+
+    g_fake_backend.now_us = 1500;
+    evt_bus_dispatch_evt(&g_fake_backend.q[0]);
+    TEST_ASSERT_EQUAL_UINT32(500, s_age_in_cb);
+    evt_bus_dispatch_evt(&g_fake_backend.q[1]);
+
+    evt_meta_stats_t st;
+    TEST_ASSERT_TRUE(evt_bus_meta_stats(&st));
+    TEST_ASSERT_EQUAL_UINT32(2, st.dispatched);
+    TEST_ASSERT_EQUAL_UINT32(0, st.seq_gaps);
+    TEST_ASSERT_EQUAL_UINT32(300, st.last_latency_us);
+    TEST_ASSERT_EQUAL_UINT32(500, st.max_latency_us);
+
+    /* A rejected publish still consumed its sequence number */
+    g_fake_backend.enqueue_ret = false;
+    TEST_ASSERT_FALSE(evt_bus_publish(1, NULL, 0));
+}
+
+static void test_envelope_meta_counts_gaps_and_reordering(void)
+{
+    evt_t e;
+
+    e = meta_evt(0, 0);  evt_bus_dispatch_evt(&e);
+    e = meta_evt(3, 0);  evt_bus_dispatch_evt(&e);   /* 1, 2 missing */
+    e = meta_evt(2, 0);  evt_bus_dispatch_evt(&e);   /* late */
+    e = meta_evt(4, 0);  evt_bus_dispatch_evt(&e);
+
+    evt_meta_stats_t st;
+    TEST_ASSERT_TRUE(evt_bus_meta_stats(&st));
+    TEST_ASSERT_EQUAL_UINT32(4, st.dispatched);
+    TEST_ASSERT_EQUAL_UINT32(2, st.seq_gaps);
+    TEST_ASSERT_EQUAL_UINT32(1, st.seq_reordered);
+
+    /* Sequence wrap is not a gap or a reorder */
+    e = meta_evt(0x7FFFFFFFu, 0);  evt_bus_dispatch_evt(&e);
+    e = meta_evt(UINT32_MAX - 1u, 0);  evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_TRUE(evt_bus_meta_stats(&st));
+    const uint32_t gaps = st.seq_gaps;
+
+    e = meta_evt(UINT32_MAX, 0);  evt_bus_dispatch_evt(&e);
+    e = meta_evt(0, 0);           evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_TRUE(evt_bus_meta_stats(&st));
+    TEST_ASSERT_EQUAL_UINT32(gaps, st.seq_gaps);
+    TEST_ASSERT_EQUAL_UINT32(1, st.seq_reordered);
+}
+#else
+static void test_envelope_meta_disabled(void)
+{
+    evt_meta_stats_t st;
+    evt_t e;
+    memset(&e, 0, sizeof(e));
+    TEST_ASSERT_FALSE(evt_bus_meta_stats(&st));
+    TEST_ASSERT_EQUAL_UINT32(0, evt_bus_evt_age_us(&e));
+}
+#endif
+
+/* ---------------------------- Retained values ----------------------------- */
+
+#if EVT_BUS_MAX_RETAINED > 0
+/* Records first payload byte of every delivery, in order */
+typedef struct {
+  int     calls;
+  uint8_t seen[8];
+} order_probe_t;
+
+static void cb_order(const evt_t *evt, void *user_ctx)
+{
+  order_probe_t *p = (order_probe_t*)user_ctx;
+  if (p->calls < (int)sizeof(p->seen)) {
+    p->seen[p->calls] = (evt->len > 0) ? evt->payload[0] : 0xFF;
+  }
+  p->calls++;
+  TEST_ASSERT_EQUAL_INT(0, g_fake_backend.lock_depth);
+}
+
+static void publish_dispatch_u8(evt_id_t id, uint8_t v)
+{
+  TEST_ASSERT_TRUE(evt_bus_publish(id, &v, sizeof(v)));
+  evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+static void test_retained_replays_last_value_to_late_subscriber(void)
+{
+    order_probe_t early = {0}, late = {0};
+
+    TEST_ASSERT_TRUE(evt_bus_set_retained(3));
+    evt_bus_subscribe(3, cb_order, &early);
+    publish_dispatch_u8(3, 0x11);
+    publish_dispatch_u8(3, 0x22);
+
+    evt_t out;
+    TEST_ASSERT_TRUE(evt_bus_get_retained(3, &out));
+    TEST_ASSERT_EQUAL_UINT8(0x22, out.payload[0]);
+
+    /* Replay is queued for the dispatcher, not run in the subscriber's context */
+    evt_sub_handle_t h = evt_bus_subscribe_retained(3, cb_order, &late);
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, h.id);
+    TEST_ASSERT_EQUAL_INT(0, late.calls);
+    TEST_ASSERT_EQUAL_UINT16(EVT_BUS_CTRL_ID, g_fake_backend.last_evt.id);
+
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(1, late.calls);
+    TEST_ASSERT_EQUAL_UINT8(0x22, late.seen[0]);
+    TEST_ASSERT_EQUAL_INT(2, early.calls);
+
+    /* One-shot: a second control event replays nothing */
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(1, late.calls);
+
+    publish_dispatch_u8(3, 0x33);
+    TEST_ASSERT_EQUAL_INT(2, late.calls);
+    TEST_ASSERT_EQUAL_UINT8(0x33, late.seen[1]);
+    TEST_ASSERT_EQUAL_INT(3, early.calls);
+}
+
+static void test_retained_replay_precedes_queued_events(void)
+{
+    order_probe_t p = {0};
+    g_fake_backend.q_depth = 4;
+
+    TEST_ASSERT_TRUE(evt_bus_set_retained(3));
+    TEST_ASSERT_TRUE(evt_bus_publish(3, &(uint8_t){0x11}, 1));
+    evt_t e;
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &e));
+    evt_bus_dispatch_evt(&e);
+
+    /* 0x22 is already queued when the late subscriber arrives */
+    TEST_ASSERT_TRUE(evt_bus_publish(3, &(uint8_t){0x22}, 1));
+    evt_bus_subscribe_retained(3, cb_order, &p);
+
+    while (evt_bus_backend.dequeue_nb(NULL, &e)) {
+        evt_bus_dispatch_evt(&e);
+    }
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+    TEST_ASSERT_EQUAL_UINT8(0x11, p.seen[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x22, p.seen[1]);
+
+    /* Replay still runs if the control event could not be queued */
+    order_probe_t q = {0};
+    g_fake_backend.q_depth = 1;
+    TEST_ASSERT_TRUE(evt_bus_publish(3, &(uint8_t){0x33}, 1));
+    evt_bus_subscribe_retained(3, cb_order, &q);
+    TEST_ASSERT_EQUAL_size_t(1, g_fake_backend.q_count);
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &e));
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_EQUAL_INT(2, q.calls);
+    TEST_ASSERT_EQUAL_UINT8(0x22, q.seen[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x33, q.seen[1]);
+}
+
+static void test_retained_replay_dropped_on_unsubscribe(void)
+{
+    order_probe_t p = {0}, q = {0};
+
+    TEST_ASSERT_TRUE(evt_bus_set_retained(3));
+    publish_dispatch_u8(3, 0x11);
+
+    evt_sub_handle_t h = evt_bus_subscribe_retained(3, cb_order, &p);
+    const evt_t ctrl = g_fake_backend.last_evt;
+    evt_bus_unsubscribe(h);
+
+    /* The freed handle is reused by a plain subscriber: no inherited replay */
+    evt_sub_handle_t h2 = evt_bus_subscribe(3, cb_order, &q);
+    TEST_ASSERT_EQUAL_UINT16(h.id, h2.id);
+    evt_bus_dispatch_evt(&ctrl);
+    TEST_ASSERT_EQUAL_INT(0, p.calls);
+    TEST_ASSERT_EQUAL_INT(0, q.calls);
+}
+
+/* Lock hook: a retained subscribe lands between dispatch()'s replay check and its
+ * snapshot lock */
+static void (*s_orig_lock)(void *ctx);
+static order_probe_t s_racing_sub;
+static bool s_subscribe_on_lock;
+
+static void lock_subscribing_retained(void *ctx)
+{
+  if (s_subscribe_on_lock && g_fake_backend.lock_depth == 0) {
+    s_subscribe_on_lock = false;
+    evt_bus_subscribe_retained(3, cb_order, &s_racing_sub);
+  }
+  s_orig_lock(ctx);
+}
+
+static void test_retained_replay_not_duplicated_by_racing_snapshot(void)
+{
+    memset(&s_racing_sub, 0, sizeof(s_racing_sub));
+    TEST_ASSERT_TRUE(evt_bus_set_retained(3));
+    publish_dispatch_u8(3, 0x11);
+
+    TEST_ASSERT_TRUE(evt_bus_publish(3, &(uint8_t){0x22}, 1));
+    const evt_t e = g_fake_backend.last_evt;
+
+    s_orig_lock = evt_bus_backend.lock;
+    evt_bus_backend.lock = lock_subscribing_retained;
+    s_subscribe_on_lock = true;
+    evt_bus_dispatch_evt(&e);
+    evt_bus_backend.lock = s_orig_lock;
+    TEST_ASSERT_FALSE(s_subscribe_on_lock);
+
+    /* Fan-out delivered 0x22; the queued replay control event must not repeat it */
+    TEST_ASSERT_EQUAL_UINT16(EVT_BUS_CTRL_ID, g_fake_backend.last_evt.id);
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(1, s_racing_sub.calls);
+    TEST_ASSERT_EQUAL_UINT8(0x22, s_racing_sub.seen[0]);
+}
+
+static void test_retained_slots_and_plain_fallback(void)
+{
+    order_probe_t p = {0};
+    evt_t out;
+
+    TEST_ASSERT_FALSE(evt_bus_set_retained(EVT_BUS_MAX_EVT_IDS));
+    for (evt_id_t id = 0; id < EVT_BUS_MAX_RETAINED; id++) {
+        TEST_ASSERT_TRUE(evt_bus_set_retained(id));
+    }
+    TEST_ASSERT_TRUE(evt_bus_set_retained(0));   /* already retained */
+    TEST_ASSERT_FALSE(evt_bus_set_retained(EVT_BUS_MAX_RETAINED));
+
+    /* Nothing dispatched yet: no value, no control event */
+    TEST_ASSERT_FALSE(evt_bus_get_retained(0, &out));
+    TEST_ASSERT_FALSE(evt_bus_get_retained(0, NULL));
+    TEST_ASSERT_FALSE(evt_bus_get_retained(EVT_BUS_MAX_RETAINED, &out));
+    const int calls = g_fake_backend.enqueue_calls;
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_retained(0, cb_order, &p).id);
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID,
+                          evt_bus_subscribe_retained(EVT_BUS_MAX_RETAINED, cb_order, &p).id);
+    TEST_ASSERT_EQUAL_INT(calls, g_fake_backend.enqueue_calls);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID,
+                             evt_bus_subscribe_retained(EVT_BUS_MAX_EVT_IDS, cb_order, &p).id);
+}
+#else
+static void test_retained_disabled(void)
+{
+    evt_t out;
+    TEST_ASSERT_FALSE(evt_bus_set_retained(1));
+    TEST_ASSERT_FALSE(evt_bus_get_retained(1, &out));
+}
+#endif
+
+/* ------------------------------ Publish dedup ----------------------------- */
+
+#if EVT_BUS_MAX_DEDUP > 0
+static int s_dedup_tap_calls;
+
+static void dedup_tap(const evt_t *evt, void *ctx)
+{
+    (void)evt;
+    (void)ctx;
+    s_dedup_tap_calls++;
+}
+
+static void dedup_dispatch_one(void)
+{
+    evt_t out;
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(NULL, &out));
+    evt_bus_dispatch_evt(&out);
+}
+
+static void test_dedup_drops_repeat_while_queued(void)
+{
+    const evt_dedup_cfg_t cfg = { .window_us = 0 };
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(6, &cfg));
+    g_fake_backend.q_depth = 4;
+    static const evt_tap_t tap = { .fn = dedup_tap };
+    s_dedup_tap_calls = 0;
+    evt_bus_set_tap(&tap);
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(6, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, evt_bus_publish_from_isr_ex(6, &(uint8_t){1}, 1));
+    TEST_ASSERT_TRUE(evt_bus_publish(6, &(uint8_t){1}, 1));   /* still a success */
+    TEST_ASSERT_EQUAL_size_t(1, g_fake_backend.q_count);
+
+    /* Other IDs are untouched */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(5, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(5, 1));
+
+    /* Dispatched: accepted again (no window) */
+    dedup_dispatch_one();
+    TEST_ASSERT_EQUAL_INT(1, s_dedup_tap_calls);
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 1));
+
+    /* A different payload in between resets the comparison */
+    dedup_dispatch_one();
+    dedup_dispatch_one();
+    dedup_dispatch_one();
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 2));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(6, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_ex(6, NULL, 0));
+}
+
+static void test_dedup_window_outlives_dispatch(void)
+{
+    const evt_dedup_cfg_t cfg = { .window_us = 100 };
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(6, &cfg));
+    g_fake_backend.q_depth = 4;
+
+    g_fake_backend.now_us = 1000;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 7));
+    dedup_dispatch_one();
+
+    g_fake_backend.now_us = 1099;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(6, 7));
+    g_fake_backend.now_us = 1100;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 7));
+
+    /* The window restarts at the last accepted copy, not at the dropped ones */
+    dedup_dispatch_one();
+    g_fake_backend.now_us = 1150;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(6, 7));
+    g_fake_backend.now_us = 1200;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 7));
+}
+
+static void test_dedup_forgets_rejected_and_evicted_events(void)
+{
+    const evt_dedup_cfg_t cfg = { .window_us = 0 };
+    const evt_policy_t oldest = { .mode = EVT_BP_DROP_OLDEST };
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(6, &cfg));
+    TEST_ASSERT_TRUE(evt_bus_set_policy(5, &oldest));
+    TEST_ASSERT_TRUE(evt_bus_set_policy(6, &oldest));
+    g_fake_backend.q_depth = 2;
+
+    /* A rejected publish does not count as accepted: the retry goes out */
+    g_fake_backend.enqueue_ret = false;
+    TEST_ASSERT_FALSE(evt_pub_ok(publish_u8(6, 3)));
+    g_fake_backend.enqueue_ret = true;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(6, 3));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(6, 3));
+
+    /* Evicted by drop-oldest: no longer queued, so the next copy goes out */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(5, 0));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(5, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(6, 3));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(6, 3));
+}
+
+static void test_dedup_slots_and_bad_args(void)
+{
+    const evt_dedup_cfg_t cfg = { .window_us = 0 };
+    const evt_dedup_cfg_t window = { .window_us = 10 };
+
+    TEST_ASSERT_FALSE(evt_bus_set_dedup(EVT_BUS_MAX_EVT_IDS, &cfg));
+    for (evt_id_t id = 0; id < EVT_BUS_MAX_DEDUP; id++) {
+        TEST_ASSERT_TRUE(evt_bus_set_dedup(id, &cfg));
+    }
+    TEST_ASSERT_FALSE(evt_bus_set_dedup(EVT_BUS_MAX_DEDUP, &cfg));
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(0, &window));   /* reconfigure keeps the slot */
+
+    /* Off frees the slot and accepts repeats */
+    g_fake_backend.q_depth = 4;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(1, 1));
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(1, NULL));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    TEST_ASSERT_TRUE(evt_bus_set_dedup(EVT_BUS_MAX_DEDUP, &cfg));
+
+    /* A window needs a clock */
+    uint32_t (*now_us)(void *) = evt_bus_backend.now_us;
+    evt_bus_backend.now_us = NULL;
+    TEST_ASSERT_FALSE(evt_bus_set_dedup(0, &window));
+    evt_bus_backend.now_us = now_us;
+}
+#else
+static void test_dedup_disabled(void)
+{
+    const evt_dedup_cfg_t cfg = { .window_us = 0 };
+    TEST_ASSERT_FALSE(evt_bus_set_dedup(1, &cfg));
+}
+#endif
+
+/* --------------------------- Batch subscribers ---------------------------- */
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+typedef struct {
+  int     calls;
+  size_t  total;
+  size_t  last_n;
+  uint8_t seen[16];   /* first payload byte of every delivered event */
+} batch_probe_t;
+
+static void cb_batch(const evt_t *evts, size_t n, void *user_ctx)
+{
+  batch_probe_t *p = (batch_probe_t*)user_ctx;
+  TEST_ASSERT_TRUE(n >= 1);
+  TEST_ASSERT_EQUAL_INT(0, g_fake_backend.lock_depth);
+  for (size_t i = 0; i < n && p->total < sizeof(p->seen); i++) {
+    p->seen[p->total++] = evts[i].payload[0];
+  }
+  p->last_n = n;
+  p->calls++;
+}
+
+static void batch_publish(evt_id_t id, uint8_t v)
+{
+  TEST_ASSERT_TRUE(evt_bus_publish(id, &v, sizeof(v)));
+  evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+static void test_batch_delivers_by_count(void)
+{
+    batch_probe_t b = {0};
+    cb_probe_t single = {0};
+    const evt_batch_cfg_t cfg = { .max_events = 3 };
+
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(7, cb_batch, &cfg, &b).id);
+    evt_bus_subscribe(7, cb_probe, &single);
+
+    for (uint8_t i = 0; i < 5; i++) {
+        batch_publish(7, i);
+    }
+    TEST_ASSERT_EQUAL_INT(5, single.calls);
+    TEST_ASSERT_EQUAL_INT(1, b.calls);
+    TEST_ASSERT_EQUAL_size_t(3, b.last_n);
+
+    batch_publish(7, 5);
+    TEST_ASSERT_EQUAL_INT(2, b.calls);
+    TEST_ASSERT_EQUAL_size_t(3, b.last_n);
+    for (uint8_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_UINT8(i, b.seen[i]);
+    }
+
+    /* NULL cfg: full EVT_BUS_BATCH_MAX_EVENTS batches, no window */
+    batch_probe_t d = {0};
+    evt_bus_subscribe_batch(8, cb_batch, NULL, &d);
+    for (uint8_t i = 0; i < EVT_BUS_BATCH_MAX_EVENTS; i++) {
+        batch_publish(8, i);
+    }
+    TEST_ASSERT_EQUAL_INT(1, d.calls);
+    TEST_ASSERT_EQUAL_size_t(EVT_BUS_BATCH_MAX_EVENTS, d.last_n);
+}
+
+static void test_batch_delivers_by_window(void)
+{
+    batch_probe_t b = {0};
+    const evt_batch_cfg_t cfg = { .max_events = 4, .window_us = 100 };
+    evt_bus_subscribe_batch(7, cb_batch, &cfg, &b);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, evt_bus_batch_next_due_us());
+
+    g_fake_backend.now_us = 1000;
+    batch_publish(7, 0xA);
+    g_fake_backend.now_us = 1050;
+    batch_publish(7, 0xB);
+    TEST_ASSERT_EQUAL_INT(0, b.calls);
+    TEST_ASSERT_EQUAL_UINT32(50, evt_bus_batch_next_due_us());
+
+    /* Arrival after the window closes the open batch first */
+    g_fake_backend.now_us = 1150;
+    batch_publish(7, 0xC);
+    TEST_ASSERT_EQUAL_INT(1, b.calls);
+    TEST_ASSERT_EQUAL_size_t(2, b.last_n);
+
+    /* Idle poll: only once the window of 0xC has expired */
+    g_fake_backend.now_us = 1200;
+    evt_bus_batch_poll();
+    TEST_ASSERT_EQUAL_INT(1, b.calls);
+    TEST_ASSERT_EQUAL_UINT32(50, evt_bus_batch_next_due_us());
+    g_fake_backend.now_us = 1260;
+    TEST_ASSERT_EQUAL_UINT32(0, evt_bus_batch_next_due_us());
+    evt_bus_batch_poll();
+    TEST_ASSERT_EQUAL_INT(2, b.calls);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, evt_bus_batch_next_due_us());
+    TEST_ASSERT_EQUAL_size_t(1, b.last_n);
+    TEST_ASSERT_EQUAL_UINT8(0xC, b.seen[2]);
+
+    /* Any dispatch also closes expired windows */
+    batch_publish(7, 0xD);
+    g_fake_backend.now_us = 1400;
+    batch_publish(9, 0x0);
+    TEST_ASSERT_EQUAL_INT(3, b.calls);
+    TEST_ASSERT_EQUAL_UINT8(0xD, b.seen[3]);
+}
+
+static void test_batch_unsubscribe_discards_and_reclaims_slot(void)
+{
+    batch_probe_t a = {0}, b = {0};
+
+    evt_sub_handle_t ha = evt_bus_subscribe_batch(7, cb_batch, NULL, &a);
+    evt_bus_subscribe_batch(8, cb_batch, NULL, &b);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(9, cb_batch, NULL, &b).id);
+
+    batch_publish(7, 1);
+    evt_bus_unsubscribe(ha);
+
+    /* The dispatcher reclaims the slot; buffered events are dropped */
+    batch_publish(9, 0);
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(9, cb_batch, NULL, &b).id);
+    evt_bus_batch_poll();
+    TEST_ASSERT_EQUAL_INT(0, a.calls);
+}
+
+static void test_batch_rejects_bad_args(void)
+{
+    batch_probe_t b = {0};
+    const evt_batch_cfg_t too_big = { .max_events = EVT_BUS_BATCH_MAX_EVENTS + 1 };
+    const evt_batch_cfg_t window  = { .window_us = 10 };
+
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(EVT_BUS_MAX_EVT_IDS, cb_batch, NULL, &b).id);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(7, NULL, NULL, &b).id);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(7, cb_batch, &too_big, &b).id);
+
+    /* A window needs a clock */
+    uint32_t (*now_us)(void *) = evt_bus_backend.now_us;
+    evt_bus_backend.now_us = NULL;
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(7, cb_batch, &window, &b).id);
+    evt_bus_backend.now_us = now_us;
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(7, cb_batch, &window, &b).id);
+}
+#else
+static void test_batch_disabled(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(7, NULL, NULL, NULL).id);
+    evt_bus_batch_poll();
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, evt_bus_batch_next_due_us());
+}
+#endif
+
+/* -------------------------- Throttled subscribers ------------------------- */
+
+#if EVT_BUS_SUB_THROTTLE
+static void throttle_publish(evt_id_t id, uint8_t v)
+{
+    TEST_ASSERT_TRUE(evt_bus_publish(id, &v, sizeof(v)));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+static void test_throttle_decimates_every_nth(void)
+{
+    cb_probe_t every3 = {0};
+    cb_probe_t all = {0};
+    const evt_sub_throttle_t cfg = { .every_n = 3 };
+
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(4, cb_probe, &cfg, &every3).id);
+    evt_bus_subscribe(4, cb_probe, &all);
+
+    /* 0, 3 and 6 go through */
+    uint8_t seen[3];
+    for (uint8_t i = 0; i < 7; i++) {
+        const int before = every3.calls;
+        throttle_publish(4, i);
+        if (every3.calls != before) {
+            seen[before] = every3.last_payload[0];
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(7, all.calls);
+    TEST_ASSERT_EQUAL_INT(3, every3.calls);
+    TEST_ASSERT_EQUAL_UINT8(0, seen[0]);
+    TEST_ASSERT_EQUAL_UINT8(3, seen[1]);
+    TEST_ASSERT_EQUAL_UINT8(6, seen[2]);
+}
+
+static void test_throttle_enforces_min_interval(void)
+{
+    cb_probe_t p = {0};
+    const evt_sub_throttle_t cfg = { .min_interval_us = 100 };
+    evt_bus_subscribe_throttled(4, cb_probe, &cfg, &p);
+
+    const uint32_t at[] = { 1000, 1050, 1099, 1100, 1150, 1250 };
+    for (size_t i = 0; i < sizeof(at) / sizeof(at[0]); i++) {
+        g_fake_backend.now_us = at[i];
+        throttle_publish(4, (uint8_t)i);
+    }
+    /* 1000, 1100 and 1250 */
+    TEST_ASSERT_EQUAL_INT(3, p.calls);
+    TEST_ASSERT_EQUAL_UINT8(5, p.last_payload[0]);
+
+    /* Clock wrap */
+    g_fake_backend.now_us = 0xFFFFFFF0u;
+    throttle_publish(4, 6);
+    g_fake_backend.now_us = 0x60u;
+    throttle_publish(4, 7);
+    TEST_ASSERT_EQUAL_INT(5, p.calls);
+}
+
+static void test_throttle_combines_limits_and_resets_on_reuse(void)
+{
+    cb_probe_t p = {0};
+    const evt_sub_throttle_t cfg = { .every_n = 2, .min_interval_us = 100 };
+    evt_sub_handle_t h = evt_bus_subscribe_throttled(4, cb_probe, &cfg, &p);
+
+    /* Every other event is a candidate; candidates inside the interval are skipped */
+    for (uint8_t i = 0; i < 6; i++) {
+        g_fake_backend.now_us = 1000u + 40u * i;   /* candidates at 1000, 1080, 1160 */
+        throttle_publish(4, i);
+    }
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+    TEST_ASSERT_EQUAL_UINT8(4, p.last_payload[0]);
+
+    /* A plain subscriber reusing the handle slot is not throttled */
+    evt_bus_unsubscribe(h);
+    cb_probe_t q = {0};
+    evt_sub_handle_t h2 = evt_bus_subscribe(4, cb_probe, &q);
+    TEST_ASSERT_EQUAL(h.id, h2.id);
+    for (uint8_t i = 0; i < 3; i++) {
+        throttle_publish(4, i);
+    }
+    TEST_ASSERT_EQUAL_INT(3, q.calls);
+}
+
+static void test_throttle_rejects_bad_args(void)
+{
+    cb_probe_t p = {0};
+    const evt_sub_throttle_t interval = { .min_interval_us = 10 };
+
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(EVT_BUS_MAX_EVT_IDS, cb_probe, &interval, &p).id);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(4, NULL, &interval, &p).id);
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(4, cb_probe, NULL, &p).id);
+
+    /* An interval needs a clock */
+    uint32_t (*now_us)(void *) = evt_bus_backend.now_us;
+    evt_bus_backend.now_us = NULL;
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(4, cb_probe, &interval, &p).id);
+    const evt_sub_throttle_t decimate = { .every_n = 2 };
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(4, cb_probe, &decimate, &p).id);
+    evt_bus_backend.now_us = now_us;
+}
+#else
+static void test_throttle_disabled(void)
+{
+    cb_probe_t p = {0};
+    const evt_sub_throttle_t cfg = { .every_n = 2 };
+    TEST_ASSERT_EQUAL_UINT16(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_throttled(4, cb_probe, &cfg, &p).id);
+}
+#endif
+
+/* ---------------------------- Parallel fan-out ---------------------------- */
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+static void test_parallel_fanout_splits_and_joins(void)
+{
+    cb_probe_t p[5] = {0};
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe(3, cb_probe, &p[i]).id);
+    }
+    TEST_ASSERT_TRUE(evt_bus_set_parallel(3, true));
+
+    TEST_ASSERT_TRUE(evt_bus_publish(3, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+
+    /* 5 callbacks over dispatcher + 2 workers: shares of 2, 2 and 1; joined before return */
+    TEST_ASSERT_EQUAL_INT(2, g_fake_backend.fanout_starts);
+    TEST_ASSERT_EQUAL_INT(1, g_fake_backend.fanout_joins);
+    TEST_ASSERT_EQUAL_size_t(2, g_fake_backend.fanout_jobs[0].n);
+    TEST_ASSERT_EQUAL_size_t(1, g_fake_backend.fanout_jobs[1].n);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_INT(1, p[i].calls);
+        TEST_ASSERT_EQUAL_INT(0, p[i].saw_lock_depth_nonzero);
+    }
+
+    /* Back to serial */
+    TEST_ASSERT_TRUE(evt_bus_set_parallel(3, false));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(2, g_fake_backend.fanout_starts);
+    TEST_ASSERT_EQUAL_INT(2, p[4].calls);
+}
+
+static void test_parallel_fanout_runs_refused_shares_locally(void)
+{
+    cb_probe_t p[3] = {0};
+    for (int i = 0; i < 3; i++) {
+        evt_bus_subscribe(3, cb_probe, &p[i]);
+    }
+    TEST_ASSERT_TRUE(evt_bus_set_parallel(3, true));
+    g_fake_backend.fanout_refuse = true;
+
+    TEST_ASSERT_TRUE(evt_bus_publish(3, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.fanout_joins);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, p[i].calls);
+    }
+}
+
+static void test_parallel_fanout_stays_serial_when_not_worth_it(void)
+{
+    cb_probe_t p = {0};
+    evt_bus_subscribe(3, cb_probe, &p);
+    TEST_ASSERT_TRUE(evt_bus_set_parallel(3, true));
+
+    /* One subscriber: nothing to spread */
+    TEST_ASSERT_TRUE(evt_bus_publish(3, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(1, p.calls);
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.fanout_starts);
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    /* A batch subscriber keeps the event on the dispatcher */
+    batch_probe_t b = {0};
+    const evt_batch_cfg_t one = { .max_events = 1 };
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, evt_bus_subscribe_batch(3, cb_batch, &one, &b).id);
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.fanout_starts);
+#endif
+}
+
+static void test_parallel_rejects_bad_args(void)
+{
+    TEST_ASSERT_FALSE(evt_bus_set_parallel(EVT_BUS_MAX_EVT_IDS, true));
+
+    bool (*start)(void *, unsigned, const evt_fanout_job_t *) = evt_bus_backend.fanout_start;
+    evt_bus_backend.fanout_start = NULL;
+    TEST_ASSERT_FALSE(evt_bus_set_parallel(3, true));
+    TEST_ASSERT_TRUE(evt_bus_set_parallel(3, false));
+    evt_bus_backend.fanout_start = start;
+}
+#else
+static void test_parallel_disabled(void)
+{
+    TEST_ASSERT_FALSE(evt_bus_set_parallel(3, true));
+}
+#endif
+
+/* -------------------------------- Liveness -------------------------------- */
+
+#if EVT_BUS_LIVENESS
+static evt_bus_liveness_t s_live_in_cb;
+
+static void cb_liveness(const evt_t *evt, void *user_ctx)
+{
+    (void)evt;
+    (void)user_ctx;
+    evt_bus_liveness(&s_live_in_cb);
+}
+
+static void test_ping_acked_in_queue_order(void)
+{
+    g_fake_backend.q_depth = 4;
+    TEST_ASSERT_TRUE(evt_bus_publish(2, NULL, 0));
+
+    uint32_t ticket = 0;
+    TEST_ASSERT_TRUE(evt_bus_ping(&ticket));
+    TEST_ASSERT_EQUAL_UINT32(1, ticket);
+    TEST_ASSERT_FALSE(evt_bus_ping_acked(ticket));
+
+    /* The event queued before the ping does not acknowledge it */
+    evt_t e;
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(evt_bus_backend.ctx, &e));
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_FALSE(evt_bus_ping_acked(ticket));
+
+    TEST_ASSERT_TRUE(evt_bus_backend.dequeue_nb(evt_bus_backend.ctx, &e));
+    TEST_ASSERT_EQUAL_UINT(EVT_BUS_CTRL_ID, e.id);
+    evt_bus_dispatch_evt(&e);
+    TEST_ASSERT_TRUE(evt_bus_ping_acked(ticket));
+
+    evt_bus_liveness_t live;
+    evt_bus_liveness(&live);
+    TEST_ASSERT_EQUAL_UINT32(1, live.pings_sent);
+    TEST_ASSERT_EQUAL_UINT32(1, live.pings_acked);
+    TEST_ASSERT_FALSE(live.busy);
+}
+
+static void test_ping_fails_on_full_queue(void)
+{
+    g_fake_backend.enqueue_ret = false;
+    uint32_t ticket = 0;
+    TEST_ASSERT_FALSE(evt_bus_ping(&ticket));
+
+    evt_bus_liveness_t live;
+    evt_bus_liveness(&live);
+    TEST_ASSERT_EQUAL_UINT32(0, live.pings_sent);
+
+    g_fake_backend.enqueue_ret = true;
+    TEST_ASSERT_TRUE(evt_bus_ping(NULL));
+}
+
+static void test_ping_evicted_by_drop_oldest_is_covered_by_later_ping(void)
+{
+    const evt_policy_t pol = { .mode = EVT_BP_DROP_OLDEST };
+    TEST_ASSERT_TRUE(evt_bus_set_policy((evt_id_t)1, &pol));
+    g_fake_backend.q_depth = 2;
+
+    uint32_t t1 = 0;
+    TEST_ASSERT_TRUE(evt_bus_ping(&t1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(1, 1));
+    TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(1, 2));   /* evicts the ping */
+
+    evt_t e;
+    while (evt_bus_backend.dequeue_nb(evt_bus_backend.ctx, &e)) {
+        evt_bus_dispatch_evt(&e);
+    }
+    TEST_ASSERT_FALSE(evt_bus_ping_acked(t1));
+
+    uint32_t t2 = 0;
+    TEST_ASSERT_TRUE(evt_bus_ping(&t2));
+    TEST_ASSERT_EQUAL_UINT32(t1 + 1u, t2);
+    while (evt_bus_backend.dequeue_nb(evt_bus_backend.ctx, &e)) {
+        evt_bus_dispatch_evt(&e);
+    }
+    TEST_ASSERT_TRUE(evt_bus_ping_acked(t2));
+    TEST_ASSERT_TRUE(evt_bus_ping_acked(t1));
+
+    evt_bus_liveness_t live;
+    evt_bus_liveness(&live);
+    TEST_ASSERT_EQUAL_UINT32(2, live.pings_sent);
+    TEST_ASSERT_EQUAL_UINT32(2, live.pings_acked);
+}
+
+static void test_liveness_records_busy_since_dequeue(void)
+{
+    evt_bus_subscribe(5, cb_liveness, NULL);
+    g_fake_backend.now_us = 4242;
+
+    TEST_ASSERT_TRUE(evt_bus_publish(5, NULL, 0));
+    evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+
+    TEST_ASSERT_TRUE(s_live_in_cb.busy);
+    TEST_ASSERT_EQUAL_UINT(5, s_live_in_cb.busy_id);
+    TEST_ASSERT_EQUAL_UINT32(4242, s_live_in_cb.busy_since_us);
+
+    evt_bus_liveness_t live;
+    evt_bus_liveness(&live);
+    TEST_ASSERT_FALSE(live.busy);
+    TEST_ASSERT_EQUAL_UINT32(0, live.busy_since_us);
+}
+#else
+static void test_liveness_disabled(void)
+{
+    evt_bus_liveness_t live;
+    TEST_ASSERT_FALSE(evt_bus_ping(NULL));
+    TEST_ASSERT_FALSE(evt_bus_ping_acked(0));
+    evt_bus_liveness(&live);
+    TEST_ASSERT_FALSE(live.busy);
+    TEST_ASSERT_EQUAL_UINT32(0, live.pings_sent);
+}
+#endif
+
+/* ------------------------------- Direct lane ------------------------------ */
+
+#if EVT_BUS_DIRECT_LANE
+static void lane_dispatch_id(evt_id_t id)
+{
+    evt_t e;
+    memset(&e, 0, sizeof(e));
+    e.id = id;
+    evt_bus_dispatch_evt(&e);
+}
+
+static void test_lane_skips_lock_for_sole_subscriber(void)
+{
+    cb_probe_t p = {0};
+    evt_bus_subscribe(2, cb_probe, &p);
+
+    /* First dispatch snapshots and fills the lane; later ones take no lock */
+    lane_dispatch_id(2);
+    const int locks = g_fake_backend.lock_calls;
+    lane_dispatch_id(2);
+    lane_dispatch_id(2);
+    TEST_ASSERT_EQUAL_INT(locks, g_fake_backend.lock_calls);
+    TEST_ASSERT_EQUAL_INT(3, p.calls);
+
+    /* A second subscriber closes the lane */
+    cb_probe_t q = {0};
+    evt_sub_handle_t hq = evt_bus_subscribe(2, cb_probe, &q);
+    lane_dispatch_id(2);
+    TEST_ASSERT_EQUAL_INT(4, p.calls);
+    TEST_ASSERT_EQUAL_INT(1, q.calls);
+    TEST_ASSERT_TRUE(g_fake_backend.lock_calls > locks + 1);
+
+    /* Back to one: the next snapshot reopens it */
+    evt_bus_unsubscribe(hq);
+    lane_dispatch_id(2);
+    const int locks2 = g_fake_backend.lock_calls;
+    lane_dispatch_id(2);
+    TEST_ASSERT_EQUAL_INT(locks2, g_fake_backend.lock_calls);
+    TEST_ASSERT_EQUAL_INT(6, p.calls);
+    TEST_ASSERT_EQUAL_INT(1, q.calls);
+}
+
+static void test_lane_closed_by_unsubscribe_and_reuse(void)
+{
+    cb_probe_t p = {0};
+    evt_sub_handle_t h = evt_bus_subscribe(2, cb_probe, &p);
+    lane_dispatch_id(2);
+    lane_dispatch_id(2);
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+
+    evt_bus_unsubscribe(h);
+    lane_dispatch_id(2);
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+
+    /* The reused handle slot on another ID gets nothing of ID 2 */
+    cb_probe_t q = {0};
+    evt_sub_handle_t h2 = evt_bus_subscribe(5, cb_probe, &q);
+    TEST_ASSERT_EQUAL(h.id, h2.id);
+    lane_dispatch_id(2);
+    lane_dispatch_id(5);
+    lane_dispatch_id(5);
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+    TEST_ASSERT_EQUAL_INT(2, q.calls);
+    TEST_ASSERT_EQUAL_UINT(5, q.last_id);
+}
+
+static void test_lane_keeps_watchdog_and_retained_semantics(void)
+{
+#if EVT_BUS_CB_WATCHDOG
+    costly_t slow = { .cost_us = 500 };
+    overrun_probe_t rep = {0};
+    const evt_cb_watchdog_t wd = {
+        .budget_us = 100, .strikes = 2, .auto_suspend = true,
+        .on_overrun = on_overrun, .hook_ctx = &rep,
+    };
+    TEST_ASSERT_TRUE(evt_bus_set_cb_watchdog(&wd));
+    evt_sub_handle_t hs = evt_bus_subscribe(3, cb_costly, &slow);
+
+    /* Timed on the lane as well; suspension closes it */
+    lane_dispatch_id(3);
+    lane_dispatch_id(3);
+    TEST_ASSERT_EQUAL_INT(1, rep.reports);
+    TEST_ASSERT_EQUAL_UINT16(hs.gen, rep.handle.gen);
+    lane_dispatch_id(3);
+    TEST_ASSERT_EQUAL_INT(2, slow.calls);
+    TEST_ASSERT_TRUE(evt_bus_resume_subscriber(hs));
+    lane_dispatch_id(3);
+    TEST_ASSERT_EQUAL_INT(3, slow.calls);
+#endif
+
+#if EVT_BUS_MAX_RETAINED > 0
+    /* Retained IDs store under the lock: the lane closes */
+    cb_probe_t p = {0};
+    evt_bus_subscribe(4, cb_probe, &p);
+    lane_dispatch_id(4);
+    TEST_ASSERT_TRUE(evt_bus_set_retained(4));
+    lane_dispatch_id(4);
+    evt_t last;
+    TEST_ASSERT_TRUE(evt_bus_get_retained(4, &last));
+    TEST_ASSERT_EQUAL_INT(2, p.calls);
+#endif
+}
+#endif
+
+/* ------------------------------- Footprint -------------------------------- */
+
+static void test_footprint_matches_configured_tables(void)
+{
+    evt_bus_footprint_t fp;
+    evt_bus_footprint(&fp);
+
+    TEST_ASSERT_EQUAL_size_t(sizeof(evt_bus_t), fp.bus);
+    TEST_ASSERT_EQUAL_size_t(EVT_BUS_MAX_HANDLES * sizeof(hndl_gen_t), fp.generations);
+    TEST_ASSERT_EQUAL_size_t(EVT_BUS_MAX_EVT_IDS * EVT_BUS_MAX_SUBSCRIBERS_PER_EVT * fp.handle,
+                             fp.subscriptions);
+    TEST_ASSERT_TRUE(fp.subscribers + fp.generations + fp.subscriptions +
+                     fp.policies + fp.publishers + fp.retained + fp.batches +
+                     fp.throttles <= fp.bus);
+#if EVT_BUS_MAX_RETAINED > 0
+    TEST_ASSERT_TRUE(fp.retained >= EVT_BUS_MAX_RETAINED * sizeof(evt_t));
+#else
+    TEST_ASSERT_EQUAL_size_t(0, fp.retained);
+#endif
+#if EVT_BUS_SUB_THROTTLE
+    /* The per-handle cost documented in evt_bus_config.h */
+    TEST_ASSERT_EQUAL_size_t(EVT_BUS_MAX_HANDLES * 16u, fp.throttles);
+#else
+    TEST_ASSERT_EQUAL_size_t(0, fp.throttles);
+#endif
+
+    /* Handles and envelope headers follow the selected index widths */
+    TEST_ASSERT_EQUAL_size_t(sizeof(hndl_id_t) + sizeof(hndl_gen_t), fp.handle);
+    TEST_ASSERT_EQUAL_size_t(sizeof(evt_env_id_t) + sizeof(evt_env_len_t), offsetof(evt_t, payload));
+#if EVT_BUS_COMPACT
+    TEST_ASSERT_EQUAL_size_t(1, sizeof(hndl_id_t));
+    TEST_ASSERT_EQUAL_size_t(1, sizeof(evt_env_id_t));
+#endif
+}
+
+/* ------------------------------ Bus instances ----------------------------- */
+
+/* Minimal single-slot backend for a second bus; state travels through ctx */
+typedef struct {
+  evt_t last;
+  int   enqueue_calls;
+  int   lock_calls;
+} mini_backend_t;
+
+static bool mini_enqueue(void *ctx, const evt_t *evt)
+{
+  mini_backend_t *m = (mini_backend_t*)ctx;
+  m->last = *evt;
+  m->enqueue_calls++;
+  return true;
+}
+
+static void mini_lock(void *ctx)   { ((mini_backend_t*)ctx)->lock_calls++; }
+static void mini_unlock(void *ctx) { (void)ctx; }
+
+static void test_instances_are_isolated(void)
+{
+    static evt_bus_t bus_b;
+    static mini_backend_t mini;
+    static evt_bus_backend_t be_b = {
+        .ctx = &mini, .enqueue = mini_enqueue, .lock = mini_lock, .unlock = mini_unlock,
+    };
+    memset(&mini, 0, sizeof(mini));
+    TEST_ASSERT_TRUE(evt_bus_inst_init(&bus_b, &be_b));
+
+    cb_probe_t pa = {0}, pb = {0};
+    pa.expected_ctx = &pa;
+    pb.expected_ctx = &pb;
+
+    evt_sub_handle_t ha = evt_bus_subscribe(1, cb_probe, &pa);
+    evt_sub_handle_t hb = evt_bus_inst_subscribe(&bus_b, 1, cb_probe, &pb);
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, ha.id);
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, hb.id);
+    TEST_ASSERT_TRUE(mini.lock_calls > 0);
+
+    /* Publishing on B only touches B's backend */
+    const int default_enqueues = g_fake_backend.enqueue_calls;
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus_b, 1, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(1, mini.enqueue_calls);
+    TEST_ASSERT_EQUAL_INT(default_enqueues, g_fake_backend.enqueue_calls);
+
+    evt_bus_inst_dispatch_evt(&bus_b, &mini.last);
+    TEST_ASSERT_EQUAL_INT(0, pa.calls);
+    TEST_ASSERT_EQUAL_INT(1, pb.calls);
+
+    /* Handles are per instance: unsubscribing B's handle leaves the default bus alone */
+    evt_bus_inst_unsubscribe(&bus_b, hb);
+    evt_bus_dispatch_evt(&mini.last);
+    TEST_ASSERT_EQUAL_INT(1, pa.calls);
+    evt_bus_inst_dispatch_evt(&bus_b, &mini.last);
+    TEST_ASSERT_EQUAL_INT(1, pb.calls);
+}
+
+static void test_instance_policies_are_independent(void)
+{
+    static evt_bus_t bus_b;
+    static mini_backend_t mini;
+    static evt_bus_backend_t be_b = { .ctx = &mini, .enqueue = mini_enqueue };
+    TEST_ASSERT_TRUE(evt_bus_inst_init(&bus_b, &be_b));
+
+    const evt_policy_t block = { .mode = EVT_BP_BLOCK, .timeout_ms = 5 };
+    TEST_ASSERT_TRUE(evt_bus_set_policy(1, &block));
+
+    /* B keeps drop-new and has no enqueue_timeout hook: still publishes */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus_b, 1, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(0, g_fake_backend.enqueue_timeout_calls);
+}
+
+/* Backend with a reader-writer lock: counts both sides, flags overlaps with a writer */
+typedef struct {
+  evt_t last;
+  int   lock_calls;
+  int   read_calls;
+  int   readers;
+  bool  writer;
+  bool  held_in_cb;
+} rw_backend_t;
+
+static bool rw_enqueue(void *ctx, const evt_t *evt) { ((rw_backend_t*)ctx)->last = *evt; return true; }
+
+static void rw_lock(void *ctx)
+{
+  rw_backend_t *r = (rw_backend_t*)ctx;
+  TEST_ASSERT_FALSE(r->writer);
+  TEST_ASSERT_EQUAL_INT(0, r->readers);
+  r->writer = true;
+  r->lock_calls++;
+}
+
+static void rw_unlock(void *ctx) { ((rw_backend_t*)ctx)->writer = false; }
+
+static void rw_read_lock(void *ctx)
+{
+  rw_backend_t *r = (rw_backend_t*)ctx;
+  TEST_ASSERT_FALSE(r->writer);
+  r->readers++;
+  r->read_calls++;
+}
+
+static void rw_read_unlock(void *ctx) { ((rw_backend_t*)ctx)->readers--; }
+
+static void cb_rw_probe(const evt_t *evt, void *user_ctx)
+{
+  (void)evt;
+  rw_backend_t *r = (rw_backend_t*)user_ctx;
+  r->held_in_cb = r->held_in_cb || r->writer || r->readers != 0;
+}
+
+static void test_read_lock_shared_by_dispatch_snapshot(void)
+{
+    static evt_bus_t bus_rw;
+    static rw_backend_t rwb;
+    static evt_bus_backend_t be_rw = {
+        .ctx = &rwb, .enqueue = rw_enqueue, .lock = rw_lock, .unlock = rw_unlock,
+        .read_lock = rw_read_lock, .read_unlock = rw_read_unlock,
+    };
+    memset(&rwb, 0, sizeof(rwb));
+    TEST_ASSERT_TRUE(evt_bus_inst_init(&bus_rw, &be_rw));
+
+    /* Table writes are exclusive */
+    TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID,
+                          evt_bus_inst_subscribe(&bus_rw, 1, cb_rw_probe, &rwb).id);
+    TEST_ASSERT_EQUAL_INT(1, rwb.lock_calls);
+    TEST_ASSERT_EQUAL_INT(0, rwb.read_calls);
+
+    /* A plain snapshot only reads */
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus_rw, 1, NULL, 0));
+    evt_bus_inst_dispatch_evt(&bus_rw, &rwb.last);
+    TEST_ASSERT_EQUAL_INT(1, rwb.lock_calls);
+    TEST_ASSERT_EQUAL_INT(1, rwb.read_calls);
+    TEST_ASSERT_FALSE(rwb.held_in_cb);
+    TEST_ASSERT_EQUAL_INT(0, rwb.readers);
+
+#if EVT_BUS_MAX_RETAINED > 0
+    /* Storing a retained value upgrades to the exclusive lock; reading it back shares */
+    TEST_ASSERT_TRUE(evt_bus_inst_set_retained(&bus_rw, 1));
+    const int locks = rwb.lock_calls;
+    evt_bus_inst_dispatch_evt(&bus_rw, &rwb.last);
+    TEST_ASSERT_EQUAL_INT(locks + 1, rwb.lock_calls);
+
+    evt_t out;
+    const int reads = rwb.read_calls;
+    TEST_ASSERT_TRUE(evt_bus_inst_get_retained(&bus_rw, 1, &out));
+    TEST_ASSERT_EQUAL_INT(reads + 1, rwb.read_calls);
+    TEST_ASSERT_EQUAL_INT(locks + 1, rwb.lock_calls);
+#endif
+    TEST_ASSERT_FALSE(rwb.writer);
+}
+
+static void test_zeroed_instance_needs_no_table_init(void)
+{
+    static evt_bus_t bus_z;          /* .bss: never touched before */
+    static evt_bus_t zero;
+    static mini_backend_t mini;
+    static evt_bus_backend_t be_z = { .ctx = &mini, .enqueue = mini_enqueue };
+
+    TEST_ASSERT_TRUE(evt_bus_inst_init(&bus_z, &be_z));
+
+    /* All-zero is the empty encoding */
+    TEST_ASSERT_EQUAL_MEMORY(&zero.subscriptions, &bus_z.subscriptions, sizeof(zero.subscriptions));
+    TEST_ASSERT_EQUAL_MEMORY(&zero.subscriber_pool, &bus_z.subscriber_pool, sizeof(zero.subscriber_pool));
+
+    cb_probe_t p = {0};
+    p.expected_ctx = &p;
+    evt_sub_handle_t h = evt_bus_inst_subscribe(&bus_z, 0, cb_probe, &p);
+    TEST_ASSERT_EQUAL_UINT16(0, h.id);   /* first pool slot is a valid handle */
+
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus_z, 0, NULL, 0));
+    evt_bus_inst_dispatch_evt(&bus_z, &mini.last);
+    TEST_ASSERT_EQUAL_INT(1, p.calls);
+
+    /* Re-init clears the previous subscriptions */
+    TEST_ASSERT_TRUE(evt_bus_inst_init(&bus_z, &be_z));
+    evt_bus_inst_dispatch_evt(&bus_z, &mini.last);
+    TEST_ASSERT_EQUAL_INT(1, p.calls);
+    evt_bus_inst_unsubscribe(&bus_z, h);   /* stale after re-init: no-op */
+}
+
+static void test_instance_init_clears_dirty_storage(void)
+{
+    static evt_bus_t bus_d;
+    static mini_backend_t mini;
+    static evt_bus_backend_t be_d = { .ctx = &mini, .enqueue = mini_enqueue };
+
+    /* Reused RAM: backend pointer NULL but the tables full of garbage */
+    memset(&bus_d, 0xA5, sizeof(bus_d));
+    bus_d.backend = NULL;
+    TEST_ASSERT_TRUE(evt_bus_inst_init(&bus_d, &be_d));
+
+    cb_probe_t p = {0};
+    p.expected_ctx = &p;
+    evt_sub_handle_t h = evt_bus_inst_subscribe(&bus_d, 0, cb_probe, &p);
+    TEST_ASSERT_EQUAL_UINT16(0, h.id);
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus_d, 0, NULL, 0));
+    evt_bus_inst_dispatch_evt(&bus_d, &mini.last);
+    TEST_ASSERT_EQUAL_INT(1, p.calls);
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus_d, 1, NULL, 0));
+    evt_bus_inst_dispatch_evt(&bus_d, &mini.last);   /* no garbage subscriber on ID 1 */
+    TEST_ASSERT_EQUAL_INT(1, p.calls);
+}
+
+static void test_instance_init_rejects_bad_args(void)
+{
+    static evt_bus_t bus_b;
+    evt_bus_backend_t be = { 0 };
+    TEST_ASSERT_FALSE(evt_bus_inst_init(NULL, &be));
+    TEST_ASSERT_FALSE(evt_bus_inst_init(&bus_b, NULL));
+    TEST_ASSERT_TRUE(evt_bus_default() != &bus_b);
+}
 
 /* --------------------------------- Runner --------------------------------- */
 /* Main */
@@ -290,6 +2182,125 @@ int main(void)
     RUN_TEST(test_dispatch_reclaims_stale_slot_then_subscribe_succeeds);
     RUN_TEST(test_unsubscribe_stale_handle_is_noop_and_does_not_affect_new_sub);
 
+    RUN_TEST(test_subscribe_many_takes_lock_once);
+    RUN_TEST(test_subscribe_many_rolls_back_on_capacity);
+    RUN_TEST(test_subscribe_many_rejects_bad_args_without_locking);
+
+    RUN_TEST(test_default_policy_is_drop_new);
+    RUN_TEST(test_publish_ex_reports_invalid_args);
+    RUN_TEST(test_drop_oldest_evicts_head);
+    RUN_TEST(test_block_policy_passes_timeout);
+    RUN_TEST(test_reserved_slots_kept_for_critical_ids);
+    RUN_TEST(test_drop_oldest_respects_reservation);
+    RUN_TEST(test_block_waits_for_room_above_reservation);
+    RUN_TEST(test_block_reserved_times_out);
+    RUN_TEST(test_set_policy_rejects_bad_args);
+
+    RUN_TEST(test_publisher_inflight_quota_released_on_dispatch);
+    RUN_TEST(test_publisher_quota_not_consumed_by_rejected_publish);
+    RUN_TEST(test_publisher_quota_released_on_drop_oldest);
+    RUN_TEST(test_publisher_token_bucket_rate_limit);
+    RUN_TEST(test_publisher_register_limits);
+
+#if EVT_BUS_MAX_WAITERS > 0
+    RUN_TEST(test_wait_for_returns_event_dispatched_while_blocked);
+    RUN_TEST(test_wait_for_times_out_and_releases_slot);
+    RUN_TEST(test_wait_for_ignores_stale_wake);
+    RUN_TEST(test_wait_for_rejects_bad_args_and_missing_hooks);
+#endif
+
+#if EVT_BUS_MAX_REQUESTS > 0
+    RUN_TEST(test_request_gets_reply_without_queue_round_trip);
+    RUN_TEST(test_request_times_out_and_releases_slot);
+    RUN_TEST(test_request_pool_exhaustion);
+    RUN_TEST(test_request_rejects_bad_args_and_missing_hooks);
+#else
+    RUN_TEST(test_request_disabled);
+#endif
+
+#if EVT_BUS_CB_WATCHDOG
+    RUN_TEST(test_watchdog_suspends_repeat_offender);
+    RUN_TEST(test_watchdog_report_only_needs_consecutive_overruns);
+    RUN_TEST(test_watchdog_requires_clock);
+#endif
+
+#if EVT_BUS_ENVELOPE_META
+    RUN_TEST(test_envelope_meta_stamps_seq_and_latency);
+    RUN_TEST(test_envelope_meta_counts_gaps_and_reordering);
+#else
+    RUN_TEST(test_envelope_meta_disabled);
+#endif
+
+#if EVT_BUS_MAX_RETAINED > 0
+    RUN_TEST(test_retained_replays_last_value_to_late_subscriber);
+    RUN_TEST(test_retained_replay_precedes_queued_events);
+    RUN_TEST(test_retained_replay_dropped_on_unsubscribe);
+    RUN_TEST(test_retained_replay_not_duplicated_by_racing_snapshot);
+    RUN_TEST(test_retained_slots_and_plain_fallback);
+#else
+    RUN_TEST(test_retained_disabled);
+#endif
+
+#if EVT_BUS_MAX_DEDUP > 0
+    RUN_TEST(test_dedup_drops_repeat_while_queued);
+    RUN_TEST(test_dedup_window_outlives_dispatch);
+    RUN_TEST(test_dedup_forgets_rejected_and_evicted_events);
+    RUN_TEST(test_dedup_slots_and_bad_args);
+#else
+    RUN_TEST(test_dedup_disabled);
+#endif
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+    RUN_TEST(test_batch_delivers_by_count);
+    RUN_TEST(test_batch_delivers_by_window);
+    RUN_TEST(test_batch_unsubscribe_discards_and_reclaims_slot);
+    RUN_TEST(test_batch_rejects_bad_args);
+#else
+    RUN_TEST(test_batch_disabled);
+#endif
+
+#if EVT_BUS_SUB_THROTTLE
+    RUN_TEST(test_throttle_decimates_every_nth);
+    RUN_TEST(test_throttle_enforces_min_interval);
+    RUN_TEST(test_throttle_combines_limits_and_resets_on_reuse);
+    RUN_TEST(test_throttle_rejects_bad_args);
+#else
+    RUN_TEST(test_throttle_disabled);
+#endif
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+    RUN_TEST(test_parallel_fanout_splits_and_joins);
+    RUN_TEST(test_parallel_fanout_runs_refused_shares_locally);
+    RUN_TEST(test_parallel_fanout_stays_serial_when_not_worth_it);
+    RUN_TEST(test_parallel_rejects_bad_args);
+#else
+    RUN_TEST(test_parallel_disabled);
+#endif
+
+#if EVT_BUS_LIVENESS
+    RUN_TEST(test_ping_acked_in_queue_order);
+    RUN_TEST(test_ping_fails_on_full_queue);
+    RUN_TEST(test_ping_evicted_by_drop_oldest_is_covered_by_later_ping);
+    RUN_TEST(test_liveness_records_busy_since_dequeue);
+#else
+    RUN_TEST(test_liveness_disabled);
+#endif
+
+#if EVT_BUS_DIRECT_LANE
+    RUN_TEST(test_lane_skips_lock_for_sole_subscriber);
+    RUN_TEST(test_lane_closed_by_unsubscribe_and_reuse);
+    RUN_TEST(test_lane_keeps_watchdog_and_retained_semantics);
+#endif
+
+    RUN_TEST(test_footprint_matches_configured_tables);
+
+    RUN_TEST(test_instances_are_isolated);
+    RUN_TEST(test_instance_policies_are_independent);
+    RUN_TEST(test_read_lock_shared_by_dispatch_snapshot);
+    RUN_TEST(test_zeroed_instance_needs_no_table_init);
+    RUN_TEST(test_instance_init_clears_dirty_storage);
+    RUN_TEST(test_instance_init_rejects_bad_args);
+
 
   return UNITY_END();
 }
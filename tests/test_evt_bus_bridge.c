@@ -0,0 +1,332 @@
+/* ========================================================================== */
+/* File: tests/test_evt_bus_bridge.c                                          */
+/* ========================================================================== */
+#if defined(__linux__)
+#define _POSIX_C_SOURCE 200809L
+#include <unistd.h>
+#endif
+
+#include <string.h>
+#include "unity.h"
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus/evt_bus_bridge.h"
+#include "test_helpers.h"
+
+/* ------------------------------ Memory link ------------------------------- */
+
+typedef struct {
+  uint8_t buf[2048];
+  size_t  len;
+  int     writes;
+  bool    fail;
+} mem_link_t;
+
+static mem_link_t s_link;
+
+static bool mem_write(void *ctx, const uint8_t *data, size_t len)
+{
+  mem_link_t *m = (mem_link_t*)ctx;
+  if (m->fail || m->len + len > sizeof(m->buf)) return false;
+  TEST_ASSERT_TRUE(len <= EVT_BRIDGE_MAX_FRAME);
+  memcpy(&m->buf[m->len], data, len);
+  m->len += len;
+  m->writes++;
+  return true;
+}
+
+static const evt_bridge_link_t s_mem = { .ctx = &s_link, .write = mem_write };
+
+/* ------------------------- Remote bus (ring backend) ---------------------- */
+
+typedef struct {
+  evt_t  q[32];
+  size_t count;
+} ring_backend_t;
+
+static bool ring_enqueue(void *ctx, const evt_t *evt)
+{
+  ring_backend_t *r = (ring_backend_t*)ctx;
+  if (r->count >= 32) return false;
+  r->q[r->count++] = *evt;
+  return true;
+}
+
+static ring_backend_t    s_ring;
+static evt_bus_backend_t s_ring_be = { .ctx = &s_ring, .enqueue = ring_enqueue };
+static evt_bus_t         s_remote;
+
+static evt_bridge_t s_local_br, s_remote_br;
+
+static void publish_dispatch(evt_id_t id, const void *payload, size_t len)
+{
+  TEST_ASSERT_TRUE(evt_bus_publish(id, payload, len));
+  evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+static void start_local(const evt_id_t *ids, size_t n, uint16_t max_records, uint32_t max_delay_us)
+{
+  const evt_bridge_cfg_t cfg = {
+    .ids = ids, .n_ids = n, .max_records = max_records, .max_delay_us = max_delay_us,
+  };
+  TEST_ASSERT_TRUE(evt_bus_bridge_start(&s_local_br, evt_bus_default(), &s_mem, &cfg));
+}
+
+/* ------------------------------ Unity hooks ------------------------------- */
+
+void setUp(void)
+{
+  test_reset_bus();
+  memset(&s_link, 0, sizeof(s_link));
+  memset(&s_ring, 0, sizeof(s_ring));
+  memset(&s_local_br, 0, sizeof(s_local_br));
+
+  /* Remote side: RX only */
+  static const evt_bridge_cfg_t rx_only = { 0 };
+  TEST_ASSERT_TRUE(evt_bus_inst_init(&s_remote, &s_ring_be));
+  TEST_ASSERT_TRUE(evt_bus_bridge_start(&s_remote_br, &s_remote, &s_mem, &rx_only));
+}
+
+void tearDown(void) {}
+
+/* --------------------------------- Tests --------------------------------- */
+
+static void test_bridge_packs_burst_into_one_frame(void)
+{
+  static const evt_id_t ids[] = { 1, 2 };
+  start_local(ids, 2, 0, 0);
+
+  const uint8_t a = 0x11;
+  const uint8_t b[2] = { 0x22, 0x23 };
+  publish_dispatch(1, &a, 1);
+  publish_dispatch(2, b, 2);
+  publish_dispatch(3, &a, 1);   /* not forwarded */
+  TEST_ASSERT_EQUAL_INT(0, s_link.writes);
+
+  evt_bus_bridge_flush(&s_local_br);
+  TEST_ASSERT_EQUAL_INT(1, s_link.writes);
+  TEST_ASSERT_EQUAL_UINT32(1, s_local_br.stats.tx_frames);
+  TEST_ASSERT_EQUAL_UINT32(2, s_local_br.stats.tx_records);
+
+  /* sync, body_len = (1+1+1) + (1+1+2), body, crc */
+  TEST_ASSERT_EQUAL_size_t(EVT_BRIDGE_OVERHEAD + 7u, s_link.len);
+  TEST_ASSERT_EQUAL_UINT8(EVT_BRIDGE_SYNC0, s_link.buf[0]);
+  TEST_ASSERT_EQUAL_UINT8(EVT_BRIDGE_SYNC1, s_link.buf[1]);
+  TEST_ASSERT_EQUAL_UINT8(7, s_link.buf[2]);
+  TEST_ASSERT_EQUAL_UINT8(0, s_link.buf[3]);
+
+  /* Nothing buffered: flush is a no-op */
+  evt_bus_bridge_flush(&s_local_br);
+  TEST_ASSERT_EQUAL_INT(1, s_link.writes);
+
+  evt_bus_bridge_rx(&s_remote_br, s_link.buf, s_link.len);
+  TEST_ASSERT_EQUAL_UINT32(1, s_remote_br.stats.rx_frames);
+  TEST_ASSERT_EQUAL_UINT32(2, s_remote_br.stats.rx_records);
+  TEST_ASSERT_EQUAL_size_t(2, s_ring.count);
+  TEST_ASSERT_EQUAL_UINT16(1, s_ring.q[0].id);
+  TEST_ASSERT_EQUAL_UINT8(0x11, s_ring.q[0].payload[0]);
+  TEST_ASSERT_EQUAL_UINT16(2, s_ring.q[1].id);
+  TEST_ASSERT_EQUAL_UINT16(2, s_ring.q[1].len);
+  TEST_ASSERT_EQUAL_UINT8(0x23, s_ring.q[1].payload[1]);
+}
+
+static void test_bridge_sends_on_max_records_and_delay(void)
+{
+  static const evt_id_t ids[] = { 1 };
+
+  start_local(ids, 1, 3, 0);
+  for (uint8_t i = 0; i < 5; i++) {
+    publish_dispatch(1, &i, 1);
+  }
+  TEST_ASSERT_EQUAL_INT(1, s_link.writes);
+  TEST_ASSERT_EQUAL_UINT32(3, s_local_br.stats.tx_records);
+  evt_bus_bridge_stop(&s_local_br);
+
+  /* Delay: the record that finds the oldest one too old closes the frame */
+  memset(&s_link, 0, sizeof(s_link));
+  start_local(ids, 1, 0, 100);
+  g_fake_backend.now_us = 1000;
+  publish_dispatch(1, NULL, 0);
+  g_fake_backend.now_us = 1050;
+  publish_dispatch(1, NULL, 0);
+  TEST_ASSERT_EQUAL_INT(0, s_link.writes);
+  g_fake_backend.now_us = 1100;
+  publish_dispatch(1, NULL, 0);
+  TEST_ASSERT_EQUAL_INT(1, s_link.writes);
+  TEST_ASSERT_EQUAL_UINT32(3, s_local_br.stats.tx_records);
+}
+
+static void test_bridge_splits_frames_when_full(void)
+{
+  static const evt_id_t ids[] = { 1 };
+  start_local(ids, 1, 0, 0);
+
+  uint8_t big[EVT_INLINE_MAX];
+  memset(big, 0xAB, sizeof(big));
+  const size_t per_frame = EVT_BRIDGE_MAX_BODY / (2u + EVT_INLINE_MAX);
+  const size_t total = 2u * per_frame + 1u;
+
+  for (size_t i = 0; i < total; i++) {
+    publish_dispatch(1, big, sizeof(big));
+  }
+  TEST_ASSERT_EQUAL_INT(2, s_link.writes);
+  evt_bus_bridge_flush(&s_local_br);
+  TEST_ASSERT_EQUAL_INT(3, s_link.writes);
+
+  evt_bus_bridge_rx(&s_remote_br, s_link.buf, s_link.len);
+  TEST_ASSERT_EQUAL_UINT32(total, s_remote_br.stats.rx_records);
+
+  /* A refused frame is counted, not retried */
+  s_link.fail = true;
+  publish_dispatch(1, big, 1);
+  evt_bus_bridge_flush(&s_local_br);
+  TEST_ASSERT_EQUAL_UINT32(1, s_local_br.stats.tx_dropped);
+}
+
+static void test_bridge_rx_resyncs_after_garbage_and_crc_error(void)
+{
+  static const evt_id_t ids[] = { 1 };
+  start_local(ids, 1, 1, 0);   /* one frame per event */
+
+  const uint8_t v1 = 0x01, v2 = 0x02;
+  publish_dispatch(1, &v1, 1);
+  const size_t f1 = s_link.len;
+  publish_dispatch(1, &v2, 1);
+
+  uint8_t stream[64] = { 0x00, EVT_BRIDGE_SYNC0, EVT_BRIDGE_SYNC0, 0x7F };
+  memcpy(&stream[4], s_link.buf, s_link.len);
+  stream[4 + f1 - 3] ^= 0x40;   /* corrupt the payload of frame 1 */
+
+  /* Byte at a time: the decoder keeps its state across calls */
+  for (size_t i = 0; i < 4 + s_link.len; i++) {
+    evt_bus_bridge_rx(&s_remote_br, &stream[i], 1);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, s_remote_br.stats.rx_crc_errors);
+  TEST_ASSERT_EQUAL_UINT32(1, s_remote_br.stats.rx_frames);
+  TEST_ASSERT_EQUAL_size_t(1, s_ring.count);
+  TEST_ASSERT_EQUAL_UINT8(0x02, s_ring.q[0].payload[0]);
+
+  /* Oversized length field is rejected without waiting for its body */
+  const uint8_t bad_len[] = { EVT_BRIDGE_SYNC0, EVT_BRIDGE_SYNC1, 0xFF, 0xFF };
+  evt_bus_bridge_rx(&s_remote_br, bad_len, sizeof(bad_len));
+  TEST_ASSERT_EQUAL_UINT32(1, s_remote_br.stats.rx_format_errors);
+  evt_bus_bridge_rx(&s_remote_br, s_link.buf + f1, s_link.len - f1);
+  TEST_ASSERT_EQUAL_size_t(2, s_ring.count);
+}
+
+static void test_bridge_drops_ids_it_forwards(void)
+{
+  static const evt_id_t ids[] = { 1 };
+  start_local(ids, 1, 0, 0);
+
+  /* Remote frame carrying IDs 1 and 4, built by a second bridge */
+  static const evt_id_t remote_ids[] = { 1, 4 };
+  const evt_bridge_cfg_t cfg = { .ids = remote_ids, .n_ids = 2 };
+  static evt_bridge_t tx;
+  TEST_ASSERT_TRUE(evt_bus_bridge_start(&tx, &s_remote, &s_mem, &cfg));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&s_remote, 1, NULL, 0));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&s_remote, 4, NULL, 0));
+  evt_bus_inst_dispatch_evt(&s_remote, &s_ring.q[0]);
+  evt_bus_inst_dispatch_evt(&s_remote, &s_ring.q[1]);
+  evt_bus_bridge_flush(&tx);
+
+  const int enqueues = g_fake_backend.enqueue_calls;
+  evt_bus_bridge_rx(&s_local_br, s_link.buf, s_link.len);
+  TEST_ASSERT_EQUAL_UINT32(1, s_local_br.stats.rx_looped);
+  TEST_ASSERT_EQUAL_UINT32(1, s_local_br.stats.rx_records);
+  TEST_ASSERT_EQUAL_INT(enqueues + 1, g_fake_backend.enqueue_calls);
+  TEST_ASSERT_EQUAL_UINT16(4, g_fake_backend.last_evt.id);
+}
+
+static void test_bridge_start_rejects_bad_args(void)
+{
+  static const evt_id_t bad[] = { 1, EVT_BUS_MAX_EVT_IDS };
+  const evt_bridge_cfg_t cfg = { .ids = bad, .n_ids = 2 };
+  const evt_bridge_cfg_t too_many = { .ids = bad, .n_ids = EVT_BRIDGE_MAX_IDS + 1 };
+  const evt_bridge_link_t no_write = { .ctx = NULL, .write = NULL };
+  evt_bridge_t br;
+
+  TEST_ASSERT_FALSE(evt_bus_bridge_start(&br, evt_bus_default(), &s_mem, &cfg));
+  TEST_ASSERT_FALSE(evt_bus_bridge_start(&br, evt_bus_default(), &s_mem, &too_many));
+  TEST_ASSERT_FALSE(evt_bus_bridge_start(&br, evt_bus_default(), &no_write, &cfg));
+  TEST_ASSERT_FALSE(evt_bus_bridge_start(&br, evt_bus_default(), &s_mem, NULL));
+
+  /* Stopped bridge no longer forwards */
+  static const evt_id_t ids[] = { 1 };
+  start_local(ids, 1, 1, 0);
+  evt_bus_bridge_stop(&s_local_br);
+  publish_dispatch(1, NULL, 0);
+  TEST_ASSERT_EQUAL_INT(0, s_link.writes);
+}
+
+static void test_bridge_crc16_check_value(void)
+{
+  /* CRC-16/CCITT-FALSE check value */
+  const uint8_t msg[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+  TEST_ASSERT_EQUAL_UINT16(0x29B1, evt_bus_bridge_crc16(0xFFFFu, msg, sizeof(msg)));
+}
+
+#if defined(__linux__)
+static bool fd_write(void *ctx, const uint8_t *data, size_t len)
+{
+  const int fd = *(const int*)ctx;
+  while (len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n <= 0) return false;
+    data += n;
+    len -= (size_t)n;
+  }
+  return true;
+}
+
+static void test_bridge_over_pipe(void)
+{
+  int fds[2];
+  TEST_ASSERT_EQUAL_INT(0, pipe(fds));
+
+  static const evt_id_t ids[] = { 1, 2 };
+  const evt_bridge_link_t link = { .ctx = &fds[1], .write = fd_write };
+  const evt_bridge_cfg_t cfg = { .ids = ids, .n_ids = 2, .max_records = 4 };
+  TEST_ASSERT_TRUE(evt_bus_bridge_start(&s_local_br, evt_bus_default(), &link, &cfg));
+
+  for (uint8_t i = 0; i < 10; i++) {
+    publish_dispatch((evt_id_t)(1 + (i & 1u)), &i, 1);
+  }
+  evt_bus_bridge_flush(&s_local_br);
+  TEST_ASSERT_EQUAL_UINT32(3, s_local_br.stats.tx_frames);
+  close(fds[1]);
+
+  /* Reader side: arbitrary chunking */
+  uint8_t chunk[5];
+  ssize_t n;
+  while ((n = read(fds[0], chunk, sizeof(chunk))) > 0) {
+    evt_bus_bridge_rx(&s_remote_br, chunk, (size_t)n);
+  }
+  close(fds[0]);
+
+  TEST_ASSERT_EQUAL_size_t(10, s_ring.count);
+  for (uint8_t i = 0; i < 10; i++) {
+    TEST_ASSERT_EQUAL_UINT16(1 + (i & 1u), s_ring.q[i].id);
+    TEST_ASSERT_EQUAL_UINT8(i, s_ring.q[i].payload[0]);
+  }
+}
+#endif
+
+/* --------------------------------- Runner --------------------------------- */
+int main(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_bridge_packs_burst_into_one_frame);
+  RUN_TEST(test_bridge_sends_on_max_records_and_delay);
+  RUN_TEST(test_bridge_splits_frames_when_full);
+  RUN_TEST(test_bridge_rx_resyncs_after_garbage_and_crc_error);
+  RUN_TEST(test_bridge_drops_ids_it_forwards);
+  RUN_TEST(test_bridge_start_rejects_bad_args);
+  RUN_TEST(test_bridge_crc16_check_value);
+#if defined(__linux__)
+  RUN_TEST(test_bridge_over_pipe);
+#endif
+
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+/* ========================================================================== */
+/* File: tests/test_evt_bus_cpp.cpp                                           */
+/* ========================================================================== */
+#include <string.h>
+#include "unity.h"
+
+#include "evt_bus/evt_bus.hpp"
+#include "test_helpers.h"
+
+/* ------------------------------ Typed events ------------------------------ */
+
+struct sample_t {
+  int16_t  value;
+  uint8_t  channel;
+};
+
+using evt_sample = evt_bus::event<1, sample_t>;
+using evt_ping   = evt_bus::event<2>;
+using evt_wide   = evt_bus::event<3, uint32_t>;
+
+static_assert(evt_sample::size == sizeof(sample_t), "size known at compile time");
+
+/* ----------------------------- Test receivers ----------------------------- */
+
+static int      s_fn_calls;
+static sample_t s_fn_last;
+
+static void on_sample(const sample_t &s)
+{
+  s_fn_calls++;
+  s_fn_last = s;
+}
+
+static int s_ping_calls;
+static void on_ping() { s_ping_calls++; }
+
+struct receiver {
+  int      calls = 0;
+  uint32_t last = 0;
+  void on_wide(const uint32_t &v) { calls++; last = v; }
+};
+
+static void dispatch_last(void)
+{
+  evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+}
+
+/* ------------------------------ Unity hooks ------------------------------- */
+
+void setUp(void)
+{
+  test_reset_bus();
+  s_fn_calls = 0;
+  s_ping_calls = 0;
+  s_fn_last = sample_t{};
+}
+void tearDown(void) {}
+
+/* --------------------------------- Tests --------------------------------- */
+
+static void test_publish_typed_sets_len_and_payload(void)
+{
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus::publish<evt_sample>(sample_t{-42, 7}));
+
+  TEST_ASSERT_EQUAL_UINT16(1, g_fake_backend.last_evt.id);
+  TEST_ASSERT_EQUAL_UINT16(sizeof(sample_t), g_fake_backend.last_evt.len);
+
+  sample_t out{};
+  TEST_ASSERT_TRUE(evt_bus::payload<evt_sample>(g_fake_backend.last_evt, out));
+  TEST_ASSERT_EQUAL_INT(-42, out.value);
+  TEST_ASSERT_EQUAL_UINT8(7, out.channel);
+
+  /* Wrong descriptor is rejected */
+  uint32_t wide = 0;
+  TEST_ASSERT_FALSE(evt_bus::payload<evt_wide>(g_fake_backend.last_evt, wide));
+}
+
+static void test_subscribe_free_function(void)
+{
+  evt_sub_handle_t h = evt_bus::subscribe<evt_sample, on_sample>();
+  TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, h.id);
+
+  evt_bus::publish<evt_sample>(sample_t{123, 2});
+  dispatch_last();
+
+  TEST_ASSERT_EQUAL_INT(1, s_fn_calls);
+  TEST_ASSERT_EQUAL_INT(123, s_fn_last.value);
+  TEST_ASSERT_EQUAL_UINT8(2, s_fn_last.channel);
+
+  evt_bus::unsubscribe(h);
+  evt_bus::publish<evt_sample>(sample_t{1, 1});
+  dispatch_last();
+  TEST_ASSERT_EQUAL_INT(1, s_fn_calls);
+}
+
+static void test_subscribe_signal_event(void)
+{
+  evt_bus::subscribe<evt_ping, on_ping>();
+
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus::publish<evt_ping>());
+  TEST_ASSERT_EQUAL_UINT16(0, g_fake_backend.last_evt.len);
+  dispatch_last();
+
+  TEST_ASSERT_EQUAL_INT(1, s_ping_calls);
+}
+
+static void test_subscribe_member_function(void)
+{
+  receiver r;
+  evt_sub_handle_t h = evt_bus::subscribe<evt_wide, &receiver::on_wide>(r);
+  TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID, h.id);
+
+  evt_bus::publish<evt_wide>(0xDEADBEEFu);
+  dispatch_last();
+
+  TEST_ASSERT_EQUAL_INT(1, r.calls);
+  TEST_ASSERT_EQUAL_UINT32(0xDEADBEEFu, r.last);
+}
+
+static void test_subscribe_capturing_lambda(void)
+{
+  int total = 0;
+  auto acc = [&total](const sample_t &s) { total += s.value; };
+
+  evt_bus::subscribe<evt_sample>(acc);
+
+  evt_bus::publish<evt_sample>(sample_t{10, 0});
+  dispatch_last();
+  evt_bus::publish<evt_sample>(sample_t{5, 0});
+  dispatch_last();
+
+  TEST_ASSERT_EQUAL_INT(15, total);
+}
+
+static void test_length_mismatch_from_c_publisher_is_ignored(void)
+{
+  evt_bus::subscribe<evt_sample, on_sample>();
+
+  const uint8_t raw[1] = { 0x55 };
+  TEST_ASSERT_TRUE(evt_bus_publish(evt_sample::id, raw, sizeof(raw)));
+  dispatch_last();
+
+  TEST_ASSERT_EQUAL_INT(0, s_fn_calls);
+}
+
+/* --------------------------------- Runner --------------------------------- */
+int main(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_publish_typed_sets_len_and_payload);
+  RUN_TEST(test_subscribe_free_function);
+  RUN_TEST(test_subscribe_signal_event);
+  RUN_TEST(test_subscribe_member_function);
+  RUN_TEST(test_subscribe_capturing_lambda);
+  RUN_TEST(test_length_mismatch_from_c_publisher_is_ignored);
+
+  return UNITY_END();
+}
@@ -0,0 +1,365 @@
+/* ========================================================================== */
+/* File: tests/test_evt_bus_freertos.c                                        */
+/* ========================================================================== */
+/* Runs ports/freertos unmodified on the pthread FreeRTOS simulation
+ * (tests/freertos_sim): real queue, mutex, dispatcher task and heartbeat. */
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <string.h>
+#include "unity.h"
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus_port_freertos.h"
+
+/* ------------------------------ Test fixtures ----------------------------- */
+
+typedef struct {
+  int       calls;          /* atomic: written by the dispatcher task */
+  uint8_t   seen[32];
+  pthread_t thread;
+} rx_probe_t;
+
+static void cb_rx(const evt_t *evt, void *user_ctx)
+{
+  rx_probe_t *p = (rx_probe_t*)user_ctx;
+  int n = __atomic_load_n(&p->calls, __ATOMIC_RELAXED);
+  if (n < (int)sizeof(p->seen)) {
+    p->seen[n] = (evt->len > 0) ? evt->payload[0] : 0xFF;
+  }
+  p->thread = pthread_self();
+  __atomic_store_n(&p->calls, n + 1, __ATOMIC_RELEASE);
+}
+
+/* Holds the dispatcher task inside a callback until released */
+typedef struct {
+  int entered;
+  int release;
+} gate_t;
+
+static void cb_gate(const evt_t *evt, void *user_ctx)
+{
+  (void)evt;
+  gate_t *g = (gate_t*)user_ctx;
+  __atomic_store_n(&g->entered, 1, __ATOMIC_RELEASE);
+  while (!__atomic_load_n(&g->release, __ATOMIC_ACQUIRE)) {
+    vTaskDelay(1);
+  }
+}
+
+static bool wait_flag(const int *flag, int value, uint32_t timeout_ms)
+{
+  TickType_t start = xTaskGetTickCount();
+  while (__atomic_load_n(flag, __ATOMIC_ACQUIRE) < value) {
+    if ((TickType_t)(xTaskGetTickCount() - start) > pdMS_TO_TICKS(timeout_ms)) {
+      return false;
+    }
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+static evt_pub_result_t publish_u8(evt_bus_t *bus, evt_id_t id, uint8_t v)
+{
+  return evt_bus_inst_publish_ex(bus, id, &v, sizeof(v));
+}
+
+/* ------------------------------ Unity hooks ------------------------------- */
+
+void setUp(void) {}
+void tearDown(void) {}
+
+/* --------------------------------- Tests --------------------------------- */
+
+static void test_default_bus_dispatches_on_task(void)
+{
+  static rx_probe_t p;
+
+  evt_bus_init();
+  evt_bus_subscribe(1, cb_rx, &p);
+
+  for (uint8_t i = 0; i < 3; i++) {
+    TEST_ASSERT_TRUE(evt_bus_publish(1, &i, sizeof(i)));
+  }
+  TEST_ASSERT_TRUE(wait_flag(&p.calls, 3, 1000));
+
+  TEST_ASSERT_EQUAL_UINT8(0, p.seen[0]);
+  TEST_ASSERT_EQUAL_UINT8(1, p.seen[1]);
+  TEST_ASSERT_EQUAL_UINT8(2, p.seen[2]);
+  TEST_ASSERT_FALSE(pthread_equal(p.thread, pthread_self()));
+#if EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS > 0
+  /* Progress counters are kept by the heartbeat loop */
+  TEST_ASSERT_EQUAL_UINT32(3, evt_bus_freertos_hb_events_dispatched());
+#endif
+}
+
+static void test_backpressure_on_real_queue(void)
+{
+  static evt_bus_t          bus;
+  static evt_bus_freertos_t port;
+  static gate_t             gate;
+  static rx_probe_t         p;
+
+  const evt_bus_freertos_cfg_t cfg = { .queue_depth = 3 };
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port, &bus, &cfg));
+  evt_bus_inst_subscribe(&bus, 0, cb_gate, &gate);
+  evt_bus_inst_subscribe(&bus, 1, cb_rx, &p);
+
+  /* Park the dispatcher, then fill the queue */
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_ex(&bus, 0, NULL, 0));
+  TEST_ASSERT_TRUE(wait_flag(&gate.entered, 1, 1000));
+  for (uint8_t i = 1; i <= 3; i++) {
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus, 1, i));
+  }
+
+  /* Drop-new (default) */
+  TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, publish_u8(&bus, 1, 9));
+
+  /* Block: times out on the real queue */
+  const evt_policy_t block = { .mode = EVT_BP_BLOCK, .timeout_ms = 20 };
+  TEST_ASSERT_TRUE(evt_bus_inst_set_policy(&bus, 1, &block));
+  TickType_t t0 = xTaskGetTickCount();
+  TEST_ASSERT_EQUAL(EVT_PUB_ERR_TIMEOUT, publish_u8(&bus, 1, 9));
+  TEST_ASSERT_TRUE((TickType_t)(xTaskGetTickCount() - t0) >= pdMS_TO_TICKS(20) - 1);
+
+  /* Drop-oldest: evicts 1 */
+  const evt_policy_t oldest = { .mode = EVT_BP_DROP_OLDEST };
+  TEST_ASSERT_TRUE(evt_bus_inst_set_policy(&bus, 1, &oldest));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(&bus, 1, 4));
+
+  __atomic_store_n(&gate.release, 1, __ATOMIC_RELEASE);
+  TEST_ASSERT_TRUE(wait_flag(&p.calls, 3, 1000));
+  TEST_ASSERT_EQUAL_UINT8(2, p.seen[0]);
+  TEST_ASSERT_EQUAL_UINT8(3, p.seen[1]);
+  TEST_ASSERT_EQUAL_UINT8(4, p.seen[2]);
+}
+
+static void test_isr_publish_and_heartbeat(void)
+{
+  static evt_bus_t          bus;
+  static evt_bus_freertos_t port;
+  static rx_probe_t         p;
+
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port, &bus, NULL));
+  evt_bus_inst_subscribe(&bus, 2, cb_rx, &p);
+
+  const uint8_t v = 0x5A;
+  TEST_ASSERT_TRUE(evt_bus_inst_publish_from_isr(&bus, 2, &v, sizeof(v)));
+  TEST_ASSERT_TRUE(wait_flag(&p.calls, 1, 1000));
+  TEST_ASSERT_EQUAL_UINT8(0x5A, p.seen[0]);
+
+#if EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS > 0
+  /* Idle dispatcher still beats */
+  const evt_bus_fr_hb_t *hb = evt_bus_freertos_inst_hb(&port);
+  uint32_t beats = hb->beat_count;
+  vTaskDelay(pdMS_TO_TICKS(5 * EVT_BUS_FREERTOS_HEARTBEAT_TICKS_MS));
+  TEST_ASSERT_TRUE(hb->beat_count > beats);
+  TEST_ASSERT_EQUAL_UINT32(1, hb->events_dispatched);
+#endif
+}
+
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+static void cb_batch_count(const evt_t *evts, size_t n, void *user_ctx)
+{
+  (void)evts;
+  __atomic_fetch_add((int *)user_ctx, (int)n, __ATOMIC_RELEASE);
+}
+
+static void test_batch_window_closes_while_idle(void)
+{
+  static evt_bus_t          bus;
+  static evt_bus_freertos_t port;
+  static int                delivered;
+
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port, &bus, NULL));
+  const evt_batch_cfg_t cfg = { .max_events = EVT_BUS_BATCH_MAX_EVENTS, .window_us = 20000 };
+  TEST_ASSERT_NOT_EQUAL(EVT_HANDLE_ID_INVALID,
+                        evt_bus_inst_subscribe_batch(&bus, 5, cb_batch_count, &cfg, &delivered).id);
+
+  /* The stream stops mid-window: the idle dispatcher must still flush it */
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus, 5, 1));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus, 5, 2));
+  TEST_ASSERT_TRUE(wait_flag(&delivered, 2, 1000));
+}
+#endif
+
+static void test_instances_have_separate_dispatchers(void)
+{
+  static evt_bus_t          bus_a, bus_b;
+  static evt_bus_freertos_t port_a, port_b;
+  static rx_probe_t         pa, pb;
+
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port_a, &bus_a, NULL));
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port_b, &bus_b, NULL));
+  evt_bus_inst_subscribe(&bus_a, 1, cb_rx, &pa);
+  evt_bus_inst_subscribe(&bus_b, 1, cb_rx, &pb);
+
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 0xA));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_b, 1, 0xB));
+  TEST_ASSERT_TRUE(wait_flag(&pa.calls, 1, 1000));
+  TEST_ASSERT_TRUE(wait_flag(&pb.calls, 1, 1000));
+
+  TEST_ASSERT_EQUAL_UINT8(0xA, pa.seen[0]);
+  TEST_ASSERT_EQUAL_UINT8(0xB, pb.seen[0]);
+  TEST_ASSERT_FALSE(pthread_equal(pa.thread, pb.thread));
+}
+
+static evt_bus_t s_wait_bus;
+
+static void publish_later_task(void *arg)
+{
+  (void)arg;
+  vTaskDelay(pdMS_TO_TICKS(20));
+  (void)publish_u8(&s_wait_bus, 3, 0x77);
+  for (;;) {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static void test_wait_for_wakes_blocked_task(void)
+{
+  static evt_bus_freertos_t port;
+
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port, &s_wait_bus, NULL));
+  TEST_ASSERT_EQUAL(pdPASS, xTaskCreate(publish_later_task, "pub", 256, NULL, 1, NULL));
+
+  evt_t out;
+  memset(&out, 0, sizeof(out));
+  TEST_ASSERT_TRUE(evt_bus_inst_wait_for(&s_wait_bus, 3, &out, 1000));
+  TEST_ASSERT_EQUAL_UINT16(3, out.id);
+  TEST_ASSERT_EQUAL_UINT8(0x77, out.payload[0]);
+
+  /* Nothing published: times out */
+  TickType_t t0 = xTaskGetTickCount();
+  TEST_ASSERT_FALSE(evt_bus_inst_wait_for(&s_wait_bus, 4, NULL, 20));
+  TEST_ASSERT_TRUE((TickType_t)(xTaskGetTickCount() - t0) >= pdMS_TO_TICKS(20) - 1);
+}
+
+#if EVT_BUS_LIVENESS
+static void test_ping_detects_stuck_callback(void)
+{
+  static evt_bus_t          bus;
+  static evt_bus_freertos_t port;
+  static gate_t             gate;
+
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port, &bus, NULL));
+  evt_bus_inst_subscribe(&bus, 8, cb_gate, &gate);
+
+  /* Idle dispatcher answers */
+  uint32_t ticket = 0;
+  TEST_ASSERT_TRUE(evt_bus_inst_ping(&bus, &ticket));
+  TickType_t t0 = xTaskGetTickCount();
+  while (!evt_bus_inst_ping_acked(&bus, ticket) &&
+         (TickType_t)(xTaskGetTickCount() - t0) < pdMS_TO_TICKS(1000)) {
+    vTaskDelay(1);
+  }
+  TEST_ASSERT_TRUE(evt_bus_inst_ping_acked(&bus, ticket));
+
+  /* Callback stuck: the ping stays unanswered and liveness names the event */
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus, 8, 0));
+  TEST_ASSERT_TRUE(wait_flag(&gate.entered, 1, 1000));
+  TEST_ASSERT_TRUE(evt_bus_inst_ping(&bus, &ticket));
+  vTaskDelay(pdMS_TO_TICKS(20));
+  TEST_ASSERT_FALSE(evt_bus_inst_ping_acked(&bus, ticket));
+
+  evt_bus_liveness_t live;
+  evt_bus_inst_liveness(&bus, &live);
+  TEST_ASSERT_TRUE(live.busy);
+  TEST_ASSERT_EQUAL_UINT(8, live.busy_id);
+  TEST_ASSERT_TRUE(port.backend.now_us(port.backend.ctx) - live.busy_since_us >= 15000u);
+
+  __atomic_store_n(&gate.release, 1, __ATOMIC_RELEASE);
+  t0 = xTaskGetTickCount();
+  while (!evt_bus_inst_ping_acked(&bus, ticket) &&
+         (TickType_t)(xTaskGetTickCount() - t0) < pdMS_TO_TICKS(1000)) {
+    vTaskDelay(1);
+  }
+  TEST_ASSERT_TRUE(evt_bus_inst_ping_acked(&bus, ticket));
+}
+#endif
+
+#if EVT_BUS_FANOUT_WORKERS > 0
+/* Each callback waits until all three contexts are inside: only passes if the
+ * dispatcher and both workers run the fanout at the same time */
+typedef struct {
+  int inside;
+  int done;
+} fan_probe_t;
+
+static void cb_fan(const evt_t *evt, void *user_ctx)
+{
+  (void)evt;
+  fan_probe_t *f = (fan_probe_t*)user_ctx;
+  __atomic_add_fetch(&f->inside, 1, __ATOMIC_ACQ_REL);
+  (void)wait_flag(&f->inside, EVT_BUS_FANOUT_WORKERS + 1, 1000);
+  __atomic_add_fetch(&f->done, 1, __ATOMIC_ACQ_REL);
+}
+
+static int s_fan_done_at_next;
+
+static void cb_fan_next(const evt_t *evt, void *user_ctx)
+{
+  (void)evt;
+  const fan_probe_t *f = (const fan_probe_t*)user_ctx;
+  s_fan_done_at_next = __atomic_load_n(&f->done, __ATOMIC_ACQUIRE) + 1;
+}
+
+static void test_parallel_fanout_on_workers(void)
+{
+  static evt_bus_t          bus;
+  static evt_bus_freertos_t port;
+  static fan_probe_t        f;
+
+  TEST_ASSERT_TRUE(evt_bus_freertos_inst_init(&port, &bus, NULL));
+  for (unsigned i = 0; i < EVT_BUS_FANOUT_WORKERS + 1; i++) {
+    evt_bus_inst_subscribe(&bus, 6, cb_fan, &f);
+  }
+  evt_bus_inst_subscribe(&bus, 7, cb_fan_next, &f);
+  TEST_ASSERT_TRUE(evt_bus_inst_set_parallel(&bus, 6, true));
+
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus, 6, 1));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus, 7, 2));
+  TEST_ASSERT_TRUE(wait_flag(&s_fan_done_at_next, 1, 1000));
+
+  /* All shares joined before the next event was dispatched */
+  TEST_ASSERT_EQUAL_INT(EVT_BUS_FANOUT_WORKERS + 1, s_fan_done_at_next - 1);
+  TEST_ASSERT_EQUAL_INT(EVT_BUS_FANOUT_WORKERS + 1, f.inside);
+}
+#endif
+
+#if EVT_BUS_FREERTOS_STATIC
+static void test_static_rejects_oversized_cfg(void)
+{
+  static evt_bus_t          bus;
+  static evt_bus_freertos_t port;
+
+  const evt_bus_freertos_cfg_t cfg = { .queue_depth = EVT_BUS_FREERTOS_QUEUE_DEPTH + 1 };
+  TEST_ASSERT_FALSE(evt_bus_freertos_inst_init(&port, &bus, &cfg));
+}
+#endif
+
+/* --------------------------------- Runner --------------------------------- */
+int main(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_default_bus_dispatches_on_task);
+  RUN_TEST(test_backpressure_on_real_queue);
+  RUN_TEST(test_isr_publish_and_heartbeat);
+  RUN_TEST(test_instances_have_separate_dispatchers);
+  RUN_TEST(test_wait_for_wakes_blocked_task);
+#if EVT_BUS_MAX_BATCH_SUBS > 0
+  RUN_TEST(test_batch_window_closes_while_idle);
+#endif
+#if EVT_BUS_FANOUT_WORKERS > 0
+  RUN_TEST(test_parallel_fanout_on_workers);
+#endif
+#if EVT_BUS_LIVENESS
+  RUN_TEST(test_ping_detects_stuck_callback);
+#endif
+#if EVT_BUS_FREERTOS_STATIC
+  RUN_TEST(test_static_rejects_oversized_cfg);
+#endif
+
+  return UNITY_END();
+}
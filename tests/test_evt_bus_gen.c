@@ -0,0 +1,99 @@
+/* ========================================================================== */
+/* File: tests/test_evt_bus_gen.c                                             */
+/* ========================================================================== */
+/* Built against tests/gen_test_events.json through evt_bus_generate_events() */
+#include <string.h>
+#include "unity.h"
+
+#include "evt_bus/evt_bus.h"
+#include "gen_test_events.h"
+#include "test_helpers.h"
+
+/* ------------------------------ Unity hooks ------------------------------- */
+
+void setUp(void)
+{
+  test_reset_bus();
+}
+
+void tearDown(void) {}
+
+/* --------------------------------- Tests ---------------------------------- */
+
+static void test_gen_config_sized_from_schema(void)
+{
+  TEST_ASSERT_EQUAL_UINT(3, GEN_TEST_EVT_COUNT);
+  TEST_ASSERT_EQUAL_UINT(GEN_TEST_EVT_COUNT, EVT_BUS_MAX_EVT_IDS);
+  TEST_ASSERT_EQUAL_UINT(1, EVT_BUS_MAX_RETAINED);
+
+  /* imu_raw is the largest payload: 4 + 6 * 2 bytes, packed */
+  TEST_ASSERT_EQUAL_UINT(16, sizeof(gen_test_imu_raw_t));
+  TEST_ASSERT_EQUAL_UINT(16, EVT_INLINE_MAX);
+  TEST_ASSERT_EQUAL_UINT(3, sizeof(gen_test_temp_sample_t));
+  TEST_ASSERT_EQUAL_UINT(0, GEN_TEST_EVT_LINK_UP_LEN);
+}
+
+static void test_gen_meta_table_matches_schema(void)
+{
+  const gen_test_evt_meta_t *m = gen_test_evt_meta;
+
+  TEST_ASSERT_EQUAL(EVT_BP_DROP_NEW, m[GEN_TEST_EVT_LINK_UP].policy.mode);
+  TEST_ASSERT_TRUE(m[GEN_TEST_EVT_LINK_UP].policy.critical);
+  TEST_ASSERT_FALSE(m[GEN_TEST_EVT_LINK_UP].retained);
+
+  TEST_ASSERT_EQUAL(EVT_BP_DROP_OLDEST, m[GEN_TEST_EVT_TEMP_SAMPLE].policy.mode);
+  TEST_ASSERT_TRUE(m[GEN_TEST_EVT_TEMP_SAMPLE].retained);
+  TEST_ASSERT_EQUAL_UINT(3, m[GEN_TEST_EVT_TEMP_SAMPLE].len);
+
+  TEST_ASSERT_EQUAL(EVT_BP_BLOCK, m[GEN_TEST_EVT_IMU_RAW].policy.mode);
+  TEST_ASSERT_EQUAL_UINT(5, m[GEN_TEST_EVT_IMU_RAW].policy.timeout_ms);
+}
+
+static void test_gen_apply_loads_policies_and_retained(void)
+{
+  evt_bus_t *bus = evt_bus_default();
+  TEST_ASSERT_TRUE(gen_test_events_apply(bus));
+
+  TEST_ASSERT_TRUE(bus->policies[GEN_TEST_EVT_LINK_UP].critical);
+  TEST_ASSERT_EQUAL(EVT_BP_DROP_OLDEST, bus->policies[GEN_TEST_EVT_TEMP_SAMPLE].mode);
+  TEST_ASSERT_EQUAL(EVT_BP_BLOCK, bus->policies[GEN_TEST_EVT_IMU_RAW].mode);
+  TEST_ASSERT_EQUAL_UINT(0, bus->retained_slot[GEN_TEST_EVT_LINK_UP]);
+  TEST_ASSERT_NOT_EQUAL(0, bus->retained_slot[GEN_TEST_EVT_TEMP_SAMPLE]);
+}
+
+static void test_gen_typed_publish_roundtrip(void)
+{
+  evt_bus_t *bus = evt_bus_default();
+  TEST_ASSERT_TRUE(gen_test_events_apply(bus));
+
+  const gen_test_temp_sample_t t = { .centi_c = -1250, .sensor = 7 };
+  TEST_ASSERT_TRUE(evt_pub_ok(gen_test_publish_temp_sample(bus, &t)));
+  TEST_ASSERT_TRUE(g_fake_backend.has_evt);
+  TEST_ASSERT_EQUAL_UINT(GEN_TEST_EVT_TEMP_SAMPLE, g_fake_backend.last_evt.id);
+  TEST_ASSERT_EQUAL_UINT(sizeof(t), g_fake_backend.last_evt.len);
+
+  /* Retained after dispatch; payload reads back through the generated struct */
+  evt_bus_dispatch_evt(&g_fake_backend.last_evt);
+  evt_t last;
+  TEST_ASSERT_TRUE(evt_bus_inst_get_retained(bus, GEN_TEST_EVT_TEMP_SAMPLE, &last));
+  gen_test_temp_sample_t got;
+  memcpy(&got, last.payload, sizeof(got));
+  TEST_ASSERT_EQUAL_INT(-1250, got.centi_c);
+  TEST_ASSERT_EQUAL_UINT(7, got.sensor);
+
+  TEST_ASSERT_TRUE(evt_pub_ok(gen_test_publish_link_up(bus)));
+  TEST_ASSERT_EQUAL_UINT(GEN_TEST_EVT_LINK_UP, g_fake_backend.last_evt.id);
+  TEST_ASSERT_EQUAL_UINT(0, g_fake_backend.last_evt.len);
+}
+
+int main(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_gen_config_sized_from_schema);
+  RUN_TEST(test_gen_meta_table_matches_schema);
+  RUN_TEST(test_gen_apply_loads_policies_and_retained);
+  RUN_TEST(test_gen_typed_publish_roundtrip);
+
+  return UNITY_END();
+}
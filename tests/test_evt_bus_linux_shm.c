@@ -0,0 +1,359 @@
+/* ========================================================================== */
+/* File: tests/test_evt_bus_linux_shm.c                                       */
+/* ========================================================================== */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "unity.h"
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus_port_linux_shm.h"
+
+/* ------------------------------ Test fixtures ----------------------------- */
+
+static char s_name[64];
+
+static evt_bus_t           bus_a, bus_b;
+static evt_bus_linux_shm_t port_a, port_b;
+
+typedef struct {
+  int     calls;
+  uint8_t seen[64];
+} rx_probe_t;
+
+static void cb_rx(const evt_t *evt, void *user_ctx)
+{
+  rx_probe_t *p = (rx_probe_t*)user_ctx;
+  if (p->calls < (int)sizeof(p->seen)) {
+    p->seen[p->calls] = (evt->len > 0) ? evt->payload[0] : 0xFF;
+  }
+  p->calls++;
+}
+
+static evt_pub_result_t publish_u8(evt_bus_t *bus, evt_id_t id, uint8_t v)
+{
+  return evt_bus_inst_publish_ex(bus, id, &v, sizeof(v));
+}
+
+static bool open_port(evt_bus_linux_shm_t *port, evt_bus_t *bus,
+                      uint32_t capacity, bool create, bool reader)
+{
+  const evt_bus_linux_shm_cfg_t cfg = {
+    .name = s_name, .capacity = capacity, .create = create, .reader = reader,
+  };
+  return evt_bus_linux_shm_inst_init(port, bus, &cfg);
+}
+
+/* ------------------------------ Unity hooks ------------------------------- */
+
+void setUp(void)
+{
+  static unsigned n;
+  snprintf(s_name, sizeof(s_name), "/evt_bus_test_%d_%u", (int)getpid(), n++);
+  memset(&port_a, 0, sizeof(port_a));
+  memset(&port_b, 0, sizeof(port_b));
+}
+
+void tearDown(void)
+{
+  evt_bus_linux_shm_close(&port_b);
+  evt_bus_linux_shm_close(&port_a);
+}
+
+/* --------------------------------- Tests --------------------------------- */
+
+static void test_every_reader_receives_every_event(void)
+{
+  rx_probe_t pa = {0}, pb = {0};
+
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 8, true, true));
+  TEST_ASSERT_TRUE(open_port(&port_b, &bus_b, 0, false, true));
+  evt_bus_inst_subscribe(&bus_a, 1, cb_rx, &pa);
+  evt_bus_inst_subscribe(&bus_b, 1, cb_rx, &pb);
+
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 10));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_b, 1, 11));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 12));
+
+  TEST_ASSERT_EQUAL_size_t(3, evt_bus_linux_shm_dispatch(&port_a, 0));
+  TEST_ASSERT_EQUAL_size_t(3, evt_bus_linux_shm_dispatch(&port_b, 0));
+
+  const uint8_t expect[3] = { 10, 11, 12 };
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, pa.seen, 3);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, pb.seen, 3);
+  TEST_ASSERT_EQUAL_size_t(0, evt_bus_linux_shm_dispatch(&port_a, 0));
+}
+
+static void test_slowest_reader_bounds_producers(void)
+{
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 4, true, true));
+  TEST_ASSERT_TRUE(open_port(&port_b, &bus_b, 0, false, true));
+
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, i));
+  }
+  TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, publish_u8(&bus_a, 1, 4));
+
+  /* A drains, B still pins the ring */
+  TEST_ASSERT_EQUAL_size_t(4, evt_bus_linux_shm_dispatch(&port_a, 0));
+  TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, publish_u8(&bus_a, 1, 4));
+
+  TEST_ASSERT_EQUAL_size_t(4, evt_bus_linux_shm_dispatch(&port_b, 0));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 4));
+}
+
+static void test_drop_oldest_skips_lagging_readers(void)
+{
+  rx_probe_t pb = {0};
+
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 4, true, false));
+  TEST_ASSERT_TRUE(open_port(&port_b, &bus_b, 0, false, true));
+  evt_bus_inst_subscribe(&bus_b, 1, cb_rx, &pb);
+
+  const evt_policy_t pol = { .mode = EVT_BP_DROP_OLDEST };
+  TEST_ASSERT_TRUE(evt_bus_inst_set_policy(&bus_a, 1, &pol));
+
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, i));
+  }
+  TEST_ASSERT_EQUAL(EVT_PUB_OK_DROPPED_OLDEST, publish_u8(&bus_a, 1, 4));
+
+  TEST_ASSERT_EQUAL_size_t(4, evt_bus_linux_shm_dispatch(&port_b, 0));
+  const uint8_t expect[4] = { 1, 2, 3, 4 };
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expect, pb.seen, 4);
+}
+
+static void test_producer_without_readers_never_blocks(void)
+{
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 4, true, false));
+
+  for (uint8_t i = 0; i < 16; i++) {
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, i));
+  }
+}
+
+#if EVT_BUS_MAX_PUBLISHERS > 0
+static void test_inflight_quota_refused_rate_limit_kept(void)
+{
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 8, true, true));
+
+  /* Dispatch on another bus never returns in-flight credit to this one */
+  const evt_pub_quota_t inflight = { .max_inflight = 2 };
+  TEST_ASSERT_EQUAL_UINT8(EVT_PUB_ID_NONE, evt_bus_inst_publisher_register(&bus_a, &inflight));
+
+  const evt_pub_quota_t rate = { .rate_per_sec = 1, .burst = 2 };
+  const evt_pub_id_t pub = evt_bus_inst_publisher_register(&bus_a, &rate);
+  TEST_ASSERT_NOT_EQUAL(EVT_PUB_ID_NONE, pub);
+
+  const uint8_t v = 1;
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_as(&bus_a, pub, 1, &v, sizeof(v)));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_inst_publish_as(&bus_a, pub, 1, &v, sizeof(v)));
+  TEST_ASSERT_EQUAL(EVT_PUB_ERR_RATE, evt_bus_inst_publish_as(&bus_a, pub, 1, &v, sizeof(v)));
+  TEST_ASSERT_EQUAL_size_t(2, evt_bus_linux_shm_dispatch(&port_a, 0));
+}
+#endif
+
+#if EVT_BUS_MAX_DEDUP > 0
+static void test_dedup_uses_window_only(void)
+{
+  rx_probe_t pb = {0};
+
+  /* Producer-only bus: a copy it publishes is dispatched by the reader's bus */
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 8, true, false));
+  TEST_ASSERT_TRUE(open_port(&port_b, &bus_b, 0, false, true));
+  evt_bus_inst_subscribe(&bus_b, 1, cb_rx, &pb);
+
+  const evt_dedup_cfg_t pending = { .window_us = 0 };
+  TEST_ASSERT_FALSE(evt_bus_inst_set_dedup(&bus_a, 1, &pending));
+
+  const evt_dedup_cfg_t window = { .window_us = 2000 };
+  TEST_ASSERT_TRUE(evt_bus_inst_set_dedup(&bus_a, 1, &window));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 7));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK_DUPLICATE, publish_u8(&bus_a, 1, 7));
+  TEST_ASSERT_EQUAL_size_t(1, evt_bus_linux_shm_dispatch(&port_b, 0));
+
+  /* Once the window has passed the same value is accepted again */
+  const struct timespec pause = { .tv_sec = 0, .tv_nsec = 5000000L };
+  nanosleep(&pause, NULL);
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 7));
+  TEST_ASSERT_EQUAL_size_t(1, evt_bus_linux_shm_dispatch(&port_b, 0));
+  TEST_ASSERT_EQUAL_INT(2, pb.calls);
+}
+#endif
+
+#if EVT_BUS_ENVELOPE_META
+static void test_meta_skips_sequence_checks(void)
+{
+  evt_meta_stats_t ms;
+
+  /* Two publishing buses number their events independently */
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 8, true, false));
+  TEST_ASSERT_TRUE(open_port(&port_b, &bus_b, 0, false, true));
+
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 0));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 1));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_b, 1, 2));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 3));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_b, 1, 4));
+  TEST_ASSERT_EQUAL_size_t(5, evt_bus_linux_shm_dispatch(&port_b, 0));
+
+  TEST_ASSERT_TRUE(evt_bus_inst_meta_stats(&bus_b, &ms));
+  TEST_ASSERT_EQUAL_UINT32(5, ms.dispatched);
+  TEST_ASSERT_EQUAL_UINT32(0, ms.seq_gaps);
+  TEST_ASSERT_EQUAL_UINT32(0, ms.seq_reordered);
+}
+#endif
+
+static void test_attach_requires_existing_segment(void)
+{
+  TEST_ASSERT_FALSE(open_port(&port_b, &bus_b, 0, false, true));
+  TEST_ASSERT_FALSE(open_port(&port_a, &bus_a, 3, true, true));   /* not a power of two */
+}
+
+#define XPROC_EVENTS 200
+
+static void test_cross_process_producer_wakes_reader(void)
+{
+  rx_probe_t pa = {0};
+
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 16, true, true));
+  evt_bus_inst_subscribe(&bus_a, 2, cb_rx, &pa);
+
+  pid_t child = fork();
+  TEST_ASSERT_TRUE(child >= 0);
+
+  if (child == 0) {
+    /* Producer process: own bus + mapping, blocks while the parent's cursor pins the ring */
+    static evt_bus_t bus_c;
+    static evt_bus_linux_shm_t port_c;
+    if (!open_port(&port_c, &bus_c, 0, false, false)) _exit(1);
+
+    const evt_policy_t pol = { .mode = EVT_BP_BLOCK, .timeout_ms = 2000 };
+    evt_bus_inst_set_policy(&bus_c, 2, &pol);
+
+    for (int i = 0; i < XPROC_EVENTS; i++) {
+      if (publish_u8(&bus_c, 2, (uint8_t)i) != EVT_PUB_OK) _exit(2);
+    }
+    evt_bus_linux_shm_close(&port_c);
+    _exit(0);
+  }
+
+  uint8_t next = 0;
+  int in_order = 1;
+  int total = 0;
+  while (total < XPROC_EVENTS) {
+    int before = pa.calls;
+    if (evt_bus_linux_shm_dispatch(&port_a, 2000) == 0) break;
+    for (int i = before; i < pa.calls && i < (int)sizeof(pa.seen); i++) {
+      in_order &= (pa.seen[i] == next++);
+    }
+    total = pa.calls;
+  }
+
+  int status = 0;
+  TEST_ASSERT_EQUAL(child, waitpid(child, &status, 0));
+  TEST_ASSERT_TRUE(WIFEXITED(status));
+  TEST_ASSERT_EQUAL_INT(0, WEXITSTATUS(status));
+  TEST_ASSERT_EQUAL_INT(XPROC_EVENTS, total);
+  TEST_ASSERT_TRUE(in_order);
+}
+
+#if EVT_BUS_LIVENESS
+static void test_ping_refused_and_foreign_tickets_ignored(void)
+{
+  evt_bus_liveness_t lv;
+
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 8, true, true));
+  TEST_ASSERT_FALSE(evt_bus_inst_ping(&bus_a, NULL));
+
+  pid_t child = fork();
+  TEST_ASSERT_TRUE(child >= 0);
+
+  if (child == 0) {
+    static evt_bus_t bus_c;
+    static evt_bus_linux_shm_t port_c;
+    if (!open_port(&port_c, &bus_c, 0, false, false)) _exit(1);
+    if (evt_bus_inst_ping(&bus_c, NULL)) _exit(2);
+
+    /* A publisher unaware of remote dispatch still gets its ping into the ring */
+    static evt_bus_backend_t unaware;
+    unaware = *bus_c.backend;
+    unaware.remote_dispatch = false;
+    bus_c.backend = &unaware;
+    uint32_t ticket = 0;
+    if (!evt_bus_inst_ping(&bus_c, &ticket) || ticket != 1u) _exit(3);
+    evt_bus_linux_shm_close(&port_c);
+    _exit(0);
+  }
+
+  int status = 0;
+  TEST_ASSERT_EQUAL(child, waitpid(child, &status, 0));
+  TEST_ASSERT_TRUE(WIFEXITED(status));
+  TEST_ASSERT_EQUAL_INT(0, WEXITSTATUS(status));
+
+  /* The reader dispatches the foreign ping without taking its ticket */
+  TEST_ASSERT_EQUAL_size_t(1, evt_bus_linux_shm_dispatch(&port_a, 0));
+  evt_bus_inst_liveness(&bus_a, &lv);
+  TEST_ASSERT_EQUAL_UINT32(0, lv.pings_sent);
+  TEST_ASSERT_EQUAL_UINT32(0, lv.pings_acked);
+  TEST_ASSERT_FALSE(evt_bus_inst_ping_acked(&bus_a, 1));
+}
+#endif
+
+static void test_reap_releases_dead_reader(void)
+{
+  TEST_ASSERT_TRUE(open_port(&port_a, &bus_a, 4, true, false));
+
+  pid_t child = fork();
+  TEST_ASSERT_TRUE(child >= 0);
+  if (child == 0) {
+    /* Reader that exits without closing */
+    static evt_bus_t bus_c;
+    static evt_bus_linux_shm_t port_c;
+    _exit(open_port(&port_c, &bus_c, 0, false, true) ? 0 : 1);
+  }
+
+  int status = 0;
+  TEST_ASSERT_EQUAL(child, waitpid(child, &status, 0));
+  TEST_ASSERT_EQUAL_INT(0, WEXITSTATUS(status));
+
+  for (uint8_t i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, i));
+  }
+  TEST_ASSERT_EQUAL(EVT_PUB_ERR_FULL, publish_u8(&bus_a, 1, 4));
+
+  TEST_ASSERT_EQUAL_UINT32(1, evt_bus_linux_shm_reap(&port_a));
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, publish_u8(&bus_a, 1, 4));
+}
+
+/* --------------------------------- Runner --------------------------------- */
+int main(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_every_reader_receives_every_event);
+  RUN_TEST(test_slowest_reader_bounds_producers);
+  RUN_TEST(test_drop_oldest_skips_lagging_readers);
+  RUN_TEST(test_producer_without_readers_never_blocks);
+#if EVT_BUS_MAX_PUBLISHERS > 0
+  RUN_TEST(test_inflight_quota_refused_rate_limit_kept);
+#endif
+#if EVT_BUS_MAX_DEDUP > 0
+  RUN_TEST(test_dedup_uses_window_only);
+#endif
+#if EVT_BUS_ENVELOPE_META
+  RUN_TEST(test_meta_skips_sequence_checks);
+#endif
+  RUN_TEST(test_attach_requires_existing_segment);
+  RUN_TEST(test_cross_process_producer_wakes_reader);
+#if EVT_BUS_LIVENESS
+  RUN_TEST(test_ping_refused_and_foreign_tickets_ignored);
+#endif
+  RUN_TEST(test_reap_releases_dead_reader);
+
+  return UNITY_END();
+}
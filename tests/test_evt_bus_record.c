@@ -0,0 +1,332 @@
+/* ========================================================================== */
+/* File: tests/test_evt_bus_record.c                                          */
+/* ========================================================================== */
+#include <string.h>
+#include "unity.h"
+
+#include "evt_bus/evt_bus.h"
+#include "evt_bus/evt_bus_record.h"
+#include "test_helpers.h"
+
+/* ------------------------------ Memory sink/source ------------------------ */
+
+typedef struct {
+  uint8_t buf[512];
+  size_t  len;
+  size_t  pos;
+  bool    fail;
+  int     max_lock_depth;   /* bus lock depth seen by write() */
+} mem_stream_t;
+
+static mem_stream_t s_mem;
+
+static bool mem_write(void *ctx, const uint8_t *data, size_t len)
+{
+  mem_stream_t *m = (mem_stream_t*)ctx;
+  if (g_fake_backend.lock_depth > m->max_lock_depth) m->max_lock_depth = g_fake_backend.lock_depth;
+  if (m->fail || m->len + len > sizeof(m->buf)) return false;
+  memcpy(&m->buf[m->len], data, len);
+  m->len += len;
+  return true;
+}
+
+/* Deliberately short reads to exercise the decoder's reassembly */
+static size_t mem_read(void *ctx, uint8_t *data, size_t len)
+{
+  mem_stream_t *m = (mem_stream_t*)ctx;
+  size_t n = m->len - m->pos;
+  if (n > len) n = len;
+  if (n > 3)   n = 3;
+  memcpy(data, &m->buf[m->pos], n);
+  m->pos += n;
+  return n;
+}
+
+static const evt_rec_sink_t   s_sink = { .ctx = &s_mem, .write = mem_write };
+static const evt_rec_source_t s_src  = { .ctx = &s_mem, .read  = mem_read };
+
+static uint32_t s_sleeps[8];
+static int      s_sleep_calls;
+
+static void fake_sleep_us(void *ctx, uint32_t us)
+{
+  (void)ctx;
+  if (s_sleep_calls < 8) s_sleeps[s_sleep_calls] = us;
+  s_sleep_calls++;
+  g_fake_backend.now_us += us;
+}
+
+static evt_recorder_t s_rec;
+
+/* Stand-in for the dispatcher task */
+static void pump(void)
+{
+  evt_t out;
+  while (evt_bus_backend.dequeue_nb(NULL, &out)) {
+    evt_bus_dispatch_evt(&out);
+  }
+}
+
+/* ------------------------------ Unity hooks ------------------------------- */
+
+void setUp(void)
+{
+  test_reset_bus();
+  memset(&s_mem, 0, sizeof(s_mem));
+  s_sleep_calls = 0;
+}
+void tearDown(void) {}
+
+/* Record: id 1 at +100us (1 byte), id 2 at +300us (empty), id 300 at +20000us */
+static void record_sample_stream(void)
+{
+  g_fake_backend.now_us = 1000;
+  TEST_ASSERT_TRUE(evt_bus_rec_start(&s_rec, evt_bus_default(), &s_sink));
+
+  const uint8_t a = 0xAB;
+  g_fake_backend.now_us = 1100;
+  TEST_ASSERT_TRUE(evt_bus_publish(1, &a, 1));
+  pump();
+  g_fake_backend.now_us = 1400;
+  TEST_ASSERT_TRUE(evt_bus_publish(2, NULL, 0));
+  pump();
+  g_fake_backend.now_us = 21400;
+  const uint16_t w = 0x1234;
+  TEST_ASSERT_TRUE(evt_bus_publish(EVT_BUS_MAX_EVT_IDS - 1, &w, sizeof(w)));
+  pump();
+
+  evt_bus_rec_stop(&s_rec);
+}
+
+/* --------------------------------- Tests --------------------------------- */
+
+static void test_recorder_writes_compact_varint_records(void)
+{
+  record_sample_stream();
+
+  const uint8_t expect_head[] = {
+    'E', 'V', 'T', 'R', EVT_REC_VERSION,
+    100, 1, 1, 0xAB,             /* delta 100, id 1, len 1, payload */
+    0xAC, 0x02, 2, 0,            /* delta 300 (varint), id 2, len 0 */
+  };
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expect_head, s_mem.buf, sizeof(expect_head));
+  TEST_ASSERT_EQUAL_UINT32(3, s_rec.records);
+
+  /* Stopped: no further records */
+  size_t len = s_mem.len;
+  TEST_ASSERT_TRUE(evt_bus_publish(1, NULL, 0));
+  pump();
+  TEST_ASSERT_EQUAL_size_t(len, s_mem.len);
+}
+
+static void test_recorder_takes_isr_publishes_not_rejected_ones(void)
+{
+  TEST_ASSERT_TRUE(evt_bus_rec_start(&s_rec, evt_bus_default(), &s_sink));
+  size_t hdr = s_mem.len;
+
+  g_fake_backend.enqueue_ret = false;
+  TEST_ASSERT_FALSE(evt_bus_publish(1, NULL, 0));
+  pump();
+  TEST_ASSERT_EQUAL_size_t(hdr, s_mem.len);
+
+  /* Fake backend has no ISR path: borrow the task one */
+  g_fake_backend.enqueue_ret = true;
+  evt_bus_backend.enqueue_isr = evt_bus_backend.enqueue;
+  TEST_ASSERT_TRUE(evt_bus_publish_from_isr(1, NULL, 0));
+  evt_bus_backend.enqueue_isr = NULL;
+  pump();
+  TEST_ASSERT_EQUAL_UINT32(1, s_rec.records);
+  TEST_ASSERT_EQUAL_UINT32(0, s_rec.skipped);
+
+  /* The sink runs without the bus lock */
+  TEST_ASSERT_EQUAL_INT(0, s_mem.max_lock_depth);
+
+  /* Sink failures are counted, the bus goes on */
+  s_mem.fail = true;
+  TEST_ASSERT_TRUE(evt_bus_publish(1, NULL, 0));
+  pump();
+  TEST_ASSERT_EQUAL_UINT32(1, s_rec.skipped);
+
+  evt_bus_rec_stop(&s_rec);
+}
+
+#if EVT_BUS_ENVELOPE_META
+static void test_recorder_follows_queue_order(void)
+{
+  g_fake_backend.q_depth = 4;
+  g_fake_backend.now_us = 1000;
+  TEST_ASSERT_TRUE(evt_bus_rec_start(&s_rec, evt_bus_default(), &s_sink));
+
+  /* Stamped at publish: a producer preempted between stamp and enqueue queues an
+   * older stamp behind a newer one */
+  g_fake_backend.now_us = 1500;
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_ex(1, NULL, 0));
+  g_fake_backend.now_us = 1200;
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_ex(2, NULL, 0));
+  g_fake_backend.now_us = 1600;
+  TEST_ASSERT_EQUAL(EVT_PUB_OK, evt_bus_publish_ex(3, NULL, 0));
+  g_fake_backend.now_us = 9000;   /* dispatched much later: pacing keeps the stamps */
+  pump();
+  evt_bus_rec_stop(&s_rec);
+
+  const uint32_t ids[3]    = { 1, 2, 3 };
+  const uint32_t deltas[3] = { 500, 0, 100 };
+  evt_rec_entry_t e;
+  TEST_ASSERT_TRUE(evt_bus_rec_read_header(&s_src));
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(EVT_REC_OK, evt_bus_rec_read_next(&s_src, &e));
+    TEST_ASSERT_EQUAL_UINT32(ids[i], e.evt.id);
+    TEST_ASSERT_EQUAL_UINT32(deltas[i], e.delta_us);
+  }
+  TEST_ASSERT_EQUAL(EVT_REC_END, evt_bus_rec_read_next(&s_src, &e));
+}
+#endif
+
+static void cb_stop_recorder(const evt_t *evt, void *ctx)
+{
+  (void)evt;
+  evt_bus_rec_stop((evt_recorder_t *)ctx);
+}
+
+static void test_recorder_stops_and_restarts_while_dispatching(void)
+{
+  g_fake_backend.q_depth = 4;
+  evt_bus_subscribe(5, cb_stop_recorder, &s_rec);
+  TEST_ASSERT_TRUE(evt_bus_rec_start(&s_rec, evt_bus_default(), &s_sink));
+
+  /* Stopped from a subscriber: the tap already ran for this event, not for the next */
+  TEST_ASSERT_TRUE(evt_bus_publish(5, NULL, 0));
+  TEST_ASSERT_TRUE(evt_bus_publish(1, NULL, 0));
+  pump();
+  TEST_ASSERT_EQUAL_UINT32(1, s_rec.records);
+
+  /* Restarting the installed recorder detaches it before resetting it */
+  TEST_ASSERT_TRUE(evt_bus_rec_start(&s_rec, evt_bus_default(), &s_sink));
+  TEST_ASSERT_TRUE(evt_bus_rec_start(&s_rec, evt_bus_default(), &s_sink));
+  TEST_ASSERT_TRUE(evt_bus_publish(1, NULL, 0));
+  pump();
+  TEST_ASSERT_EQUAL_UINT32(1, s_rec.records);
+  evt_bus_rec_stop(&s_rec);
+}
+
+static void test_reader_roundtrip(void)
+{
+  record_sample_stream();
+
+  TEST_ASSERT_TRUE(evt_bus_rec_read_header(&s_src));
+
+  evt_rec_entry_t e;
+  TEST_ASSERT_EQUAL(EVT_REC_OK, evt_bus_rec_read_next(&s_src, &e));
+  TEST_ASSERT_EQUAL_UINT32(100, e.delta_us);
+  TEST_ASSERT_EQUAL_UINT16(1, e.evt.id);
+  TEST_ASSERT_EQUAL_UINT16(1, e.evt.len);
+  TEST_ASSERT_EQUAL_UINT8(0xAB, e.evt.payload[0]);
+
+  TEST_ASSERT_EQUAL(EVT_REC_OK, evt_bus_rec_read_next(&s_src, &e));
+  TEST_ASSERT_EQUAL_UINT32(300, e.delta_us);
+  TEST_ASSERT_EQUAL_UINT16(0, e.evt.len);
+
+  TEST_ASSERT_EQUAL(EVT_REC_OK, evt_bus_rec_read_next(&s_src, &e));
+  TEST_ASSERT_EQUAL_UINT32(20000, e.delta_us);
+  TEST_ASSERT_EQUAL_UINT16(EVT_BUS_MAX_EVT_IDS - 1, e.evt.id);
+  TEST_ASSERT_EQUAL_UINT16(2, e.evt.len);
+
+  TEST_ASSERT_EQUAL(EVT_REC_END, evt_bus_rec_read_next(&s_src, &e));
+}
+
+static void test_reader_rejects_bad_streams(void)
+{
+  record_sample_stream();
+
+  /* Truncated inside the last payload */
+  s_mem.len -= 1;
+  TEST_ASSERT_TRUE(evt_bus_rec_read_header(&s_src));
+  evt_rec_entry_t e;
+  TEST_ASSERT_EQUAL(EVT_REC_OK, evt_bus_rec_read_next(&s_src, &e));
+  TEST_ASSERT_EQUAL(EVT_REC_OK, evt_bus_rec_read_next(&s_src, &e));
+  TEST_ASSERT_EQUAL(EVT_REC_ERR_FORMAT, evt_bus_rec_read_next(&s_src, &e));
+
+  /* Wrong magic */
+  s_mem.pos = 0;
+  s_mem.buf[0] = 'X';
+  TEST_ASSERT_FALSE(evt_bus_rec_read_header(&s_src));
+
+  /* Oversized payload length */
+  const uint8_t big[] = { 'E', 'V', 'T', 'R', EVT_REC_VERSION, 0, 1, EVT_INLINE_MAX + 1 };
+  memcpy(s_mem.buf, big, sizeof(big));
+  s_mem.len = sizeof(big);
+  s_mem.pos = 0;
+  TEST_ASSERT_TRUE(evt_bus_rec_read_header(&s_src));
+  TEST_ASSERT_EQUAL(EVT_REC_ERR_FORMAT, evt_bus_rec_read_next(&s_src, &e));
+}
+
+static void test_replay_fast_republishes_everything(void)
+{
+  record_sample_stream();
+  test_reset_bus();
+  g_fake_backend.q_depth = FAKE_QUEUE_MAX;
+
+  const evt_replay_cfg_t cfg = { .mode = EVT_REPLAY_FAST };
+  evt_replay_stats_t st;
+  TEST_ASSERT_TRUE(evt_bus_replay(evt_bus_default(), &s_src, &cfg, &st));
+
+  TEST_ASSERT_EQUAL_UINT32(3, st.published);
+  TEST_ASSERT_EQUAL_UINT32(0, st.rejected);
+  TEST_ASSERT_EQUAL(EVT_REC_END, st.status);
+  TEST_ASSERT_EQUAL_size_t(3, g_fake_backend.q_count);
+  TEST_ASSERT_EQUAL_INT(0, s_sleep_calls);
+  TEST_ASSERT_EQUAL_UINT8(0xAB, g_fake_backend.q[0].payload[0]);
+}
+
+static void test_replay_paced_follows_recorded_offsets(void)
+{
+  record_sample_stream();
+  test_reset_bus();
+
+  const evt_replay_cfg_t cfg = { .mode = EVT_REPLAY_PACED, .sleep_us = fake_sleep_us };
+  evt_replay_stats_t st;
+  TEST_ASSERT_TRUE(evt_bus_replay(evt_bus_default(), &s_src, &cfg, &st));
+
+  /* First record plays immediately, then the recorded gaps */
+  TEST_ASSERT_EQUAL_INT(2, s_sleep_calls);
+  TEST_ASSERT_EQUAL_UINT32(300, s_sleeps[0]);
+  TEST_ASSERT_EQUAL_UINT32(20000, s_sleeps[1]);
+  TEST_ASSERT_EQUAL_UINT32(3, st.published);
+
+  /* Paced replay needs a sleep hook */
+  const evt_replay_cfg_t bad = { .mode = EVT_REPLAY_PACED };
+  TEST_ASSERT_FALSE(evt_bus_replay(evt_bus_default(), &s_src, &bad, NULL));
+}
+
+static void test_replay_counts_rejections(void)
+{
+  record_sample_stream();
+  test_reset_bus();
+  g_fake_backend.q_depth = 2;
+
+  const evt_replay_cfg_t cfg = { .mode = EVT_REPLAY_FAST };
+  evt_replay_stats_t st;
+  TEST_ASSERT_TRUE(evt_bus_replay(evt_bus_default(), &s_src, &cfg, &st));
+  TEST_ASSERT_EQUAL_UINT32(2, st.published);
+  TEST_ASSERT_EQUAL_UINT32(1, st.rejected);
+}
+
+/* --------------------------------- Runner --------------------------------- */
+int main(void)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_recorder_writes_compact_varint_records);
+  RUN_TEST(test_recorder_takes_isr_publishes_not_rejected_ones);
+#if EVT_BUS_ENVELOPE_META
+  RUN_TEST(test_recorder_follows_queue_order);
+#endif
+  RUN_TEST(test_recorder_stops_and_restarts_while_dispatching);
+  RUN_TEST(test_reader_roundtrip);
+  RUN_TEST(test_reader_rejects_bad_streams);
+  RUN_TEST(test_replay_fast_republishes_everything);
+  RUN_TEST(test_replay_paced_follows_recorded_offsets);
+  RUN_TEST(test_replay_counts_rejections);
+
+  return UNITY_END();
+}
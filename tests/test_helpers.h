@@ -11,6 +11,13 @@
 #include "evt_bus/evt_bus.h"            /* evt_bus_init/subscribe/publish/dispatch */
 #include "evt_bus/evt_bus_config.h"     /* EVT_* limits if needed */
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAKE_QUEUE_MAX 8u
+#define FAKE_FANOUT_MAX 4u
+
 /* Fake backend state exposed to tests */
 typedef struct {
   evt_t   last_evt;
@@ -22,9 +29,39 @@ typedef struct {
   int     enqueue_calls;
 
   bool    enqueue_ret;   /* allow forcing enqueue failure */
+
+  /* Optional bounded FIFO model (q_depth == 0 => unbounded, last_evt only) */
+  size_t  q_depth;
+  size_t  q_head;
+  size_t  q_count;
+  evt_t   q[FAKE_QUEUE_MAX];
+
+  int      drop_oldest_calls;
+  int      enqueue_timeout_calls;
+  uint32_t last_timeout_ms;
+
+  uint32_t now_us;       /* fake clock, advanced by tests */
+
+  /* Waiter hooks: sleeping runs on_sleep (stands in for the dispatcher), then consumes a wake */
+  int      waiter_wakes;
+  int      waiter_sleeps;
+  uint32_t last_sleep_ms;
+  void   (*on_sleep)(void);
+
+  /* Fan-out hooks: started jobs run at join */
+  bool             fanout_refuse;
+  int              fanout_starts;
+  int              fanout_joins;
+  size_t           fanout_pending;
+  evt_fanout_job_t fanout_jobs[FAKE_FANOUT_MAX];
 } fake_backend_state_t;
 
 extern fake_backend_state_t g_fake_backend;
+extern evt_bus_backend_t evt_bus_backend;
+
+#ifdef __cplusplus
+}
+#endif
 
 /* Reset both bus + backend state */
 static inline void test_reset_bus(void)
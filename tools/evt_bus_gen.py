@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""Generate evt_bus event definitions from a JSON schema.
+
+Schema:
+    {
+      "name": "app",
+      "events": [
+        { "name": "link_up" },
+        { "name": "temp_sample",
+          "fields": [ { "name": "centi_c", "type": "int16_t" },
+                      { "name": "raw",     "type": "uint8_t", "count": 4 } ],
+          "policy": "drop_oldest",        # drop_new (default) | drop_oldest | block
+          "timeout_ms": 0,                # block only
+          "critical": false,              # may use the reserved queue slots
+          "retained": true }              # evt_bus_set_retained() on apply
+      ]
+    }
+
+Outputs (in --out-dir, <name> = schema name):
+    <name>_evt_config.h  EVT_BUS_MAX_EVT_IDS / EVT_INLINE_MAX / EVT_BUS_MAX_RETAINED sized
+                         for the schema; include it through EVT_BUS_USER_CONFIG
+    <name>_events.h      ID enum, packed payload structs with size checks against
+                         EVT_INLINE_MAX, typed publish helpers, metadata table
+    <name>_events.c      const metadata table and <name>_events_apply()
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+C_TYPES = {
+    "bool": 1, "char": 1,
+    "int8_t": 1, "uint8_t": 1,
+    "int16_t": 2, "uint16_t": 2,
+    "int32_t": 4, "uint32_t": 4, "float": 4,
+    "int64_t": 8, "uint64_t": 8, "double": 8,
+}
+
+POLICIES = {
+    "drop_new": "EVT_BP_DROP_NEW",
+    "drop_oldest": "EVT_BP_DROP_OLDEST",
+    "block": "EVT_BP_BLOCK",
+}
+
+EVENT_KEYS = {"name", "fields", "policy", "timeout_ms", "critical", "retained", "doc"}
+FIELD_KEYS = {"name", "type", "count", "doc"}
+IDENT = re.compile(r"^[a-z][a-z0-9_]*$")
+
+
+class SchemaError(Exception):
+    pass
+
+
+def check_ident(what, name):
+    if not isinstance(name, str) or not IDENT.match(name):
+        raise SchemaError(f"{what}: '{name}' is not a lower_snake_case identifier")
+
+
+def load_schema(path):
+    with open(path, encoding="utf-8") as f:
+        schema = json.load(f)
+
+    check_ident("schema name", schema.get("name"))
+    events = schema.get("events")
+    if not isinstance(events, list) or not events:
+        raise SchemaError("'events' must be a non-empty list")
+
+    seen = set()
+    for evt in events:
+        check_ident("event", evt.get("name"))
+        if evt["name"] in seen:
+            raise SchemaError(f"event '{evt['name']}' defined twice")
+        seen.add(evt["name"])
+
+        unknown = set(evt) - EVENT_KEYS
+        if unknown:
+            raise SchemaError(f"event '{evt['name']}': unknown keys {sorted(unknown)}")
+        if evt.get("policy", "drop_new") not in POLICIES:
+            raise SchemaError(f"event '{evt['name']}': policy must be one of {sorted(POLICIES)}")
+
+        size = 0
+        field_names = set()
+        for fld in evt.get("fields", []):
+            check_ident(f"event '{evt['name']}' field", fld.get("name"))
+            if fld["name"] in field_names:
+                raise SchemaError(f"event '{evt['name']}': field '{fld['name']}' defined twice")
+            field_names.add(fld["name"])
+            unknown = set(fld) - FIELD_KEYS
+            if unknown:
+                raise SchemaError(f"event '{evt['name']}' field '{fld['name']}': unknown keys {sorted(unknown)}")
+            if fld.get("type") not in C_TYPES:
+                raise SchemaError(f"event '{evt['name']}' field '{fld['name']}': type must be one of {sorted(C_TYPES)}")
+            count = fld.get("count", 1)
+            if not isinstance(count, int) or count < 1:
+                raise SchemaError(f"event '{evt['name']}' field '{fld['name']}': count must be >= 1")
+            size += C_TYPES[fld["type"]] * count
+        evt["_size"] = size
+
+    return schema
+
+
+def emit_config(schema):
+    name = schema["name"]
+    events = schema["events"]
+    guard = f"{name.upper()}_EVT_CONFIG_H"
+    inline_max = max(1, max(e["_size"] for e in events))
+    retained = sum(1 for e in events if e.get("retained"))
+
+    out = [
+        f"/* Generated by tools/evt_bus_gen.py from the '{name}' schema. Do not edit. */",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "/* Sized for the schema; a -D on the command line still wins */",
+        "#ifndef EVT_BUS_MAX_EVT_IDS",
+        f"#define EVT_BUS_MAX_EVT_IDS {len(events)}u",
+        "#endif",
+        "",
+        "#ifndef EVT_INLINE_MAX",
+        f"#define EVT_INLINE_MAX {inline_max}u",
+        "#endif",
+    ]
+    if retained:
+        out += [
+            "",
+            "#ifndef EVT_BUS_MAX_RETAINED",
+            f"#define EVT_BUS_MAX_RETAINED {retained}u",
+            "#endif",
+        ]
+    out += ["", f"#endif /* {guard} */", ""]
+    return "\n".join(out)
+
+
+def emit_header(schema):
+    name = schema["name"]
+    up = name.upper()
+    events = schema["events"]
+    guard = f"{up}_EVENTS_H"
+
+    out = [
+        f"/* Generated by tools/evt_bus_gen.py from the '{name}' schema. Do not edit. */",
+        f"#ifndef {guard}",
+        f"#define {guard}",
+        "",
+        "#include <stdbool.h>",
+        "#include <stdint.h>",
+        "",
+        '#include "evt_bus/evt_bus.h"',
+        "",
+        "#ifdef __cplusplus",
+        'extern "C" {',
+        "#endif",
+        "",
+        "/* Event IDs */",
+        "enum {",
+    ]
+    for i, e in enumerate(events):
+        out.append(f"  {up}_EVT_{e['name'].upper()} = {i},")
+    out += [
+        f"  {up}_EVT_COUNT = {len(events)}",
+        "};",
+        "",
+        f"EVT_BUS_STATIC_ASSERT({up}_EVT_COUNT <= EVT_BUS_MAX_EVT_IDS,",
+        f'                      "{name}: EVT_BUS_MAX_EVT_IDS too small for the schema");',
+        "",
+        "/* Payloads: packed, copied byte-wise into evt_t.payload */",
+        "#pragma pack(push, 1)",
+    ]
+    for e in events:
+        if not e.get("fields"):
+            continue
+        if e.get("doc"):
+            out.append(f"/* {e['doc']} */")
+        out.append("typedef struct {")
+        for fld in e["fields"]:
+            arr = f"[{fld['count']}]" if fld.get("count", 1) > 1 else ""
+            doc = f"  /* {fld['doc']} */" if fld.get("doc") else ""
+            out.append(f"  {fld['type']} {fld['name']}{arr};{doc}")
+        out.append(f"}} {name}_{e['name']}_t;")
+        out.append("")
+    out += ["#pragma pack(pop)", ""]
+
+    for e in events:
+        ev = f"{up}_EVT_{e['name'].upper()}"
+        if e.get("fields"):
+            t = f"{name}_{e['name']}_t"
+            out += [
+                f"#define {ev}_LEN sizeof({t})",
+                f"EVT_BUS_STATIC_ASSERT(sizeof({t}) == {e['_size']}u, \"{t}: unexpected padding\");",
+                f"EVT_BUS_STATIC_ASSERT(sizeof({t}) <= EVT_INLINE_MAX, \"{t} exceeds EVT_INLINE_MAX\");",
+            ]
+        else:
+            out.append(f"#define {ev}_LEN 0u")
+    out.append("")
+
+    out += [
+        "/* Per-event metadata, applied to a bus by " + f"{name}_events_apply() */",
+        "typedef struct {",
+        "  evt_policy_t policy;",
+        "  bool         retained;",
+        "  uint16_t     len;        /* exact payload length */",
+        f"}} {name}_evt_meta_t;",
+        "",
+        f"extern const {name}_evt_meta_t {name}_evt_meta[{up}_EVT_COUNT];",
+        "",
+        "/**",
+        " * @brief Load the schema policies and retained IDs into @p bus.",
+        " *",
+        " * @return false if a setting was refused (e.g. EVT_BUS_MAX_RETAINED too small).",
+        " */",
+        f"bool {name}_events_apply(evt_bus_t *bus);",
+        "",
+        "/* Typed publish helpers (task context) */",
+    ]
+    for e in events:
+        ev = f"{up}_EVT_{e['name'].upper()}"
+        fn = f"{name}_publish_{e['name']}"
+        if e.get("fields"):
+            t = f"{name}_{e['name']}_t"
+            out += [
+                f"static inline evt_pub_result_t {fn}(evt_bus_t *bus, const {t} *p)",
+                "{",
+                f"  return evt_bus_inst_publish_ex(bus, {ev}, p, sizeof(*p));",
+                "}",
+            ]
+        else:
+            out += [
+                f"static inline evt_pub_result_t {fn}(evt_bus_t *bus)",
+                "{",
+                f"  return evt_bus_inst_publish_ex(bus, {ev}, NULL, 0);",
+                "}",
+            ]
+    out += [
+        "",
+        "#ifdef __cplusplus",
+        "}",
+        "#endif",
+        "",
+        f"#endif /* {guard} */",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def emit_source(schema):
+    name = schema["name"]
+    up = name.upper()
+    events = schema["events"]
+
+    out = [
+        f"/* Generated by tools/evt_bus_gen.py from the '{name}' schema. Do not edit. */",
+        f'#include "{name}_events.h"',
+        "",
+        f"const {name}_evt_meta_t {name}_evt_meta[{up}_EVT_COUNT] = {{",
+    ]
+    for e in events:
+        ev = f"{up}_EVT_{e['name'].upper()}"
+        crit = "true" if e.get("critical") else "false"
+        ret = "true" if e.get("retained") else "false"
+        out.append(
+            f"  [{ev}] = {{ .policy = {{ .mode = {POLICIES[e.get('policy', 'drop_new')]}, "
+            f".critical = {crit}, .timeout_ms = {int(e.get('timeout_ms', 0))}u }}, "
+            f".retained = {ret}, .len = {ev}_LEN }},"
+        )
+    out += [
+        "};",
+        "",
+        f"bool {name}_events_apply(evt_bus_t *bus)",
+        "{",
+        "  bool ok = true;",
+        f"  for (evt_id_t id = 0; id < {up}_EVT_COUNT; id++) {{",
+        f"    const {name}_evt_meta_t *m = &{name}_evt_meta[id];",
+        "    ok = evt_bus_inst_set_policy(bus, id, &m->policy) && ok;",
+        "    if (m->retained) {",
+        "      ok = evt_bus_inst_set_retained(bus, id) && ok;",
+        "    }",
+        "  }",
+        "  return ok;",
+        "}",
+        "",
+    ]
+    return "\n".join(out)
+
+
+def write(path, text):
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+
+
+def main(argv=None):
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--schema", required=True, help="JSON event schema")
+    ap.add_argument("--out-dir", required=True, help="directory for the generated files")
+    ap.add_argument("--name", help="expected schema name (build systems key outputs on it)")
+    args = ap.parse_args(argv)
+
+    try:
+        schema = load_schema(args.schema)
+        if args.name is not None and args.name != schema["name"]:
+            raise SchemaError(f"schema name is '{schema['name']}', expected '{args.name}'")
+    except (OSError, ValueError, SchemaError) as e:
+        print(f"evt_bus_gen: {args.schema}: {e}", file=sys.stderr)
+        return 1
+
+    name = schema["name"]
+    os.makedirs(args.out_dir, exist_ok=True)
+    write(os.path.join(args.out_dir, f"{name}_evt_config.h"), emit_config(schema))
+    write(os.path.join(args.out_dir, f"{name}_events.h"), emit_header(schema))
+    write(os.path.join(args.out_dir, f"{name}_events.c"), emit_source(schema))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())